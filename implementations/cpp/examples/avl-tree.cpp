@@ -18,37 +18,53 @@ int main() {
         std::cout << "2. AVL tree isn't empty after inserting some items.\n";
     }
 
-    /*
-    if (bst.findMin() == 1) {
-        std::cout << "3. Found the smallest value in the BST.\n";
+    if (avl.findMin() == 1) {
+        std::cout << "3. Found the smallest value in the AVL tree.\n";
     }
 
-    if (bst.findMax() == 8) {
-        std::cout << "4. Found the largest value in the BST.\n";
+    if (avl.findMax() == 8) {
+        std::cout << "4. Found the largest value in the AVL tree.\n";
     }
 
-    if (bst.contains(4)) {
-        std::cout << "5. BST contains item that was added.\n";
+    if (avl.contains(4)) {
+        std::cout << "5. AVL tree contains item that was added.\n";
     }
 
-    if (!bst.contains(10)) {
-        std::cout << "6. BST doesn't contain item that was never added.\n";
+    if (!avl.contains(10)) {
+        std::cout << "6. AVL tree doesn't contain item that was never added.\n";
     }
 
-    bst.remove(4);
-    if (!bst.contains(4)) {
-        std::cout << "7. BST doesn't contain item that was removed added.\n";
+    avl.remove(4);
+    if (!avl.contains(4)) {
+        std::cout << "7. AVL tree doesn't contain item that was removed added.\n";
     }
 
     for (auto item : items) {
-        if (bst.contains(item))
-            bst.remove(item);
+        if (avl.contains(item))
+            avl.remove(item);
     }
 
-    if (bst.isEmpty()) {
-        std::cout << "8. BST is empty after removing all its items.\n";
+    if (avl.isEmpty()) {
+        std::cout << "8. AVL tree is empty after removing all its items.\n";
+    }
+
+    AVLTree<int, true> ranked{};
+    for (int i = 1; i <= 100; ++i) {
+        ranked.insert(i * 10);
+    }
+    ranked.remove(500);
+
+    if (ranked.size() == 99 && ranked.select(0) == 10 && ranked.select(49) == 510) {
+        std::cout << "9. select finds the k-th smallest item.\n";
+    }
+
+    if (ranked.rank(10) == 0 && ranked.rank(505) == 49 && ranked.rank(2000) == 99) {
+        std::cout << "10. rank counts the items below a value.\n";
+    }
+
+    if (ranked.countRange(100, 600) == 50 && ranked.countRange(600, 100) == 0) {
+        std::cout << "11. countRange counts the items in a closed range.\n";
     }
-    */
 
     return 0;
 }
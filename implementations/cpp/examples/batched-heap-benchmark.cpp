@@ -0,0 +1,147 @@
+#include "../lib/BinaryHeap.h"
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <iterator>
+#include <algorithm>
+
+/*
+Batched ingestion into a BinaryHeap of tasks: a heap of n tasks receives
+batches of b tasks, then the b most urgent are taken out again.
+  single:  insert one at a time, deleteMin one at a time
+  batched: insertMany and popK
+Also builds a heap from a vector by copy, from move iterators and from an
+rvalue vector, counting the copies of the tasks.
+*/
+
+struct Task {
+    static long long copies;
+
+    int priority = 0;
+    std::string name;
+
+    Task() = default;
+    Task( int p, std::string n ) : priority{ p }, name{ std::move(n) } {}
+    Task( const Task& rhs ) : priority{ rhs.priority }, name{ rhs.name } { ++copies; }
+    Task( Task&& rhs ) = default;
+    Task& operator=( const Task& rhs ) {
+        priority = rhs.priority;
+        name = rhs.name;
+        ++copies;
+        return *this;
+    }
+    Task& operator=( Task&& rhs ) = default;
+
+    bool operator<( const Task& rhs ) const { return priority < rhs.priority; }
+};
+
+long long Task::copies = 0;
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+std::vector<Task> makeTasks( std::mt19937& gen, int n ) {
+    std::vector<Task> tasks;
+    tasks.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        tasks.emplace_back(static_cast<int>(gen() % 1000000), "task-with-a-long-name-" + std::to_string(i));
+    }
+    return tasks;
+}
+
+bool isSorted( const std::vector<Task>& tasks ) {
+    return std::is_sorted(tasks.begin(), tasks.end());
+}
+
+int main( int argc, char* argv[] ) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    std::mt19937 gen{ 37 };
+    std::vector<Task> initial = makeTasks(gen, n);
+
+    // 1.-3. building a heap from n tasks
+    long long before = Task::copies;
+    BinaryHeap<Task> copied{ initial };
+    std::cout << "1. from const vector&: " << Task::copies - before << " copies\n";
+
+    std::vector<Task> scratch = initial;
+    before = Task::copies;
+    BinaryHeap<Task> moved{ std::make_move_iterator(scratch.begin()), std::make_move_iterator(scratch.end()) };
+    std::cout << "2. from move iterators: " << Task::copies - before << " copies\n";
+
+    scratch = initial;
+    before = Task::copies;
+    BinaryHeap<Task> stolen{ std::move(scratch) };
+    std::cout << "3. from vector&&: " << Task::copies - before << " copies\n";
+
+    std::vector<Task> a, b, c;
+    copied.popK(n, std::back_inserter(a));
+    moved.popK(n, std::back_inserter(b));
+    stolen.popK(n, std::back_inserter(c));
+    if (!isSorted(a) || a.size() != static_cast<size_t>(n) || !stolen.isEmpty()) {
+        std::cout << "Oops! A heap built from a vector is misordered.\n";
+    }
+    for (int i = 0; i < n; ++i) {
+        if (a[i].priority != b[i].priority || a[i].priority != c[i].priority) {
+            std::cout << "Oops! The constructors disagree.\n";
+            break;
+        }
+    }
+
+    // 4. insert(const&) copies each task exactly once
+    BinaryHeap<Task> one{};
+    before = Task::copies;
+    for (const Task& t : initial) one.insert(t);
+    std::cout << "4. insert(const&) of " << n << " tasks: " << Task::copies - before << " copies\n";
+
+    // 5. batches of growing size against a heap of n tasks
+    std::cout << "5. batch\tinsert ms\tinsertMany ms\tdeleteMin ms\tpopK ms\n";
+    for (int batch = n / 1000; batch <= 4 * n; batch *= 4) {
+        std::vector<std::vector<Task>> batches;
+        for (int r = 0; r < rounds; ++r) batches.push_back(makeTasks(gen, batch));
+
+        BinaryHeap<Task> single{ initial };
+        BinaryHeap<Task> batched{ initial };
+        std::vector<Task> outSingle, outBatched;
+
+        double tInsert = 0, tInsertMany = 0, tDeleteMin = 0, tPopK = 0;
+        for (const auto& tasks : batches) {
+            tInsert += millis([&]() {
+                for (const Task& t : tasks) single.insert(t);
+            });
+            tInsertMany += millis([&]() {
+                batched.insertMany(tasks.begin(), tasks.end());
+            });
+            tDeleteMin += millis([&]() {
+                Task x;
+                for (int i = 0; i < batch; ++i) {
+                    single.deleteMin(x);
+                    outSingle.push_back(std::move(x));
+                }
+            });
+            tPopK += millis([&]() {
+                batched.popK(batch, std::back_inserter(outBatched));
+            });
+        }
+
+        std::cout << "   " << batch << "\t" << tInsert << "\t\t" << tInsertMany << "\t\t"
+                  << tDeleteMin << "\t\t" << tPopK << "\n";
+
+        bool same = outSingle.size() == outBatched.size() && batched.size() == single.size();
+        for (size_t i = 0; same && i < outSingle.size(); ++i) {
+            same = outSingle[i].priority == outBatched[i].priority;
+        }
+        if (!same) std::cout << "Oops! insertMany/popK disagree with insert/deleteMin.\n";
+    }
+
+    return 0;
+}
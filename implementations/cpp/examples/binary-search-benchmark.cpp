@@ -0,0 +1,93 @@
+#include "../lib/BinarySearch.h"
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+/*
+Time membership checks against sorted ints with each search variant, after
+checking every variant against std::lower_bound.
+*/
+
+template<typename Function>
+double nsPerQuery( size_t numQueries, Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / numQueries;
+}
+
+int main() {
+    std::mt19937 gen{ 335 };
+
+    // correctness, including duplicates and empty ranges
+    bool ok = true;
+    for (int n = 0; n < 200 && ok; ++n) {
+        std::vector<int> A(n);
+        for (auto& a : A) a = gen() % 64;
+        std::sort(A.begin(), A.end());
+
+        std::vector<int> needles;
+        for (int x = -1; x <= 65; ++x) needles.push_back(x);
+        std::vector<std::ptrdiff_t> batched;
+        batchLowerBound(A.begin(), A.end(), needles.begin(), needles.end(), std::back_inserter(batched));
+
+        for (int x : needles) {
+            auto expected = std::lower_bound(A.begin(), A.end(), x) - A.begin();
+            auto range = equalRange(A.begin(), A.end(), x);
+            ok = ok && lowerBound(A.begin(), A.end(), x) - A.begin() == expected
+                    && branchlessLowerBound(A.begin(), A.end(), x) - A.begin() == expected
+                    && simdLowerBound(A, x) == expected
+                    && batched[x + 1] == expected
+                    && range.first - A.begin() == expected
+                    && range.second == std::upper_bound(A.begin(), A.end(), x)
+                    && (binarySearch(A, x) == -1) == (range.first == range.second);
+        }
+    }
+
+    std::vector<std::string> words = {"apple", "banana", "cherry", "date"};
+    ok = ok && binarySearch(words, std::string("cherry")) == 2
+            && lowerBound(words.begin(), words.end(), std::string("c"))->front() == 'c';
+
+    std::cout << (ok ? "All variants agree with std::lower_bound.\n" : "Oops! Variants disagree.\n");
+
+    const size_t numQueries = 1 << 20;
+    std::cout << "n\tclassic\tlowerBound\tbranchless\tsimd\tbatched   (ns/query)\n";
+
+    for (int lg = 10; lg <= 24; lg += 2) {
+        size_t n = size_t{ 1 } << lg;
+        std::vector<int> A(n);
+        for (size_t i = 0; i < n; ++i) A[i] = 2 * static_cast<int>(i);
+
+        std::uniform_int_distribution<int> dist(0, 2 * static_cast<int>(n));
+        std::vector<int> queries(numQueries);
+        for (auto& q : queries) q = dist(gen);
+
+        long long sink = 0;
+        std::vector<std::ptrdiff_t> positions(numQueries);
+
+        double tc = nsPerQuery(numQueries, [&]() {
+            for (int q : queries) sink += binarySearch(A, q);
+        });
+        double tl = nsPerQuery(numQueries, [&]() {
+            for (int q : queries) sink += lowerBound(A.begin(), A.end(), q) - A.begin();
+        });
+        double tb = nsPerQuery(numQueries, [&]() {
+            for (int q : queries) sink += branchlessLowerBound(A.begin(), A.end(), q) - A.begin();
+        });
+        double ts = nsPerQuery(numQueries, [&]() {
+            for (int q : queries) sink += simdLowerBound(A, q);
+        });
+        double tm = nsPerQuery(numQueries, [&]() {
+            batchLowerBound(A.begin(), A.end(), queries.begin(), queries.end(), positions.begin());
+        });
+
+        std::cout << n << "\t" << tc << "\t" << tl << "\t" << tb << "\t" << ts << "\t" << tm
+                  << (sink == 42 ? " " : "") << "\n";
+    }
+
+    return 0;
+}
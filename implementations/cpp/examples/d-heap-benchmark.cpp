@@ -0,0 +1,114 @@
+#include "../lib/BinaryHeap.h"
+#include "../lib/DHeap.h"
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <random>
+#include <chrono>
+
+/*
+Sweep the heap arity over three workloads:
+  insert-heavy:    insert N random ints, then delete them all
+  deleteMin-heavy: keep N ints in the heap and repeatedly replace the
+                   minimum with a larger random key (a hold model)
+  strings:         the insert/deleteMin pattern of examples/binary-heap.cpp
+Compile with -O2 -march=native to enable the SIMD child selection.
+*/
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+template<typename Heap>
+bool insertHeavy( const std::vector<int>& keys ) {
+    Heap h{};
+    for (int k : keys) h.insert(k);
+
+    int previous = -1, x;
+    bool ok = true;
+    while (!h.isEmpty()) {
+        h.deleteMin(x);
+        ok = ok && previous <= x;
+        previous = x;
+    }
+    return ok;
+}
+
+template<typename Heap>
+long long deleteMinHeavy( const std::vector<int>& keys, int rounds ) {
+    Heap h{};
+    for (int k : keys) h.insert(k);
+
+    std::mt19937 gen{ 13 };
+    long long sum = 0;
+    int x;
+    for (int r = 0; r < rounds; ++r) {
+        h.deleteMin(x);
+        sum += x;
+        h.insert(x + static_cast<int>(gen() % 1000000));
+    }
+    return sum;
+}
+
+template<typename Heap>
+bool strings() {
+    const int minItem = 10000;
+    const int maxItem = 99999;
+    Heap h{};
+    std::string x;
+
+    for (int i = 37; i != 0; i = (i + 37) % maxItem) {
+        if (i >= minItem) {
+            std::ostringstream sout;
+            sout << "hello" << i;
+            h.insert(sout.str());
+        }
+    }
+
+    bool ok = true;
+    for (int i = minItem; i < maxItem; ++i) {
+        std::ostringstream sout;
+        sout << "hello" << i;
+        h.deleteMin(x);
+        ok = ok && x == sout.str();
+    }
+    return ok;
+}
+
+template<typename IntHeap, typename StringHeap>
+void run( const std::string& name, const std::vector<int>& keys, long long& expected ) {
+    bool ok = true;
+    long long sum = 0;
+    double ti = millis([&]() { ok = insertHeavy<IntHeap>(keys) && ok; });
+    double td = millis([&]() { sum = deleteMinHeavy<IntHeap>(keys, 4 * keys.size()); });
+    double ts = millis([&]() { ok = strings<StringHeap>() && ok; });
+
+    if (expected == -1) expected = sum;
+    ok = ok && sum == expected;
+
+    std::cout << name << "\t" << ti << "\t" << td << "\t" << ts << (ok ? "" : "\tOops!") << "\n";
+}
+
+int main( int argc, char* argv[] ) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    std::mt19937 gen{ 335 };
+    std::vector<int> keys(n);
+    for (auto& k : keys) k = static_cast<int>(gen() % 1000000000);
+
+    long long expected = -1;
+    std::cout << "heap\t\tinsert-heavy\tdeleteMin-heavy\tstrings   (ms, n = " << n << ")\n";
+    run<BinaryHeap<int>, BinaryHeap<std::string>>("BinaryHeap", keys, expected);
+    run<DHeap<int, 2>, DHeap<std::string, 2>>("DHeap<2>", keys, expected);
+    run<DHeap<int, 4>, DHeap<std::string, 4>>("DHeap<4>", keys, expected);
+    run<DHeap<int, 8>, DHeap<std::string, 8>>("DHeap<8>", keys, expected);
+    run<DHeap<int, 16>, DHeap<std::string, 16>>("DHeap<16>", keys, expected);
+
+    return 0;
+}
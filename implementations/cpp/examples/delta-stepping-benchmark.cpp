@@ -0,0 +1,115 @@
+#include "../lib/DeltaStepping.h"
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+/*
+deltaStepping against dijkstra of Graph.h, in millions of edges per second
+(the edges leaving the vertices reachable from the source):
+  1. a random graph with integer weights in [1, 1000], for several deltas
+     on P threads and the default delta on 1 to P threads
+  2. a graph with double weights, and one where a third of the weights are
+     zero, checked for equal distances and valid paths; and a path whose
+     heavy edge rounds back into the bucket it leaves (dist + w < (i + 1)
+     delta in doubles although w >= delta)
+Compile with -pthread.
+*/
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// Check that every parent is joined to its vertex by an edge on a shortest path.
+template<typename Weight>
+bool validPaths( const Graph<Weight>& g, const ShortestPaths<Weight>& sp, Vertex s ) {
+    for (Vertex v = 0; v < g.numVertices(); ++v) {
+        Vertex u = sp.path[v];
+        if (u == NOT_A_VERTEX) {
+            if (v != s && sp.dist[v] != ShortestPaths<Weight>::INFINITY_DISTANCE) return false;
+            continue;
+        }
+        bool tight = false;
+        for (std::int64_t e = g.edgesBegin(u); e < g.edgesEnd(u); ++e) {
+            tight = tight || (g.target(e) == v && sp.dist[u] + g.weight(e) == sp.dist[v]);
+        }
+        if (!tight) return false;
+
+        // and the parents lead back to s
+        int steps = 0;
+        for (Vertex w = v; w != s; w = sp.path[w]) {
+            if (w == NOT_A_VERTEX || ++steps > g.numVertices()) return false;
+        }
+    }
+    return true;
+}
+
+template<typename Weight, typename Distribution>
+Graph<Weight> makeGraph( int n, int degree, Distribution weight, std::mt19937_64& gen ) {
+    GraphBuilder<Weight> builder{ n };
+    builder.reserve(static_cast<std::int64_t>(n) * degree);
+    for (Vertex v = 0; v < n; ++v) {
+        for (int i = 0; i < degree; ++i) {
+            builder.addEdge(v, static_cast<Vertex>(gen() % n), weight(gen));
+        }
+    }
+    return builder.build();
+}
+
+int main( int argc, char* argv[] ) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    int degree = argc > 2 ? std::atoi(argv[2]) : 16;
+    int maxThreads = argc > 3 ? std::atoi(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::mt19937_64 gen{ 44 };
+    Graph<> g = makeGraph<long long>(n, degree, std::uniform_int_distribution<long long>{ 1, 1000 }, gen);
+
+    ShortestPaths<long long> expected;
+    double tDijkstra = millis([&]() { expected = dijkstra(g, 0); });
+    std::int64_t edges = 0;
+    for (Vertex v = 0; v < n; ++v) {
+        if (expected.dist[v] != ShortestPaths<long long>::INFINITY_DISTANCE) edges += g.outDegree(v);
+    }
+    std::cout << "1. N = " << n << ", M = " << g.numEdges() << "\n"
+              << "  dijkstra\t\t\t" << tDijkstra << " ms, " << edges / (tDijkstra * 1e3) << " M edges/s\n";
+
+    auto run = [&]( int p, long long delta ) {
+        TaskScheduler scheduler{ p };
+        ShortestPaths<long long> sp;
+        double t = millis([&]() { sp = deltaStepping(g, 0, scheduler, delta); });
+        std::cout << "  delta " << (delta > 0 ? std::to_string(delta) : "auto") << ", " << p << " threads\t"
+                  << t << " ms, " << edges / (t * 1e3) << " M edges/s"
+                  << (sp.dist == expected.dist && validPaths(g, sp, 0) ? "" : "\tOops!") << "\n";
+    };
+    for (long long delta : { 1LL, 16LL, 64LL, 256LL, 1000LL, 4000LL }) run(maxThreads, delta);
+    for (int p = 1; p <= maxThreads; p *= 2) run(p, 0);
+
+    TaskScheduler scheduler{ maxThreads };
+    int small = std::min(n, 100000);
+    Graph<double> real = makeGraph<double>(small, 8, std::uniform_real_distribution<double>{ 0.0, 1.0 }, gen);
+    ShortestPaths<double> realDist = deltaStepping(real, 0, scheduler);
+    bool ok = realDist.dist == dijkstra(real, 0).dist && validPaths(real, realDist, 0);
+
+    auto zeroOrTen = []( std::mt19937_64& r ) { return static_cast<long long>(r() % 3 == 0 ? 0 : 1 + r() % 10); };
+    Graph<> zeros = makeGraph<long long>(small, 4, zeroOrTen, gen);
+    ShortestPaths<long long> zeroDist = deltaStepping(zeros, 0, scheduler);
+    ok = ok && zeroDist.dist == dijkstra(zeros, 0).dist && validPaths(zeros, zeroDist, 0);
+
+    GraphBuilder<double> rounding{ 4 };
+    rounding.addEdge(0, 1, 565.35578429922509);
+    rounding.addEdge(1, 2, 6.3523121831373608);
+    rounding.addEdge(2, 3, 1.0);
+    Graph<double> rounded = rounding.build();
+    ok = ok && deltaStepping(rounded, 0, scheduler, 6.3523121831373608).dist == dijkstra(rounded, 0).dist;
+
+    std::cout << "2. double and zero weights: " << (ok ? "same distances" : "Oops!") << "\n";
+
+    return 0;
+}
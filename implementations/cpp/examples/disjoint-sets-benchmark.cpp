@@ -0,0 +1,132 @@
+#include "../lib/DisjointSets.h"
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <utility>
+#include <algorithm>
+
+/*
+Connected components of edge streams with union-find:
+  lecture:    union-by-rank with recursive path compression, as in
+              lecture 16
+  DisjointSets: union-by-rank with iterative path halving
+  ConcurrentDisjointSets: 1 to P threads, each uniting a slice of the edges
+Edges are uniform random, or power-law: endpoints drawn with probability
+proportional to 1/v, so a few hubs take part in most edges. All variants
+must agree on the number of components. Compile with -pthread.
+*/
+
+typedef std::pair<int, int> Edge;
+
+// The lecture 16 version, as a baseline.
+class LectureDisjointSets {
+    public:
+        explicit LectureDisjointSets( int numElements ) : s( numElements, -1 ) {}
+
+        int find( int x ) {
+            if (s[x] < 0) { return x; }
+            else          { return s[x] = find(s[x]); }
+        }
+
+        void unionSets( int root1, int root2 ) {
+            if (s[root2] < s[root1]) {
+                s[root1] = root2;
+            }
+            else {
+                if (s[root1] == s[root2]) {
+                    s[root1]--;
+                }
+                s[root2] = root1;
+            }
+        }
+
+    private:
+        std::vector<int> s;
+};
+
+std::vector<Edge> makeEdges( int n, long long m, bool powerLaw ) {
+    std::mt19937_64 gen{ 41 };
+    std::uniform_real_distribution<double> uniform{ 0.0, 1.0 };
+    auto vertex = [&]() {
+        if (!powerLaw) return static_cast<int>(gen() % n);
+        // n^u - 1 has density proportional to 1/(v + 1); shuffle the ids so
+        // the hubs are not the smallest ones
+        int v = static_cast<int>(std::pow(static_cast<double>(n), uniform(gen))) - 1;
+        return static_cast<int>((static_cast<unsigned long long>(v) * 2654435761u) % n);
+    };
+
+    std::vector<Edge> edges(m);
+    for (auto& e : edges) e = { vertex(), vertex() };
+    return edges;
+}
+
+template<typename Function>
+double seconds( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+void run( const char* name, int n, long long m, bool powerLaw, int maxThreads ) {
+    std::vector<Edge> edges = makeEdges(n, m, powerLaw);
+    std::cout << name << " edges, N = " << n << ", M = " << m << "\n";
+
+    int expected = n;
+    double t = seconds([&]() {
+        LectureDisjointSets ds{ n };
+        for (const Edge& e : edges) {
+            int a = ds.find(e.first), b = ds.find(e.second);
+            if (a != b) {
+                ds.unionSets(a, b);
+                expected -= 1;
+            }
+        }
+    });
+    std::cout << "  lecture\t\t" << m / t / 1e6 << " M edges/s, " << expected << " components\n";
+
+    int components = 0;
+    t = seconds([&]() {
+        DisjointSets ds{ n };
+        for (const Edge& e : edges) ds.unite(e.first, e.second);
+        components = ds.numSets();
+    });
+    std::cout << "  DisjointSets\t\t" << m / t / 1e6 << " M edges/s"
+              << (components == expected ? "" : "\tOops!") << "\n";
+
+    for (int p = 1; p <= maxThreads; p *= 2) {
+        ConcurrentDisjointSets ds{ n };
+        t = seconds([&]() {
+            std::vector<std::thread> threads;
+            for (int i = 0; i < p; ++i) {
+                threads.emplace_back([&, i]() {
+                    long long begin = m * i / p, end = m * (i + 1) / p;
+                    for (long long k = begin; k < end; ++k) ds.unite(edges[k].first, edges[k].second);
+                });
+            }
+            for (auto& th : threads) th.join();
+        });
+
+        // every edge must end up inside one set
+        bool ok = ds.numSets() == expected;
+        for (long long k = 0; ok && k < m; k += 97) ok = ds.connected(edges[k].first, edges[k].second);
+
+        std::cout << "  concurrent, " << p << " threads\t" << m / t / 1e6 << " M edges/s"
+                  << (ok ? "" : "\tOops!") << "\n";
+    }
+}
+
+int main( int argc, char* argv[] ) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    long long m = argc > 2 ? std::atoll(argv[2]) : 30000000;
+    int maxThreads = argc > 3 ? std::atoi(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+    run("uniform", n, m, false, maxThreads);
+    run("power-law", n, m, true, maxThreads);
+
+    return 0;
+}
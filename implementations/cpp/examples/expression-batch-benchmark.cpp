@@ -0,0 +1,226 @@
+#include "../lib/ExpressionTree.h"
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+/*
+Many small expressions, each evaluated over columns of doubles and 64-bit
+integers with ExpressionTree::evaluate:
+  1. random expressions over two double and two integer columns: the
+     batch evaluation must match evaluation of the tree row by row
+  2. parsing M small infix expressions (1M by default) into trees and
+     freeing them, in expressions per second
+  3. K of those expressions (1000 by default), each over N rows (10000 by
+     default): recursive evaluation of a pointer-based lecture tree and
+     evaluation of the ExpressionTree row by row, against
+     evaluate(columns, n, out), in millions of rows per second
+  4. a sum of 100000 terms, a tree as deep as it is large: printing,
+     evaluation and compiling must not run out of stack
+*/
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+bool same( double x, double y ) {
+    return x == y || (std::isnan(x) && std::isnan(y));
+}
+
+// The expression tree of lecture 6, one new per node, evaluated
+// recursively: the baseline for evaluate. Built from the postfix
+// expression of an ExpressionTree, with its variable numbers.
+class LectureExpressionTree {
+    public:
+        explicit LectureExpressionTree( const ExpressionTree& tree ) : root{ nullptr } {
+            std::vector<BinaryNode*> stack;
+            std::istringstream in{ tree.postfix() };
+            std::string token;
+            while (in >> token) {
+                if (token.size() == 1 && std::string("+-*/~").find(token[0]) != std::string::npos) {
+                    BinaryNode* right = token[0] == '~' ? nullptr : stack.back();
+                    if (right != nullptr) stack.pop_back();
+                    BinaryNode* left = stack.back();
+                    stack.back() = new BinaryNode{ token[0], 0, -1, left, right };
+                }
+                else if (std::isdigit(static_cast<unsigned char>(token[0])) || token[0] == '.' || token[0] == '-') {
+                    stack.push_back(new BinaryNode{ 0, std::strtod(token.c_str(), nullptr), -1, nullptr, nullptr });
+                }
+                else {
+                    const std::vector<std::string>& names = tree.variables();
+                    int v = static_cast<int>(std::find(names.begin(), names.end(), token) - names.begin());
+                    stack.push_back(new BinaryNode{ 0, 0, v, nullptr, nullptr });
+                }
+            }
+            root = stack.back();
+        }
+        LectureExpressionTree( const LectureExpressionTree& rhs ) = delete;
+        LectureExpressionTree( LectureExpressionTree&& rhs ) : root{ rhs.root } { rhs.root = nullptr; }
+        ~LectureExpressionTree() { makeEmpty(root); }
+
+        double evaluate( const std::vector<double>& values ) const { return evaluate(root, values); }
+
+    private:
+        struct BinaryNode {
+            char op;          // 0 for a leaf
+            double value;
+            int variable;     // -1 for a constant
+            BinaryNode* left;
+            BinaryNode* right;
+        };
+        BinaryNode* root;
+
+        static double evaluate( const BinaryNode* t, const std::vector<double>& values ) {
+            switch (t->op) {
+                case 0:   return t->variable >= 0 ? values[t->variable] : t->value;
+                case '~': return -evaluate(t->left, values);
+                case '+': return evaluate(t->left, values) + evaluate(t->right, values);
+                case '-': return evaluate(t->left, values) - evaluate(t->right, values);
+                case '*': return evaluate(t->left, values) * evaluate(t->right, values);
+                default:  return evaluate(t->left, values) / evaluate(t->right, values);
+            }
+        }
+
+        static void makeEmpty( BinaryNode* t ) {
+            if (t != nullptr) {
+                makeEmpty(t->left);
+                makeEmpty(t->right);
+                delete t;
+            }
+        }
+};
+
+// A random infix expression over x0..x3 with small constants.
+std::string randomExpression( int depth, std::mt19937& gen ) {
+    if (depth == 0 || gen() % 4 == 0) {
+        if (gen() % 3 == 0) return std::to_string(1 + gen() % 9);
+        return "x" + std::to_string(gen() % 4);
+    }
+    std::string left = randomExpression(depth - 1, gen), right = randomExpression(depth - 1, gen);
+    switch (gen() % 5) {
+        case 0:  return left + " + " + right;
+        case 1:  return left + " - " + right;
+        case 2:  return "(" + left + ") * (" + right + ")";
+        case 3:  return "(" + left + ") / (" + right + ")";
+        default: return "-(" + left + ")";
+    }
+}
+
+int main( int argc, char* argv[] ) {
+    std::size_t numExpressions = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    std::size_t k = argc > 2 ? std::atoll(argv[2]) : 1000;
+    std::size_t n = argc > 3 ? std::atoll(argv[3]) : 10000;
+    std::mt19937 gen{ 50 };
+
+    // x0 and x2 are doubles, x1 and x3 integers
+    std::vector<double> x0(n), x2(n);
+    std::vector<std::int64_t> x1(n), x3(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        x0[i] = static_cast<double>(gen() % 2001) / 100 - 10;
+        x1[i] = static_cast<std::int64_t>(gen() % 2001) - 1000;
+        x2[i] = static_cast<double>(gen() % 2001) / 100 - 10;
+        x3[i] = static_cast<std::int64_t>(gen() % 2001) - 1000;
+    }
+    std::vector<ExpressionTree::Column> columns{ x0.data(), x1.data(), x2.data(), x3.data() };
+    auto row = [&]( std::size_t i ) {
+        return std::vector<double>{ x0[i], static_cast<double>(x1[i]), x2[i], static_cast<double>(x3[i]) };
+    };
+
+    // 1. mixed columns; every variable shows up first in order, so that
+    //    x0..x3 are variables 0..3
+    int failures = 0;
+    std::vector<double> out(n);
+    for (int trial = 0; trial < 300; ++trial) {
+        ExpressionTree tree = ExpressionTree::fromInfix("x0 * 0 + x1 * 0 + x2 * 0 + x3 * 0 + " + randomExpression(6, gen));
+        std::size_t rows = std::min<std::size_t>(n, 1000);
+        tree.evaluate(columns, rows, out.data());
+        bool ok = true;
+        for (std::size_t i = 0; i < rows; ++i) ok = ok && same(out[i], tree.evaluate(row(i)));
+        if (!ok) failures += 1;
+    }
+    std::cout << "1. 300 expressions over mixed columns: " << (failures == 0 ? "all agree" : "Oops!") << "\n";
+
+    // 2. parse and free
+    std::vector<std::string> expressions(numExpressions);
+    std::size_t length = 0;
+    for (std::string& e : expressions) {
+        e = "x0 * 0 + x1 * 0 + x2 * 0 + x3 * 0 + " + randomExpression(3, gen);
+        length += e.size();
+    }
+    std::size_t nodes = 0;
+    double t = millis([&]() {
+        for (const std::string& e : expressions) nodes += ExpressionTree::fromInfix(e).size();
+    });
+    std::cout << "2. " << numExpressions << " expressions of " << length / numExpressions << " characters, "
+              << nodes / numExpressions << " nodes on average\n"
+              << "  parse and free\t" << t << " ms, " << numExpressions / (t * 1e3) << " M expressions/s\n";
+
+    // 3. evaluation
+    std::vector<ExpressionTree> trees;
+    for (std::size_t e = 0; e < k && e < expressions.size(); ++e) trees.push_back(ExpressionTree::fromInfix(expressions[e]));
+    std::vector<std::vector<double>> rows(n);
+    for (std::size_t i = 0; i < n; ++i) rows[i] = row(i);
+    std::cout << "3. " << trees.size() << " expressions over N = " << n << " rows\n";
+
+    std::vector<LectureExpressionTree> lectureTrees;
+    for (const ExpressionTree& tree : trees) lectureTrees.emplace_back(tree);
+    std::vector<std::vector<double>> expected(trees.size(), std::vector<double>(n));
+    t = millis([&]() {
+        for (std::size_t e = 0; e < trees.size(); ++e) {
+            for (std::size_t i = 0; i < n; ++i) expected[e][i] = lectureTrees[e].evaluate(rows[i]);
+        }
+    });
+    double rowsTotal = static_cast<double>(trees.size()) * n;
+    std::cout << "  recursive\t" << t << " ms, " << rowsTotal / (t * 1e3) << " M rows/s\n";
+
+    std::vector<std::vector<double>> byTree(trees.size(), std::vector<double>(n));
+    t = millis([&]() {
+        for (std::size_t e = 0; e < trees.size(); ++e) {
+            for (std::size_t i = 0; i < n; ++i) byTree[e][i] = trees[e].evaluate(rows[i]);
+        }
+    });
+    bool agree = true;
+    for (std::size_t e = 0; e < trees.size(); ++e) {
+        for (std::size_t i = 0; i < n; ++i) agree = agree && same(byTree[e][i], expected[e][i]);
+    }
+    std::cout << "  tree\t\t" << t << " ms, " << rowsTotal / (t * 1e3) << " M rows/s"
+              << (agree ? "" : "\tOops!") << "\n";
+
+    std::vector<std::vector<double>> batch(trees.size(), std::vector<double>(n));
+    t = millis([&]() {
+        for (std::size_t e = 0; e < trees.size(); ++e) trees[e].evaluate(columns, n, batch[e].data());
+    });
+    bool ok = true;
+    for (std::size_t e = 0; e < trees.size(); ++e) {
+        for (std::size_t i = 0; i < n; ++i) ok = ok && same(batch[e][i], expected[e][i]);
+    }
+    std::cout << "  evaluate\t" << t << " ms, " << rowsTotal / (t * 1e3) << " M rows/s"
+              << (ok ? "" : "\tOops!") << "\n";
+
+    // 4. a left spine of 100000 additions
+    const int TERMS = 100000;
+    std::string sum = "x0";
+    for (int i = 1; i < TERMS; ++i) sum += " + x0";
+    ExpressionTree deep = ExpressionTree::fromInfix(sum);
+    std::string printed = deep.infix();
+    bool deepOk = ExpressionTree::fromPostfix(deep.postfix()).infix() == printed
+                  && deep.evaluate({ 1 }) == TERMS;
+    deep.evaluate(columns, n, out.data());
+    for (std::size_t i = 0; i < std::min<std::size_t>(n, 10); ++i) deepOk = deepOk && same(out[i], deep.evaluate({ x0[i] }));
+    std::cout << "4. a sum of " << TERMS << " terms, " << deep.size() << " nodes: "
+              << (deepOk ? "printed, evaluated and compiled" : "Oops!") << "\n";
+
+    return 0;
+}
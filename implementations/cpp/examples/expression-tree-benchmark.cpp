@@ -0,0 +1,156 @@
+#include "../lib/ExpressionTree.h"
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+/*
+Expression trees built from postfix and infix expressions, and compiled:
+  1. the tree of lecture 6 from its postfix expression
+  2. precedence, unary minus and malformed expressions
+  3. folding and sharing: the program of an expression with a repeated
+     subexpression and constant parts; x - -0 must not become x
+  4. random expressions: printing and parsing again gives the same tree,
+     and the program computes what the tree does, row by row
+  5. a formula over N rows (10M by default): evaluation of the tree row
+     by row against the program, in millions of rows per second
+*/
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+bool same( double x, double y ) {
+    return x == y || (std::isnan(x) && std::isnan(y));
+}
+
+// A random infix expression over x0..x3 with small constants; repeat makes
+// the same subexpression show up more than once.
+std::string randomExpression( int depth, std::mt19937& gen, const std::string& repeat ) {
+    if (depth == 0 || gen() % 4 == 0) {
+        switch (gen() % 4) {
+            case 0:  return std::to_string(gen() % 4) + (gen() % 2 ? ".5" : "");
+            case 1:  return repeat;
+            default: return "x" + std::to_string(gen() % 4);
+        }
+    }
+    std::string left = randomExpression(depth - 1, gen, repeat), right = randomExpression(depth - 1, gen, repeat);
+    switch (gen() % 5) {
+        case 0:  return "(" + left + " + " + right + ")";
+        case 1:  return "(" + left + " - " + right + ")";
+        case 2:  return "(" + left + " * " + right + ")";
+        case 3:  return "(" + left + " / " + right + ")";
+        default: return "-" + left;
+    }
+}
+
+bool throws( const std::string& expression, bool postfix ) {
+    try {
+        if (postfix) ExpressionTree::fromPostfix(expression);
+        else ExpressionTree::fromInfix(expression);
+    }
+    catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+int main( int argc, char* argv[] ) {
+    std::size_t n = argc > 1 ? std::atoll(argv[1]) : 10000000;
+    std::mt19937 gen{ 49 };
+
+    // 1. a b + c d e + * *
+    ExpressionTree lecture = ExpressionTree::fromPostfix("a b + c d e + * *");
+    std::cout << "1. " << lecture.postfix() << " is " << lecture.infix() << "\n";
+    if (lecture.infix() != "((a + b) * (c * (d + e)))" || lecture.size() != 9
+        || lecture.evaluate({ 1, 2, 3, 4, 5 }) != 81) {
+        std::cout << "Oops! Wrong tree for the lecture expression.\n";
+    }
+
+    // 2. precedence and errors
+    ExpressionTree infix = ExpressionTree::fromInfix("1 + 2 * 3 - 4 / 2 - -(2 - 5) * -x");
+    std::cout << "2. 1 + 2 * 3 - 4 / 2 - -(2 - 5) * -x is " << infix.infix() << "\n";
+    bool errors = throws("a +", false) && throws("(a", false) && throws("a)", false) && throws("a b", false)
+                  && throws("a * / b", false) && throws("", false) && throws("2 $ 3", false)
+                  && throws("3 4 + +", true) && throws("3 4", true) && throws("", true) && throws("( 3 )", true);
+    if (infix.evaluate({ 2 }) != 11 || !errors) {
+        std::cout << "Oops! Wrong precedence or a malformed expression accepted.\n";
+    }
+
+    // 3. folding and sharing
+    ExpressionTree shared = ExpressionTree::fromInfix("(a + b) * (a + b) + 2 * 3 * c - 0 + -(-(b + a)) * 1");
+    ExpressionTree::Program program = shared.compile();
+    std::cout << "3. " << shared.infix() << ": " << shared.size() << " nodes, "
+              << program.numInstructions() << " instructions\n";
+    program.print();
+    if (program.numInstructions() != 5 || program.evaluate({ 1, 2, 3 }) != shared.evaluate({ 1, 2, 3 })) {
+        std::cout << "Oops! Wrong program.\n";
+    }
+    // x - -0 is +0 for x = -0, so it is not dropped like x - 0
+    ExpressionTree minusZero = ExpressionTree::fromPostfix("x 0 ~ -");
+    if (std::signbit(minusZero.compile().evaluate({ -0.0 })) || std::signbit(minusZero.evaluate({ -0.0 }))) {
+        std::cout << "Oops! x - -0 was simplified to x.\n";
+    }
+
+    // 4. random expressions
+    int failures = 0;
+    std::vector<std::vector<double>> rows(1000, std::vector<double>(4));
+    std::vector<std::vector<double>> columns(4, std::vector<double>(rows.size()));
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        for (int v = 0; v < 4; ++v) {
+            columns[v][i] = rows[i][v] = static_cast<double>(gen() % 2001) / 100 - 10;
+        }
+    }
+    for (int trial = 0; trial < 2000; ++trial) {
+        std::string repeat = randomExpression(2, gen, "x0");
+        ExpressionTree tree = ExpressionTree::fromInfix("x0 * 0 + x1 * 0 + x2 * 0 + x3 * 0 + "
+                                                        + randomExpression(6, gen, repeat));
+        bool ok = ExpressionTree::fromInfix(tree.infix()).infix() == tree.infix()
+                  && ExpressionTree::fromPostfix(tree.postfix()).infix() == tree.infix();
+
+        ExpressionTree::Program compiled = tree.compile();
+        std::vector<const double*> in{ columns[0].data(), columns[1].data(), columns[2].data(), columns[3].data() };
+        std::vector<double> out(rows.size());
+        compiled.evaluate(in, rows.size(), out.data());
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            ok = ok && same(out[i], tree.evaluate(rows[i]));
+        }
+        if (!ok) failures += 1;
+    }
+    std::cout << "4. 2000 random expressions: " << (failures == 0 ? "all agree" : "Oops!") << "\n";
+
+    // 5. throughput
+    ExpressionTree formula = ExpressionTree::fromInfix(
+        "(price * quantity - discount) * (1 + tax / 100) + (price * quantity - discount) * 0.5 / (quantity + 1)");
+    ExpressionTree::Program compiled = formula.compile();
+    std::vector<std::vector<double>> data(4, std::vector<double>(n));
+    for (auto& column : data) {
+        for (double& x : column) x = static_cast<double>(gen() % 10000) / 100;
+    }
+    std::cout << "5. " << formula.infix() << "\n   " << formula.size() << " nodes, "
+              << compiled.numInstructions() << " instructions, N = " << n << "\n";
+
+    std::vector<double> expected(n), out(n);
+    double t = millis([&]() {
+        std::vector<double> values(4);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (int v = 0; v < 4; ++v) values[v] = data[v][i];
+            expected[i] = formula.evaluate(values);
+        }
+    });
+    std::cout << "  tree\t\t" << t << " ms, " << n / (t * 1e3) << " M rows/s\n";
+
+    std::vector<const double*> in{ data[0].data(), data[1].data(), data[2].data(), data[3].data() };
+    t = millis([&]() { compiled.evaluate(in, n, out.data()); });
+    std::cout << "  program\t" << t << " ms, " << n / (t * 1e3) << " M rows/s"
+              << (out == expected ? "" : "\tOops!") << "\n";
+
+    return 0;
+}
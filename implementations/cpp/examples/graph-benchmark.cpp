@@ -0,0 +1,194 @@
+#include "../lib/Graph.h"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <queue>
+#include <filesystem>
+
+/*
+The lecture 17 algorithms on the CSR Graph:
+  1.-3. topsort, unweighted and dijkstra on the seven-vertex graph of
+        lecture 17, and topsort on a graph with a cycle
+  4.    writing a random weighted graph as an edge-list file and loading
+        it with loadEdgeList, and lines with trailing text, which must be
+        rejected
+  5.    unweighted and dijkstra on the loaded graph against the same
+        searches over std::vector<std::vector<...>> adjacency lists
+*/
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+struct ListEdge {
+    Vertex to;
+    long long cost;
+};
+
+typedef std::vector<std::vector<ListEdge>> AdjacencyLists;
+
+std::vector<int> listBfs( const AdjacencyLists& g, Vertex s ) {
+    std::vector<int> dist(g.size(), ShortestPaths<int>::INFINITY_DISTANCE);
+    std::queue<Vertex> q;
+    dist[s] = 0;
+    q.push(s);
+    while (!q.empty()) {
+        Vertex v = q.front();
+        q.pop();
+        for (const ListEdge& e : g[v]) {
+            if (dist[e.to] == ShortestPaths<int>::INFINITY_DISTANCE) {
+                dist[e.to] = dist[v] + 1;
+                q.push(e.to);
+            }
+        }
+    }
+    return dist;
+}
+
+std::vector<long long> listDijkstra( const AdjacencyLists& g, Vertex s ) {
+    typedef std::pair<long long, Vertex> Entry;
+    std::vector<long long> dist(g.size(), ShortestPaths<long long>::INFINITY_DISTANCE);
+    std::vector<int> handle(g.size(), -1);
+    std::vector<bool> known(g.size(), false);
+    IndexedBinaryHeap<Entry> pq{};
+
+    dist[s] = 0;
+    handle[s] = pq.insert(Entry{ 0, s });
+    Entry e;
+    while (!pq.isEmpty()) {
+        pq.deleteMin(e);
+        handle[e.second] = -1;
+        known[e.second] = true;
+        for (const ListEdge& edge : g[e.second]) {
+            if (known[edge.to]) continue;
+            long long d = e.first + edge.cost;
+            if (d < dist[edge.to]) {
+                dist[edge.to] = d;
+                if (handle[edge.to] == -1) handle[edge.to] = pq.insert(Entry{ d, edge.to });
+                else                       pq.decreaseKey(handle[edge.to], Entry{ d, edge.to });
+            }
+        }
+    }
+    return dist;
+}
+
+int main( int argc, char* argv[] ) {
+    int numVertices = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int degree = argc > 2 ? std::atoi(argv[2]) : 16;
+
+    // 1. lecture 17: v1..v7 as 0..6
+    GraphBuilder<> builder{};
+    int lectureEdges[][3] = {
+        {0, 1, 2}, {0, 3, 1}, {1, 3, 3}, {1, 4, 10}, {2, 0, 4}, {2, 5, 5}, {3, 2, 2},
+        {3, 4, 2}, {3, 5, 8}, {3, 6, 4}, {4, 6, 6}, {6, 5, 1}
+    };
+    for (const auto& e : lectureEdges) builder.addEdge(e[0], e[1], e[2]);
+    Graph<> lecture = builder.build();
+
+    ShortestPaths<long long> sp = dijkstra(lecture, 0);
+    std::vector<long long> expectedDist{ 0, 2, 3, 1, 3, 6, 5 };
+    std::vector<Vertex> expectedPath{ 0, 3, 6, 5 };
+    if (sp.dist != expectedDist || sp.pathTo(5) != expectedPath) {
+        std::cout << "Oops! dijkstra is wrong on the lecture graph.\n";
+    }
+    ShortestPaths<int> hops = unweighted(lecture, 2);
+    if (hops.dist != std::vector<int>{ 1, 2, 0, 2, 3, 1, 3 }) {
+        std::cout << "Oops! unweighted is wrong on the lecture graph.\n";
+    }
+    std::cout << "1. dijkstra from v1: ";
+    for (long long d : sp.dist) std::cout << d << " ";
+    std::cout << "\n";
+
+    // 2. the same graph without the edge v3 -> v1 is acyclic
+    GraphBuilder<> dagBuilder{};
+    for (const auto& e : lectureEdges) {
+        if (e[0] != 2 || e[1] != 0) dagBuilder.addEdge(e[0], e[1]);
+    }
+    Graph<> dag = dagBuilder.build();
+    std::vector<Vertex> order = topsort(dag);
+    std::vector<int> position(dag.numVertices());
+    for (int i = 0; i < static_cast<int>(order.size()); ++i) position[order[i]] = i;
+    bool ordered = true;
+    for (Vertex v = 0; v < dag.numVertices(); ++v) {
+        for (Vertex w : dag.adjacent(v)) ordered = ordered && position[v] < position[w];
+    }
+    std::cout << "2. topsort: ";
+    for (Vertex v : order) std::cout << "v" << v + 1 << " ";
+    std::cout << (ordered ? "\n" : "\nOops! topsort is not a topological order.\n");
+
+    // 3. v1 -> v4 -> v3 -> v1 is a cycle
+    try {
+        topsort(lecture);
+        std::cout << "Oops! topsort missed a cycle.\n";
+    }
+    catch (const CycleFoundException& e) {
+        std::cout << "3. topsort: " << e.what() << "\n";
+    }
+
+    // 4. a random graph through an edge-list file
+    std::mt19937 gen{ 42 };
+    AdjacencyLists lists(numVertices);
+    std::string path = (std::filesystem::temp_directory_path() / "graph-benchmark.edges").string();
+    {
+        std::ofstream out{ path };
+        out << "# from to weight\n";
+        for (Vertex v = 0; v < numVertices; ++v) {
+            for (int i = 0; i < degree; ++i) {
+                Vertex w = static_cast<Vertex>(gen() % numVertices);
+                long long c = 1 + gen() % 1000;
+                lists[v].push_back(ListEdge{ w, c });
+                out << v << " " << w << " " << c << "\n";
+            }
+        }
+    }
+
+    Graph<> g;
+    double tLoad = millis([&]() { g = loadEdgeList<long long>(path, true); });
+    std::cout << "4. loadEdgeList: " << g.numVertices() << " vertices, " << g.numEdges() << " edges in "
+              << tLoad << " ms\n";
+
+    // (line, weighted)
+    std::vector<std::pair<std::string, bool>> malformed{ { "0 1x\n", false }, { "0 1 junk\n", false },
+                                                          { "0 1 5 extra\n", true }, { "0 1 5\r\n0 1 5 6\n", true } };
+    bool rejected = true;
+    for (const auto& line : malformed) {
+        { std::ofstream out{ path }; out << line.first; }
+        try {
+            loadEdgeList<long long>(path, line.second);
+            rejected = false;
+        }
+        catch (const std::runtime_error&) { }
+    }
+    { std::ofstream out{ path }; out << "0 1 5 \t\r\n"; }
+    if (!rejected || loadEdgeList<long long>(path, true).numEdges() != 1) {
+        std::cout << "Oops! loadEdgeList accepted trailing text or rejected trailing blanks.\n";
+    }
+    std::filesystem::remove(path);
+
+    // 5. CSR against adjacency lists
+    ShortestPaths<int> bfs;
+    std::vector<int> listHops;
+    double tBfs = millis([&]() { bfs = unweighted(g, 0); });
+    double tListBfs = millis([&]() { listHops = listBfs(lists, 0); });
+
+    ShortestPaths<long long> csrDist;
+    std::vector<long long> listDist;
+    double tDijkstra = millis([&]() { csrDist = dijkstra(g, 0); });
+    double tListDijkstra = millis([&]() { listDist = listDijkstra(lists, 0); });
+
+    std::cout << "5. unweighted: CSR " << tBfs << " ms, lists " << tListBfs << " ms\n"
+              << "   dijkstra:   CSR " << tDijkstra << " ms, lists " << tListDijkstra << " ms\n";
+    if (bfs.dist != listHops || csrDist.dist != listDist) {
+        std::cout << "Oops! CSR and adjacency lists disagree.\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include "../lib/BinaryHeap.h"
+#include "../lib/IndexedBinaryHeap.h"
+
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <random>
+#include <chrono>
+#include <limits>
+
+/*
+Dijkstra's algorithm on a random directed graph, once with lazy deletion
+(BinaryHeap holding duplicate (distance, vertex) pairs whose stale copies
+are skipped) and once with IndexedBinaryHeap::decreaseKey. Reports time and
+the largest heap size each one reached.
+*/
+
+struct Edge {
+    int to;
+    long long cost;
+};
+
+using Graph = std::vector<std::vector<Edge>>;
+using Entry = std::pair<long long, int>; // (distance, vertex)
+
+const long long INFINITY_COST = std::numeric_limits<long long>::max();
+
+std::vector<long long> lazyDijkstra( const Graph& g, int s, int& maxHeapSize ) {
+    std::vector<long long> dist(g.size(), INFINITY_COST);
+    BinaryHeap<Entry> pq{};
+    int heapSize = 0;
+    maxHeapSize = 0;
+
+    dist[s] = 0;
+    pq.insert(Entry{ 0, s });
+    heapSize += 1;
+
+    Entry e;
+    while (!pq.isEmpty()) {
+        pq.deleteMin(e);
+        heapSize -= 1;
+        if (e.first != dist[e.second]) continue; // stale duplicate
+
+        for (const Edge& edge : g[e.second]) {
+            long long d = e.first + edge.cost;
+            if (d < dist[edge.to]) {
+                dist[edge.to] = d;
+                pq.insert(Entry{ d, edge.to });
+                heapSize += 1;
+                if (heapSize > maxHeapSize) maxHeapSize = heapSize;
+            }
+        }
+    }
+    return dist;
+}
+
+std::vector<long long> indexedDijkstra( const Graph& g, int s, int& maxHeapSize ) {
+    std::vector<long long> dist(g.size(), INFINITY_COST);
+    std::vector<int> handle(g.size(), -1);
+    IndexedBinaryHeap<Entry> pq{};
+    maxHeapSize = 0;
+
+    dist[s] = 0;
+    handle[s] = pq.insert(Entry{ 0, s });
+
+    Entry e;
+    while (!pq.isEmpty()) {
+        pq.deleteMin(e);
+        handle[e.second] = -1;
+
+        for (const Edge& edge : g[e.second]) {
+            long long d = e.first + edge.cost;
+            if (d < dist[edge.to]) {
+                dist[edge.to] = d;
+                if (handle[edge.to] == -1) {
+                    handle[edge.to] = pq.insert(Entry{ d, edge.to });
+                }
+                else {
+                    pq.decreaseKey(handle[edge.to], Entry{ d, edge.to });
+                }
+                if (pq.size() > maxHeapSize) maxHeapSize = pq.size();
+            }
+        }
+    }
+    return dist;
+}
+
+int main( int argc, char* argv[] ) {
+    int numVertices = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int degree = argc > 2 ? std::atoi(argv[2]) : 16;
+
+    std::mt19937 gen{ 335 };
+    Graph g(numVertices);
+    for (int v = 0; v < numVertices; ++v) {
+        for (int i = 0; i < degree; ++i) {
+            g[v].push_back(Edge{ static_cast<int>(gen() % numVertices), static_cast<long long>(1 + gen() % 1000) });
+        }
+    }
+
+    int lazyMax, indexedMax;
+    std::vector<long long> lazy, indexed;
+
+    auto t0 = std::chrono::steady_clock::now();
+    lazy = lazyDijkstra(g, 0, lazyMax);
+    auto t1 = std::chrono::steady_clock::now();
+    indexed = indexedDijkstra(g, 0, indexedMax);
+    auto t2 = std::chrono::steady_clock::now();
+
+    std::cout << "V = " << numVertices << ", E = " << numVertices * static_cast<long long>(degree) << "\n";
+    std::cout << "lazy deletion:\t" << std::chrono::duration<double, std::milli>(t1 - t0).count()
+              << " ms, max heap size " << lazyMax << "\n";
+    std::cout << "decreaseKey:\t" << std::chrono::duration<double, std::milli>(t2 - t1).count()
+              << " ms, max heap size " << indexedMax << "\n";
+
+    if (lazy != indexed) {
+        std::cout << "Oops! Distances differ.\n";
+    }
+
+    // handle bookkeeping under remove and increaseKey
+    IndexedBinaryHeap<int> h{ 4 };
+    std::vector<int> handles;
+    for (int i = 0; i < 10; ++i) handles.push_back(h.insert(i * 10));
+    h.remove(handles[0]);
+    h.increaseKey(handles[1], 95);
+    h.decreaseKey(handles[9], 5);
+    std::vector<int> order;
+    while (!h.isEmpty()) { order.push_back(h.findMin()); h.deleteMin(); }
+    if (order != std::vector<int>{ 5, 20, 30, 40, 50, 60, 70, 80, 95 }) {
+        std::cout << "Oops! remove/increaseKey/decreaseKey misordered the heap.\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include "../lib/MaxFlow.h"
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+
+/*
+Maximum flow with FlowNetwork:
+  1. the graph W of lecture 19, whose maximum flow is 5
+  2. edmondsKarp, dinic and pushRelabel on small random networks: the same
+     value, a valid flow, and a minimum cut of the same capacity
+  3. the three algorithms on an assignment network (a source feeding
+     workers, workers connected to the tasks they can do, and tasks
+     feeding a sink) and on a layered random network; edmondsKarp only
+     at scale 5000 or less, where it already takes seconds
+*/
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+struct Edge {
+    Vertex from, to;
+    long long capacity;
+};
+
+// Check capacities, conservation and the cut of the last solve of net.
+bool validFlow( const FlowNetwork<>& net, const std::vector<Edge>& edges, Vertex s, Vertex t, long long value ) {
+    std::vector<long long> balance(net.numVertices(), 0);
+    for (int e = 0; e < net.numEdges(); ++e) {
+        long long f = net.flow(e);
+        if (f < 0 || f > edges[e].capacity) return false;
+        balance[edges[e].from] -= f;
+        balance[edges[e].to] += f;
+    }
+    for (Vertex v = 0; v < net.numVertices(); ++v) {
+        if (v != s && v != t && balance[v] != 0) return false;
+    }
+    if (balance[t] != value) return false;
+
+    std::vector<bool> side = net.minCut();
+    long long cut = 0;
+    for (int e : net.minCutEdges()) cut += edges[e].capacity;
+    return side[s] && !side[t] && cut == value;
+}
+
+FlowNetwork<> makeNetwork( const std::vector<Edge>& edges ) {
+    FlowNetwork<> net{};
+    for (const Edge& e : edges) net.addEdge(e.from, e.to, e.capacity);
+    return net;
+}
+
+void run( const std::string& name, const std::vector<Edge>& edges, Vertex s, Vertex t, bool withEdmondsKarp ) {
+    FlowNetwork<> net = makeNetwork(edges);
+    std::cout << name << ": " << net.numVertices() << " vertices, " << net.numEdges() << " edges\n";
+
+    long long expected = -1;
+    auto measure = [&]( const char* algorithm, long long (FlowNetwork<>::*solve)( Vertex, Vertex ) ) {
+        long long value = 0;
+        double t0 = millis([&]() { value = (net.*solve)(s, t); });
+        if (expected < 0) expected = value;
+        std::cout << "  " << algorithm << "\t" << t0 << " ms, flow " << value
+                  << (value == expected && validFlow(net, edges, s, t, value) ? "" : "\tOops!") << "\n";
+    };
+    if (withEdmondsKarp) measure("edmondsKarp", &FlowNetwork<>::edmondsKarp);
+    measure("dinic\t", &FlowNetwork<>::dinic);
+    measure("pushRelabel", &FlowNetwork<>::pushRelabel);
+}
+
+int main( int argc, char* argv[] ) {
+    int scale = argc > 1 ? std::atoi(argv[1]) : 200000;
+    std::mt19937_64 gen{ 45 };
+
+    // 1. s, a, b, c, d, t as 0..5
+    std::vector<Edge> w{ {0, 1, 4}, {0, 2, 2}, {1, 2, 1}, {1, 3, 2}, {1, 4, 4}, {2, 4, 2}, {3, 5, 3}, {4, 5, 3} };
+    FlowNetwork<> lecture = makeNetwork(w);
+    long long ek = lecture.edmondsKarp(0, 5), di = lecture.dinic(0, 5), pr = lecture.pushRelabel(0, 5);
+    std::cout << "1. maximum flow of W: " << ek << " " << di << " " << pr << "\n";
+    if (ek != 5 || di != 5 || pr != 5 || !validFlow(lecture, w, 0, 5, 5)) {
+        std::cout << "Oops! Wrong maximum flow on W.\n";
+    }
+
+    // 2. random small networks, with parallel and antiparallel edges
+    int failures = 0;
+    for (int trial = 0; trial < 2000; ++trial) {
+        int n = 2 + static_cast<int>(gen() % 12);
+        int m = static_cast<int>(gen() % (4 * n));
+        std::vector<Edge> edges(m);
+        for (Edge& e : edges) {
+            e = Edge{ static_cast<Vertex>(gen() % n), static_cast<Vertex>(gen() % n),
+                      static_cast<long long>(gen() % 10) };
+        }
+        FlowNetwork<> net = makeNetwork(edges);
+        net.addEdge(n - 1, n - 1, 0); // make sure every vertex exists
+        edges.push_back(Edge{ n - 1, n - 1, 0 });
+
+        long long a = net.edmondsKarp(0, n - 1);
+        bool ok = validFlow(net, edges, 0, n - 1, a);
+        long long b = net.dinic(0, n - 1);
+        ok = ok && validFlow(net, edges, 0, n - 1, b);
+        long long c = net.pushRelabel(0, n - 1);
+        ok = ok && validFlow(net, edges, 0, n - 1, c);
+        if (!ok || a != b || a != c) failures += 1;
+    }
+    std::cout << "2. 2000 random networks: " << (failures == 0 ? "all agree" : "Oops!") << "\n";
+
+    // 3. an assignment network: workers 1..W, tasks W+1..W+T
+    int workers = scale, tasks = scale / 2;
+    Vertex source = 0, sink = workers + tasks + 1;
+    std::vector<Edge> assignment;
+    for (int i = 1; i <= workers; ++i) {
+        assignment.push_back(Edge{ source, i, static_cast<long long>(1 + gen() % 8) });
+        for (int k = 0; k < 5; ++k) {
+            Vertex task = workers + 1 + static_cast<Vertex>(gen() % tasks);
+            assignment.push_back(Edge{ i, task, static_cast<long long>(1 + gen() % 4) });
+        }
+    }
+    for (int j = 1; j <= tasks; ++j) {
+        assignment.push_back(Edge{ workers + j, sink, static_cast<long long>(1 + gen() % 12) });
+    }
+    run("3. assignment", assignment, source, sink, scale <= 5000);
+
+    // layers of width L, each vertex joined to 4 random vertices of the next layer
+    int width = 256, layers = std::max(2, scale / width);
+    std::vector<Edge> layered;
+    Vertex layeredSink = width * layers + 1;
+    for (int i = 1; i <= width; ++i) layered.push_back(Edge{ 0, i, 1000000 });
+    for (int l = 0; l < layers - 1; ++l) {
+        for (int i = 1; i <= width; ++i) {
+            for (int k = 0; k < 4; ++k) {
+                Vertex to = (l + 1) * width + 1 + static_cast<Vertex>(gen() % width);
+                layered.push_back(Edge{ l * width + i, to, static_cast<long long>(1 + gen() % 100) });
+            }
+        }
+    }
+    for (int i = 1; i <= width; ++i) layered.push_back(Edge{ (layers - 1) * width + i, layeredSink, 1000000 });
+    run("   layered", layered, 0, layeredSink, scale <= 5000);
+
+    return 0;
+}
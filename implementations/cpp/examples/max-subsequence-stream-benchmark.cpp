@@ -0,0 +1,110 @@
+#include "../lib/MaxSubsequenceStream.h"
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdint>
+
+/*
+The maximum subsequence sum of a stream, with Stream and Window:
+  1. random streams pushed in random chunks: after every chunk, the best
+     subsequence of the Stream and of Windows of several widths must have
+     the sum v4 finds over the same samples, and bounds that hold it
+  2. throughput in millions of samples per second over N random samples,
+     pushed one at a time and in chunks of 4096, for Stream and for
+     Windows of 1000 and 1000000 samples
+*/
+
+using namespace MaxSubsequenceSum;
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// Check best against v4 over samples[first, last).
+bool check( const std::vector<int>& samples, std::size_t first, std::size_t last, const Subsequence<std::int64_t>& best ) {
+    std::vector<int> window(samples.begin() + first, samples.begin() + last);
+    if (best.begin < first || best.begin > best.end || best.end > last) return false;
+    std::int64_t sum = 0;
+    for (std::size_t i = best.begin; i < best.end; ++i) sum += samples[i];
+    return sum == best.sum && best.sum == v4(window).sum;
+}
+
+int main( int argc, char* argv[] ) {
+    std::size_t n = argc > 1 ? std::atoll(argv[1]) : 100000000;
+    std::mt19937 gen{ 48 };
+
+    // 1. random streams
+    int failures = 0;
+    for (int trial = 0; trial < 200; ++trial) {
+        int bias = static_cast<int>(gen() % 21) - 10;
+        std::vector<int> samples;
+        Stream<int> stream;
+        std::vector<Window<int>> windows{ Window<int>{ 1 }, Window<int>{ 7 }, Window<int>{ 100 },
+                                          Window<int>{ 1 + gen() % 500 } };
+        for (int step = 0; step < 50; ++step) {
+            std::vector<int> chunk(gen() % (step % 5 == 0 ? 300 : 20));
+            for (int& x : chunk) x = static_cast<int>(gen() % 41) - 20 + bias;
+            samples.insert(samples.end(), chunk.begin(), chunk.end());
+
+            if (step % 2 == 0) stream.push(chunk.data(), chunk.size());
+            else for (int x : chunk) stream.push(x);
+            bool ok = stream.size() == samples.size() && check(samples, 0, samples.size(), stream.best());
+
+            for (Window<int>& window : windows) {
+                if (step % 3 == 0) window.push(chunk.data(), chunk.size());
+                else for (int x : chunk) window.push(x);
+                std::size_t first = samples.size() - window.size();
+                ok = ok && window.size() == std::min(samples.size(), window.width())
+                     && check(samples, first, samples.size(), window.best());
+            }
+            if (!ok) failures += 1;
+        }
+    }
+    std::cout << "1. 200 streams of 50 chunks: " << (failures == 0 ? "all agree" : "Oops!") << "\n";
+
+    // 2. throughput
+    std::vector<int> samples(n);
+    for (int& x : samples) x = static_cast<int>(gen() % 2001) - 1000;
+    std::cout << "2. N = " << n << "\n";
+
+    const std::size_t CHUNK = 4096;
+    auto report = [&]( const char* name, double ms, const Subsequence<std::int64_t>& best ) {
+        std::cout << "  " << name << "\t" << ms << " ms, " << n / (ms * 1e3) << " M samples/s, best "
+                  << best.sum << " in [" << best.begin << ", " << best.end << ")\n";
+    };
+
+    Stream<int> stream;
+    double t = millis([&]() { for (int x : samples) stream.push(x); });
+    report("stream, one at a time", t, stream.best());
+
+    Stream<int> chunked;
+    t = millis([&]() {
+        for (std::size_t i = 0; i < n; i += CHUNK) chunked.push(samples.data() + i, std::min(CHUNK, n - i));
+    });
+    report("stream, chunks\t", t, chunked.best());
+    if (chunked.best().sum != stream.best().sum) std::cout << "Oops! The stream sums differ.\n";
+
+    for (std::size_t width : { std::size_t(1000), std::size_t(1000000) }) {
+        Window<int> window{ width };
+        t = millis([&]() { for (int x : samples) window.push(x); });
+        std::cout << "  window of " << width << ":\n";
+        report("  one at a time", t, window.best());
+
+        Window<int> windowChunked{ width };
+        t = millis([&]() {
+            for (std::size_t i = 0; i < n; i += CHUNK) windowChunked.push(samples.data() + i, std::min(CHUNK, n - i));
+        });
+        report("  chunks\t", t, windowChunked.best());
+        if (n >= width && !check(samples, n - width, n, windowChunked.best())) {
+            std::cout << "Oops! Wrong window.\n";
+        }
+    }
+
+    return 0;
+}
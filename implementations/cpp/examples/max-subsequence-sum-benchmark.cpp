@@ -0,0 +1,106 @@
+#include "../lib/MaxSubsequenceSum.h"
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <climits>
+#include <cstdint>
+
+/*
+The maximum subsequence sum algorithms of lecture 3:
+  1. v1 to v4, blocked and parallel against each other on small random
+     arrays, and v3 to parallel on larger ones; every version must find
+     the same sum, and its bounds must hold a subsequence of that sum
+  2. ints near INT_MAX, whose sum no longer fits in the int of v1 and v2,
+     and 64-bit items near LLONG_MAX, summed in 128 bits
+  3. v3, v4, blocked and parallel on 1 to P threads over N random ints,
+     in millions of items per second
+Compile with -pthread, and with -O3 -march=native for the lanes of
+blocked to become vector instructions.
+*/
+
+using namespace MaxSubsequenceSum;
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// Check that best.sum is the sum of a[best.begin, best.end) and equals expected.
+template<typename T, typename Sum>
+bool check( const std::vector<T>& a, const Subsequence<Sum>& best, Sum expected ) {
+    if (best.begin > best.end || best.end > a.size()) return false;
+    Sum sum = 0;
+    for (std::size_t i = best.begin; i < best.end; ++i) sum += a[i];
+    return sum == best.sum && best.sum == expected;
+}
+
+int main( int argc, char* argv[] ) {
+    std::size_t n = argc > 1 ? std::atoll(argv[1]) : 100000000;
+    int maxThreads = argc > 2 ? std::atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::mt19937 gen{ 47 };
+    TaskScheduler scheduler{ maxThreads };
+
+    // 1. mostly negative, mixed and mostly positive arrays; every tenth
+    //    one is long enough for several groups of blocks in blocked
+    int failures = 0;
+    for (int trial = 0; trial < 3000; ++trial) {
+        bool small = trial % 10 != 0;
+        std::vector<int> a(gen() % (small ? 200 : 300000));
+        int bias = static_cast<int>(gen() % 21) - 10;
+        for (int& x : a) x = static_cast<int>(gen() % 41) - 20 + bias;
+
+        std::int64_t expected = v3(a).sum;
+        bool ok = !small || (MaxSubsequenceSum::v1(a) == expected && MaxSubsequenceSum::v2(a) == expected);
+        ok = ok && check(a, v3(a), expected) && check(a, v4(a), expected)
+             && check(a, blocked(a), expected) && check(a, parallel(a, scheduler), expected);
+        if (!ok) failures += 1;
+    }
+    std::cout << "1. 3000 arrays: " << (failures == 0 ? "all agree" : "Oops!") << "\n";
+
+    // 2. overflow
+    std::vector<int> big(1000, INT_MAX - static_cast<int>(gen() % 100));
+    std::int64_t exact = 0;
+    for (int x : big) exact += x;
+    std::cout << "2. 1000 x ~INT_MAX: " << exact << ", v4 gives " << v4(big).sum << "\n";
+    std::vector<long long> huge(20000, LLONG_MAX - 7);
+    __int128 hugeExact = static_cast<__int128>(LLONG_MAX - 7) * 20000;
+    if (v4(big).sum != exact || blocked(big).sum != exact || parallel(big, scheduler).sum != exact
+        || v4(huge).sum != hugeExact || blocked(huge).sum != hugeExact || v3(huge).sum != hugeExact) {
+        std::cout << "Oops! A wide accumulator overflowed.\n";
+    }
+
+    // 3. large arrays
+    std::vector<int> a(n);
+    for (int& x : a) x = static_cast<int>(gen() % 2001) - 1000;
+    std::cout << "3. N = " << n << "\n";
+
+    Subsequence<std::int64_t> expected;
+    double t = millis([&]() { expected = v4(a); });
+    std::cout << "  v4\t\t\t" << t << " ms, " << n / (t * 1e3) << " M items/s, sum " << expected.sum
+              << " in [" << expected.begin << ", " << expected.end << ")\n";
+
+    Subsequence<std::int64_t> result;
+    t = millis([&]() { result = v3(a); });
+    std::cout << "  v3\t\t\t" << t << " ms, " << n / (t * 1e3) << " M items/s"
+              << (check(a, result, expected.sum) ? "" : "\tOops!") << "\n";
+
+    t = millis([&]() { result = blocked(a); });
+    std::cout << "  blocked\t\t" << t << " ms, " << n / (t * 1e3) << " M items/s"
+              << (check(a, result, expected.sum) ? "" : "\tOops!") << "\n";
+
+    for (int p = 1; p <= maxThreads; p *= 2) {
+        TaskScheduler threads{ p };
+        t = millis([&]() { result = parallel(a, threads); });
+        std::cout << "  parallel, " << p << " threads\t" << t << " ms, " << n / (t * 1e3) << " M items/s"
+                  << (check(a, result, expected.sum) ? "" : "\tOops!") << "\n";
+    }
+
+    return 0;
+}
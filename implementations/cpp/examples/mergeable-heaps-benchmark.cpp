@@ -0,0 +1,88 @@
+#include "../lib/BinaryHeap.h"
+#include "../lib/LeftistHeap.h"
+#include "../lib/SkewHeap.h"
+#include "../lib/BinomialQueue.h"
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+
+/*
+Sharded work queues: items are spread over a number of shard heaps, which
+are periodically melded into one main heap that is then drained. Reports
+the time spent in insert, merge and deleteMin for each heap type.
+*/
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+template<typename Heap>
+void run( const std::string& name, const std::vector<int>& keys, int numShards, int rounds ) {
+    std::vector<Heap> shards(numShards);
+    Heap main{};
+    double insertTime = 0, mergeTime = 0, deleteTime = 0;
+    bool ok = true;
+
+    size_t perRound = keys.size() / rounds;
+    for (int r = 0; r < rounds; ++r) {
+        insertTime += millis([&]() {
+            for (size_t i = r * perRound; i < (r + 1) * perRound; ++i) {
+                shards[i % numShards].insert(keys[i]);
+            }
+        });
+
+        mergeTime += millis([&]() {
+            for (auto& shard : shards) {
+                main.merge(shard);
+            }
+        });
+
+        // drain half of the main heap before the next round arrives
+        deleteTime += millis([&]() {
+            int previous = -1, x;
+            for (size_t i = 0; i < perRound / 2; ++i) {
+                main.deleteMin(x);
+                ok = ok && previous <= x;
+                previous = x;
+            }
+        });
+    }
+
+    deleteTime += millis([&]() {
+        int previous = -1, x;
+        while (!main.isEmpty()) {
+            main.deleteMin(x);
+            ok = ok && previous <= x;
+            previous = x;
+        }
+    });
+
+    std::cout << name << "\t" << insertTime << "\t" << mergeTime << "\t" << deleteTime
+              << (ok ? "" : "\tOops! Items came out of order.") << "\n";
+}
+
+int main( int argc, char* argv[] ) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int numShards = argc > 2 ? std::atoi(argv[2]) : 64;
+    int rounds = 100;
+
+    std::mt19937 gen{ 335 };
+    std::vector<int> keys(n);
+    for (auto& k : keys) k = static_cast<int>(gen() % 1000000000);
+
+    std::cout << "heap\t\tinsert\tmerge\tdeleteMin   (ms, n = " << n << ", " << numShards
+              << " shards, " << rounds << " melds)\n";
+    run<BinaryHeap<int>>("BinaryHeap", keys, numShards, rounds);
+    run<LeftistHeap<int>>("LeftistHeap", keys, numShards, rounds);
+    run<SkewHeap<int>>("SkewHeap", keys, numShards, rounds);
+    run<BinomialQueue<int>>("BinomialQueue", keys, numShards, rounds);
+
+    return 0;
+}
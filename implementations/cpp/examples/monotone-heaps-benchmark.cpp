@@ -0,0 +1,106 @@
+#include "../lib/BinaryHeap.h"
+#include "../lib/PairingHeap.h"
+#include "../lib/RadixHeap.h"
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+
+/*
+BinaryHeap, PairingHeap and RadixHeap on integer keys:
+  pattern: the insert/deleteMin pattern of examples/binary-heap.cpp with
+           the key i instead of the string "hello" + i
+  timers:  a hold model where every deleted timer is rescheduled a random
+           delay after the current time, so keys are monotone
+*/
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+template<typename Heap>
+bool pattern( unsigned int maxItem ) {
+    const unsigned int minItem = maxItem / 10;
+    Heap h{};
+
+    for (unsigned int i = 37; i != 0; i = (i + 37) % maxItem) {
+        if (i >= minItem) {
+            h.insert(i);
+        }
+    }
+
+    bool ok = true;
+    unsigned int x;
+    for (unsigned int i = minItem; i < maxItem; ++i) {
+        h.deleteMin(x);
+        ok = ok && x == i;
+    }
+    return ok && h.isEmpty();
+}
+
+template<typename Heap>
+unsigned long long timers( int numTimers, int rounds ) {
+    std::mt19937 gen{ 7 };
+    Heap h{};
+    for (int i = 0; i < numTimers; ++i) {
+        h.insert(gen() % 100000);
+    }
+
+    unsigned long long checksum = 0;
+    unsigned int now;
+    for (int r = 0; r < rounds; ++r) {
+        h.deleteMin(now);
+        checksum += now;
+        h.insert(now + 1 + gen() % 100000);
+    }
+    return checksum;
+}
+
+template<typename Heap>
+void run( const std::string& name, unsigned int maxItem, int numTimers, int rounds,
+          unsigned long long& expected ) {
+    bool ok = true;
+    unsigned long long checksum = 0;
+    double tp = millis([&]() { ok = pattern<Heap>(maxItem); });
+    double tt = millis([&]() { checksum = timers<Heap>(numTimers, rounds); });
+
+    if (expected == 0) expected = checksum;
+    ok = ok && checksum == expected;
+
+    std::cout << name << "\t" << tp << "\t" << tt << (ok ? "" : "\tOops!") << "\n";
+}
+
+int main( int argc, char* argv[] ) {
+    unsigned int maxItem = argc > 1 ? std::atoi(argv[1]) : 9999991; // prime, so i + 37 cycles
+    int numTimers = 100000;
+    int rounds = 5000000;
+
+    unsigned long long expected = 0;
+    std::cout << "heap\t\tpattern\ttimers   (ms)\n";
+    run<BinaryHeap<unsigned int>>("BinaryHeap", maxItem, numTimers, rounds, expected);
+    run<PairingHeap<unsigned int>>("PairingHeap", maxItem, numTimers, rounds, expected);
+    run<RadixHeap<unsigned int>>("RadixHeap", maxItem, numTimers, rounds, expected);
+
+    // decreaseKey moves an item to the front of a pairing heap
+    PairingHeap<int> p{};
+    std::vector<PairingHeap<int>::Position> positions;
+    for (int i = 0; i < 100; ++i) positions.push_back(p.insert(1000 + i));
+    p.deleteMin();
+    p.decreaseKey(positions[50], 3);
+    p.decreaseKey(positions[99], 2);
+    int a, b, c;
+    p.deleteMin(a);
+    p.deleteMin(b);
+    p.deleteMin(c);
+    if (a != 2 || b != 3 || c != 1001 || p.size() != 96) {
+        std::cout << "Oops! PairingHeap::decreaseKey misordered the heap.\n";
+    }
+
+    return 0;
+}
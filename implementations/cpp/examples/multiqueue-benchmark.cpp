@@ -0,0 +1,130 @@
+#include "../lib/MultiQueue.h"
+#include "../lib/AVLTree.h"
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+
+/*
+Throughput and quality of the relaxed MultiQueue against a single locked
+BinaryHeap. Each thread alternates insert and deleteMin on a prefilled
+queue. Quality is the rank error of every deleteMin: how many smaller keys
+were in the queue at that moment. It is computed afterwards by replaying
+the operations in the order they completed against an AVLTree with order
+statistics. Compile with -pthread.
+*/
+
+using Key = std::uint64_t;
+
+struct Operation {
+    std::uint64_t ticket; // completion order
+    bool isInsert;
+    Key key;
+};
+
+// unique keys: random high bits, thread id and a per-thread counter below
+Key makeKey( std::mt19937& gen, int thread, std::uint64_t& counter ) {
+    return (static_cast<Key>(gen() % (1u << 30)) << 32) | (static_cast<Key>(thread) << 24) | counter++;
+}
+
+template<typename Queue>
+double run( Queue& queue, int numThreads, int opsPerThread, const std::vector<Key>& prefill,
+            std::vector<std::vector<Operation>>* log ) {
+    for (Key k : prefill) queue.insert(k);
+
+    std::atomic<std::uint64_t> tickets{ 0 };
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 gen{ static_cast<unsigned>(1000 + t) };
+            std::uint64_t counter = 0;
+            Key k;
+            for (int i = 0; i < opsPerThread; ++i) {
+                bool isInsert = i % 2 == 0;
+                if (isInsert) {
+                    k = makeKey(gen, t + 1, counter);
+                    queue.insert(k);
+                }
+                else if (!queue.deleteMin(k)) {
+                    continue;
+                }
+                if (log != nullptr) {
+                    (*log)[t].push_back(Operation{ tickets.fetch_add(1), isInsert, k });
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    auto stop = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    return numThreads * static_cast<double>(opsPerThread) / seconds / 1e6;
+}
+
+void rankError( const std::vector<Key>& prefill, std::vector<std::vector<Operation>>& log,
+                double& mean, int& worst ) {
+    std::vector<Operation> all;
+    for (auto& ops : log) all.insert(all.end(), ops.begin(), ops.end());
+    std::sort(all.begin(), all.end(), []( const Operation& a, const Operation& b ) {
+        return a.ticket < b.ticket;
+    });
+
+    AVLTree<Key, true> present{};
+    for (Key k : prefill) present.insert(k);
+
+    long long total = 0, deletes = 0;
+    worst = 0;
+    for (const Operation& op : all) {
+        if (op.isInsert) {
+            present.insert(op.key);
+        }
+        else {
+            int rank = present.rank(op.key);
+            present.remove(op.key);
+            total += rank;
+            deletes += 1;
+            worst = std::max(worst, rank);
+        }
+    }
+    mean = deletes == 0 ? 0 : static_cast<double>(total) / deletes;
+}
+
+int main( int argc, char* argv[] ) {
+    int maxThreads = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(std::thread::hardware_concurrency());
+    int opsPerThread = argc > 2 ? std::atoi(argv[2]) : 1000000;
+    int prefillSize = 1000000;
+
+    std::mt19937 gen{ 335 };
+    std::uint64_t counter = 0;
+    std::vector<Key> prefill(prefillSize);
+    for (auto& k : prefill) k = makeKey(gen, 0, counter);
+
+    std::cout << "threads\tlocked Mops/s\tmultiqueue Mops/s\tmean rank error\tmax rank error\n";
+    for (int p = 1; p <= maxThreads; p *= 2) {
+        LockedBinaryHeap<Key> locked{};
+        double lockedThroughput = run(locked, p, opsPerThread, prefill, nullptr);
+
+        MultiQueue<Key> mq{ p };
+        double mqThroughput = run(mq, p, opsPerThread, prefill, nullptr);
+
+        // separate, shorter run with logging for the quality measurement
+        MultiQueue<Key> logged{ p };
+        std::vector<std::vector<Operation>> log(p);
+        run(logged, p, std::min(opsPerThread, 100000), prefill, &log);
+        double mean;
+        int worst;
+        rankError(prefill, log, mean, worst);
+
+        std::cout << p << "\t" << lockedThroughput << "\t\t" << mqThroughput << "\t\t\t"
+                  << mean << "\t\t" << worst << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "../lib/ParallelBfs.h"
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+/*
+Breadth-first search on an R-MAT graph (Chakrabarti, Zhan and Faloutsos),
+the synthetic power-law graph of the Graph500 benchmark: each edge picks
+one quadrant of the adjacency matrix with probabilities a, b, c, d =
+0.57, 0.19, 0.19, 0.05, recursively, scale times. Every edge is added in
+both directions, so the graph is its own transpose. Compares unweighted of
+Graph.h with parallelUnweighted on 1 to P threads, in millions of
+traversed edges per second (the edges inside the component of the
+source). Compile with -pthread.
+*/
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+Graph<> makeRmat( int scale, int edgeFactor ) {
+    std::mt19937_64 gen{ 43 };
+    std::uniform_real_distribution<double> uniform{ 0.0, 1.0 };
+    int n = 1 << scale;
+    std::int64_t m = static_cast<std::int64_t>(edgeFactor) * n;
+
+    // shuffle the ids so the hubs are not the smallest ones
+    std::vector<Vertex> id(n);
+    for (Vertex v = 0; v < n; ++v) id[v] = v;
+    std::shuffle(id.begin(), id.end(), gen);
+
+    GraphBuilder<> builder{ n };
+    builder.reserve(2 * m);
+    for (std::int64_t i = 0; i < m; ++i) {
+        Vertex from = 0, to = 0;
+        for (int bit = 0; bit < scale; ++bit) {
+            double r = uniform(gen);
+            int row = r >= 0.57 + 0.19;          // quadrants c and d
+            int column = (r >= 0.57 && r < 0.57 + 0.19) || r >= 0.57 + 0.19 + 0.19;
+            from = 2 * from + row;
+            to = 2 * to + column;
+        }
+        builder.addEdge(id[from], id[to]);
+        builder.addEdge(id[to], id[from]);
+    }
+    return builder.build();
+}
+
+int main( int argc, char* argv[] ) {
+    int scale = argc > 1 ? std::atoi(argv[1]) : 22;
+    int edgeFactor = argc > 2 ? std::atoi(argv[2]) : 16;
+    int maxThreads = argc > 3 ? std::atoi(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+    const int SOURCES = 4;
+
+    Graph<> g = makeRmat(scale, edgeFactor);
+    std::cout << "R-MAT scale " << scale << ": " << g.numVertices() << " vertices, "
+              << g.numEdges() << " directed edges\n";
+
+    // sources of nonzero degree, with their sequential results
+    std::mt19937 gen{ 43 };
+    std::vector<Vertex> sources;
+    while (static_cast<int>(sources.size()) < SOURCES) {
+        Vertex s = static_cast<Vertex>(gen() % g.numVertices());
+        if (g.outDegree(s) > 0) sources.push_back(s);
+    }
+
+    std::vector<ShortestPaths<int>> expected(SOURCES);
+    std::vector<std::int64_t> traversed(SOURCES, 0);
+    double tSequential = 0;
+    for (int i = 0; i < SOURCES; ++i) {
+        tSequential += millis([&]() { expected[i] = unweighted(g, sources[i]); });
+        for (Vertex v = 0; v < g.numVertices(); ++v) {
+            if (expected[i].dist[v] != ShortestPaths<int>::INFINITY_DISTANCE) traversed[i] += g.outDegree(v);
+        }
+    }
+    std::int64_t totalEdges = 0;
+    for (std::int64_t t : traversed) totalEdges += t;
+
+    std::cout << "  unweighted\t\t" << tSequential / SOURCES << " ms, "
+              << totalEdges / (tSequential * 1e3) << " M edges/s\n";
+
+    for (int p = 1; p <= maxThreads; p *= 2) {
+        TaskScheduler scheduler{ p };
+        bool ok = true;
+        double t = 0;
+        for (int i = 0; i < SOURCES; ++i) {
+            ShortestPaths<int> sp;
+            t += millis([&]() { sp = parallelUnweighted(g, g, sources[i], scheduler); });
+
+            // same distances, and each parent is a neighbour one level closer
+            ok = ok && sp.dist == expected[i].dist;
+            for (Vertex v = 0; ok && v < g.numVertices(); ++v) {
+                Vertex u = sp.path[v];
+                if (u == NOT_A_VERTEX) continue;
+                auto adj = g.adjacent(u);
+                ok = sp.dist[u] == sp.dist[v] - 1 && std::find(adj.begin(), adj.end(), v) != adj.end();
+            }
+        }
+        std::cout << "  parallel, " << p << " threads\t" << t / SOURCES << " ms, "
+                  << totalEdges / (t * 1e3) << " M edges/s" << (ok ? "" : "\tOops!") << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "../lib/ParallelSort.h"
+#include "../lib/SortingNetwork.h"
+#include "../lib/Sorting.h"
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+#include <cmath>
+
+/*
+Scaling of parallelMergeSort and parallelSampleSort from 1 to P threads on
+random ints, against std::sort and the single-threaded introSort and
+mergeSort of lib/Sorting.h. Also compares the sorting-network mergesort of
+lib/SortingNetwork.h with mergeSort on ints and floats, checks that it keeps
+both -0 and +0 of a float input, and runs parallelSampleSort on inputs with
+few distinct keys, which go to buckets of equal keys. Compile with -pthread,
+and with -mavx2 (or -march=native) for the vectorized network.
+*/
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+template<typename T, typename Sort>
+void measure( const char* name, const std::vector<T>& input, const std::vector<T>& expected, Sort sort ) {
+    std::vector<T> v = input;
+    double ms = millis([&]() { sort(v); });
+    std::cout << "  " << name << "\t" << ms << " ms" << (v == expected ? "" : "\tOops!") << "\n";
+}
+
+int main( int argc, char* argv[] ) {
+    std::ptrdiff_t n = argc > 1 ? std::atoll(argv[1]) : 20000000;
+    int maxThreads = argc > 2 ? std::atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::mt19937 gen{ 39 };
+    std::vector<int> input(n);
+    for (auto& x : input) x = static_cast<int>(gen());
+    std::vector<int> expected = input;
+    std::sort(expected.begin(), expected.end());
+
+    std::cout << "1. single thread, N = " << n << "\n";
+    measure("std::sort\t", input, expected, []( std::vector<int>& v ) { std::sort(v.begin(), v.end()); });
+    measure("introSort\t", input, expected, []( std::vector<int>& v ) { introSort(v.begin(), v.end()); });
+    measure("mergeSort\t", input, expected, []( std::vector<int>& v ) { mergeSort(v.begin(), v.end()); });
+    measure("networkSort\t", input, expected, []( std::vector<int>& v ) { networkSort(v.data(), v.data() + v.size()); });
+
+    std::vector<float> floats(n);
+    for (auto& x : floats) x = std::uniform_real_distribution<float>{ -1e6f, 1e6f }(gen);
+    std::vector<float> sortedFloats = floats;
+    std::sort(sortedFloats.begin(), sortedFloats.end());
+    measure("mergeSort<float>", floats, sortedFloats, []( std::vector<float>& v ) { mergeSort(v.begin(), v.end()); });
+    measure("networkSort<float>", floats, sortedFloats, []( std::vector<float>& v ) { networkSort(v.data(), v.data() + v.size()); });
+
+    // -0 and +0 compare equal; sorting must keep 32 of each, not copy one over the other
+    std::vector<float> zeros(64);
+    for (int i = 0; i < 64; ++i) zeros[i] = i % 2 == 0 ? -0.0f : 0.0f;
+    std::vector<float> network = zeros;
+    sortingNetwork64(network.data());
+    std::vector<float> large(4096);
+    for (std::size_t i = 0; i < large.size(); ++i) large[i] = gen() % 2 == 0 ? -0.0f : 0.0f;
+    auto negatives = []( const std::vector<float>& v ) {
+        return std::count_if(v.begin(), v.end(), []( float x ) { return std::signbit(x); });
+    };
+    std::ptrdiff_t largeNegatives = negatives(large);
+    networkSort(large.data(), large.data() + large.size());
+    if (negatives(network) != 32 || negatives(large) != largeNegatives) {
+        std::cout << "Oops! networkSort lost a signed zero.\n";
+    }
+
+    std::cout << "2. threads\tparallelMergeSort ms\tparallelSampleSort ms\n";
+    for (int p = 1; p <= maxThreads; p *= 2) {
+        TaskScheduler scheduler{ p };
+
+        std::vector<int> a = input;
+        double tMerge = millis([&]() { parallelMergeSort(a.begin(), a.end(), scheduler); });
+        std::vector<int> b = input;
+        double tSample = millis([&]() { parallelSampleSort(b.begin(), b.end(), scheduler); });
+
+        std::cout << "   " << p << "\t\t" << tMerge << "\t\t\t" << tSample
+                  << (a == expected && b == expected ? "" : "\tOops!") << "\n";
+    }
+
+    // at least two threads, or parallelSampleSort falls back to introSort
+    TaskScheduler scheduler{ std::max(2, maxThreads) };
+    std::cout << "3. few distinct keys, " << scheduler.numThreads() << " threads\tstd::sort ms\tparallelSampleSort ms\n";
+    for (int distinct : { 1, 4, 1000 }) {
+        std::vector<int> few(n);
+        for (auto& x : few) x = static_cast<int>(gen() % distinct);
+        std::vector<int> a = few, b = few;
+        double tStd = millis([&]() { std::sort(a.begin(), a.end()); });
+        double tSample = millis([&]() { parallelSampleSort(b.begin(), b.end(), scheduler); });
+        std::cout << "   " << distinct << " distinct\t\t" << tStd << "\t\t" << tSample
+                  << (a == b ? "" : "\tOops!") << "\n";
+    }
+
+    // parallelMergeSort is stable: sort (key, position) pairs on the key only
+    std::vector<std::pair<int, int>> pairs(n < 1000000 ? n : 1000000);
+    for (size_t i = 0; i < pairs.size(); ++i) pairs[i] = { static_cast<int>(gen() % 100), static_cast<int>(i) };
+    parallelMergeSort(pairs.begin(), pairs.end(), scheduler,
+                      []( const std::pair<int, int>& x, const std::pair<int, int>& y ) { return x.first < y.first; });
+    if (!std::is_sorted(pairs.begin(), pairs.end())) {
+        std::cout << "Oops! parallelMergeSort is not stable.\n";
+    }
+
+    return 0;
+}
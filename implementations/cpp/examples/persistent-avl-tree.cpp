@@ -0,0 +1,64 @@
+#include "../lib/PersistentAVLTree.h"
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+// Compile with -pthread.
+int main() {
+    PersistentAVLTree<int> avl{};
+
+    std::vector<int> items = {6, 2, 8, 1, 4, 3};
+    for (auto item : items) {
+        avl.insert(item);
+    }
+
+    auto before = avl.snapshot();
+    avl.remove(4);
+    avl.insert(10);
+
+    std::cout << "1. Snapshot taken before the updates: ";
+    before.printTree();
+    std::cout << "2. Current version: ";
+    avl.printTree();
+
+    PersistentAVLTree<int> copy = avl; // O(1), shares every node
+    copy.insert(5);
+    if (!avl.contains(5) && copy.contains(5)) {
+        std::cout << "3. Updating a copy leaves the original untouched.\n";
+    }
+
+    // One writer inserts 0..N-1 in order while readers check that every
+    // snapshot holds a prefix of that sequence.
+    const int N = 100000;
+    PersistentAVLTree<int> shared{};
+    std::atomic<bool> done{ false };
+    std::atomic<int> errors{ 0 };
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                auto snap = shared.snapshot();
+                if (snap.isEmpty()) continue;
+                int largest = snap.findMax();
+                if (snap.findMin() != 0 || !snap.contains(largest / 2)) {
+                    errors += 1;
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < N; ++i) {
+        shared.insert(i);
+    }
+    done = true;
+    for (auto& t : readers) t.join();
+
+    if (errors == 0 && shared.findMax() == N - 1) {
+        std::cout << "4. Readers saw consistent snapshots while the writer ran.\n";
+    }
+
+    return 0;
+}
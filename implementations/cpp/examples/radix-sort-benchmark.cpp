@@ -0,0 +1,109 @@
+#include "../lib/RadixSort.h"
+#include "../lib/ExternalSort.h"
+#include "../lib/Sorting.h"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+
+/*
+Radix sorts against comparison sorts, and an external sort of a log file:
+  1.-2. radixSort against std::sort and introSort on 32-bit unsigned and
+        64-bit signed keys
+  3.    americanFlagSort against std::sort on log lines that share long
+        prefixes (timestamps and host names)
+  4.    ExternalSorter on a log file with a memory budget of a fraction of
+        its size, checked against sorting it in memory
+*/
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+template<typename T>
+void compareIntegers( const char* name, const std::vector<T>& input ) {
+    std::vector<T> a = input, b = input, c = input;
+    double tStd = millis([&]() { std::sort(a.begin(), a.end()); });
+    double tIntro = millis([&]() { introSort(b.begin(), b.end()); });
+    double tRadix = millis([&]() { radixSort(c.begin(), c.end()); });
+
+    std::cout << name << ": std::sort " << tStd << " ms, introSort " << tIntro
+              << " ms, radixSort " << tRadix << " ms\n";
+    if (a != b || a != c) std::cout << "Oops! " << name << " keys are misordered.\n";
+}
+
+std::vector<std::string> makeLogLines( int n ) {
+    std::mt19937 gen{ 40 };
+    const char* levels[] = { "INFO", "WARN", "ERROR", "DEBUG" };
+    std::vector<std::string> lines;
+    lines.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        int second = static_cast<int>(gen() % 86400);
+        char stamp[32];
+        std::snprintf(stamp, sizeof(stamp), "2024-05-17T%02d:%02d:%02d.%03u",
+                      second / 3600, second / 60 % 60, second % 60, static_cast<unsigned>(gen() % 1000));
+        lines.push_back(std::string(stamp) + " host-" + std::to_string(gen() % 16) + ".cluster.local "
+                        + levels[gen() % 4] + " request " + std::to_string(gen()) + " done");
+    }
+    return lines;
+}
+
+int main( int argc, char* argv[] ) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    int numLines = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+    std::mt19937_64 gen{ 40 };
+    std::vector<std::uint32_t> u32(n);
+    for (auto& x : u32) x = static_cast<std::uint32_t>(gen());
+    compareIntegers("1. uint32_t", u32);
+
+    std::vector<std::int64_t> i64(n);
+    for (auto& x : i64) x = static_cast<std::int64_t>(gen() >> (gen() % 64)) * (gen() % 2 ? 1 : -1);
+    compareIntegers("2. int64_t", i64);
+
+    std::vector<std::string> lines = makeLogLines(numLines);
+    std::vector<std::string> a = lines, b = lines;
+    double tStd = millis([&]() { std::sort(a.begin(), a.end()); });
+    double tFlag = millis([&]() { americanFlagSort(b.begin(), b.end()); });
+    std::cout << "3. " << numLines << " log lines: std::sort " << tStd
+              << " ms, americanFlagSort " << tFlag << " ms\n";
+    if (a != b) std::cout << "Oops! americanFlagSort misordered the lines.\n";
+
+    auto dir = std::filesystem::temp_directory_path();
+    std::string inputPath = (dir / "radix-sort-benchmark-input.log").string();
+    std::string outputPath = (dir / "radix-sort-benchmark-output.log").string();
+    std::size_t fileBytes = 0;
+    {
+        std::ofstream out{ inputPath };
+        for (const auto& line : lines) {
+            out << line << '\n';
+            fileBytes += line.size() + 1;
+        }
+    }
+
+    // a budget of 1/50 of the file and a fan-in of 8 force several merge passes
+    ExternalSorter sorter{ fileBytes / 50, 8 };
+    double tExternal = millis([&]() { sorter.sort(inputPath, outputPath); });
+    std::cout << "4. external sort of " << fileBytes / 1024 << " KiB: " << tExternal << " ms, "
+              << sorter.numRuns() << " runs, " << sorter.numMergePasses() << " merge passes\n";
+
+    std::ifstream in{ outputPath };
+    std::vector<std::string> sorted;
+    for (std::string line; std::getline(in, line); ) sorted.push_back(line);
+    if (sorted != a) std::cout << "Oops! The external sort output is wrong.\n";
+
+    std::filesystem::remove(inputPath);
+    std::filesystem::remove(outputPath);
+
+    return 0;
+}
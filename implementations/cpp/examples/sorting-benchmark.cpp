@@ -0,0 +1,133 @@
+#include "../lib/Sorting.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+
+/*
+Comparisons, moves and running time of the sorts in lib/Sorting.h and of
+std::sort and std::stable_sort on four inputs: random, sorted, reversed and
+few unique (ten distinct keys). Comparisons and moves are counted with an
+instrumented key type; times are for plain ints.
+*/
+
+struct Counted {
+    static long long comparisons;
+    static long long moves;
+
+    int key = 0;
+
+    Counted() = default;
+    explicit Counted( int k ) : key{ k } {}
+    Counted( const Counted& rhs ) : key{ rhs.key } { ++moves; }
+    Counted( Counted&& rhs ) : key{ rhs.key } { ++moves; }
+    Counted& operator=( const Counted& rhs ) { key = rhs.key; ++moves; return *this; }
+    Counted& operator=( Counted&& rhs ) { key = rhs.key; ++moves; return *this; }
+
+    bool operator<( const Counted& rhs ) const { ++comparisons; return key < rhs.key; }
+};
+
+long long Counted::comparisons = 0;
+long long Counted::moves = 0;
+
+std::vector<int> makeInput( const std::string& kind, int n ) {
+    std::mt19937 gen{ 15 };
+    std::vector<int> v(n);
+    for (int i = 0; i < n; ++i) {
+        if      (kind == "random")   { v[i] = static_cast<int>(gen()); }
+        else if (kind == "sorted")   { v[i] = i; }
+        else if (kind == "reversed") { v[i] = n - i; }
+        else                         { v[i] = static_cast<int>(gen() % 10); }
+    }
+    return v;
+}
+
+struct Algorithm {
+    std::string name;
+    std::function<void(std::vector<int>&)> sortInts;
+    std::function<void(std::vector<Counted>&)> sortCounted;
+    bool quadratic;
+};
+
+template<typename Sort>
+Algorithm makeAlgorithm( const std::string& name, Sort sort, bool quadratic = false ) {
+    return Algorithm{
+        name,
+        [sort]( std::vector<int>& v ) { sort(v.begin(), v.end()); },
+        [sort]( std::vector<Counted>& v ) { sort(v.begin(), v.end()); },
+        quadratic
+    };
+}
+
+int main( int argc, char* argv[] ) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int quadraticMax = 20000; // larger inputs are skipped for O(N^2) sorts
+
+    std::vector<std::ptrdiff_t> shell = shellGaps(n);
+    std::vector<std::ptrdiff_t> hibbard = hibbardGaps(n);
+    std::vector<std::ptrdiff_t> sedgewick = sedgewickGaps(n);
+
+    // one buffer for every mergeSort call of a type
+    std::vector<int> intBuffer;
+    std::vector<Counted> countedBuffer;
+
+    std::vector<Algorithm> algorithms{
+        makeAlgorithm("insertionSort", []( auto b, auto e ) { insertionSort(b, e); }, true),
+        makeAlgorithm("shell/Shell", [&]( auto b, auto e ) { shellsort(b, e, shell); }),
+        makeAlgorithm("shell/Hibbard", [&]( auto b, auto e ) { shellsort(b, e, hibbard); }),
+        makeAlgorithm("shell/Sedgewick", [&]( auto b, auto e ) { shellsort(b, e, sedgewick); }),
+        makeAlgorithm("shell/Ciura", []( auto b, auto e ) { shellsort(b, e); }),
+        makeAlgorithm("heapsort", []( auto b, auto e ) { heapsort(b, e); }),
+        Algorithm{
+            "mergeSort",
+            [&]( std::vector<int>& v ) { mergeSort(v.begin(), v.end(), intBuffer); },
+            [&]( std::vector<Counted>& v ) { mergeSort(v.begin(), v.end(), countedBuffer); },
+            false
+        },
+        makeAlgorithm("introSort", []( auto b, auto e ) { introSort(b, e); }),
+        makeAlgorithm("std::sort", []( auto b, auto e ) { std::sort(b, e); }),
+        makeAlgorithm("std::stable_sort", []( auto b, auto e ) { std::stable_sort(b, e); }),
+    };
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (std::string kind : { "random", "sorted", "reversed", "few unique" }) {
+        std::vector<int> input = makeInput(kind, n);
+        std::vector<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+
+        std::cout << kind << " (N = " << n << ")\n";
+        std::cout << "  algorithm\t\tcomparisons/N\tmoves/N\t\tms\n";
+        for (const Algorithm& a : algorithms) {
+            if (a.quadratic && n > quadraticMax) continue;
+
+            std::vector<Counted> counted;
+            for (int x : input) counted.emplace_back(x);
+            Counted::comparisons = 0;
+            Counted::moves = 0;
+            a.sortCounted(counted);
+            long long comparisons = Counted::comparisons;
+            long long moves = Counted::moves;
+
+            std::vector<int> ints = input;
+            auto start = std::chrono::steady_clock::now();
+            a.sortInts(ints);
+            auto stop = std::chrono::steady_clock::now();
+            double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+
+            bool ok = ints == expected;
+            for (int i = 0; ok && i < n; ++i) ok = counted[i].key == expected[i];
+
+            std::cout << "  " << std::left << std::setw(16) << a.name << std::right << "\t"
+                      << static_cast<double>(comparisons) / n << "\t\t"
+                      << static_cast<double>(moves) / n << "\t\t" << ms
+                      << (ok ? "" : "\tOops!") << "\n";
+        }
+    }
+
+    return 0;
+}
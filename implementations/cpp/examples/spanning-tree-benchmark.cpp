@@ -0,0 +1,97 @@
+#include "../lib/SpanningTree.h"
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+
+/*
+Minimum spanning forests with kruskal, prim, boruvka and filterKruskal:
+  1. small random graphs, some disconnected and with many tied weights:
+     all four forests must have the same weight and edge count, and be
+     forests
+  2. a random graph of N vertices and M undirected edges (10M by default)
+     with int weights: prim, and the others on 1 to P threads
+Compile with -pthread.
+*/
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+Graph<int> makeGraph( int n, long long m, int maxWeight, std::mt19937_64& gen ) {
+    GraphBuilder<int> builder{ n };
+    builder.reserve(2 * m);
+    for (long long i = 0; i < m; ++i) {
+        Vertex u = static_cast<Vertex>(gen() % n), v = static_cast<Vertex>(gen() % n);
+        int w = 1 + static_cast<int>(gen() % maxWeight);
+        builder.addEdge(u, v, w);
+        builder.addEdge(v, u, w);
+    }
+    return builder.build();
+}
+
+// Check that forest has no cycle.
+bool isForest( int n, const std::vector<WeightedEdge<int>>& forest ) {
+    DisjointSets sets{ n };
+    for (const auto& e : forest) {
+        if (!sets.unite(e.from, e.to)) return false;
+    }
+    return true;
+}
+
+int main( int argc, char* argv[] ) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    long long m = argc > 2 ? std::atoll(argv[2]) : 10000000;
+    int maxThreads = argc > 3 ? std::atoi(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::mt19937_64 gen{ 46 };
+    TaskScheduler scheduler{ maxThreads };
+
+    // 1. small graphs
+    int failures = 0;
+    for (int trial = 0; trial < 300; ++trial) {
+        int size = 1 + static_cast<int>(gen() % 2000);
+        Graph<int> g = makeGraph(size, static_cast<long long>(gen() % (3 * size)), 1 + static_cast<int>(gen() % 50), gen);
+        auto a = prim(g);
+        auto b = kruskal(g, scheduler);
+        auto c = boruvka(g, scheduler);
+        auto d = filterKruskal(g, scheduler);
+        bool ok = isForest(size, a) && isForest(size, b) && isForest(size, c) && isForest(size, d)
+                  && a.size() == b.size() && a.size() == c.size() && a.size() == d.size()
+                  && totalWeight(a) == totalWeight(b) && totalWeight(a) == totalWeight(c)
+                  && totalWeight(a) == totalWeight(d);
+        if (!ok) failures += 1;
+    }
+    std::cout << "1. 300 small graphs: " << (failures == 0 ? "all agree" : "Oops!") << "\n";
+
+    // 2. a large graph; the filter of filterKruskal pays off when M >> N
+    Graph<int> g = makeGraph(n, m, 1000000, gen);
+    std::cout << "2. N = " << n << ", M = " << m << "\n";
+
+    std::vector<WeightedEdge<int>> expected;
+    double t = millis([&]() { expected = prim(g); });
+    long long weight = totalWeight(expected);
+    std::cout << "  prim\t\t\t" << t << " ms, " << expected.size() << " edges, weight " << weight << "\n";
+
+    for (int p = 1; p <= maxThreads; p *= 2) {
+        TaskScheduler threads{ p };
+        auto measure = [&]( const char* name, std::vector<WeightedEdge<int>> (*mst)( const Graph<int>&, TaskScheduler& ) ) {
+            std::vector<WeightedEdge<int>> forest;
+            double ms = millis([&]() { forest = mst(g, threads); });
+            long long w = totalWeight(forest);
+            std::cout << "  " << name << ", " << p << " threads\t" << ms << " ms"
+                      << (w == weight && forest.size() == expected.size() ? "" : "\tOops!") << "\n";
+        };
+        measure("kruskal", kruskal<int>);
+        measure("boruvka", boruvka<int>);
+        measure("filterKruskal", filterKruskal<int>);
+    }
+
+    return 0;
+}
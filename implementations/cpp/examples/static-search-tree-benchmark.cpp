@@ -0,0 +1,78 @@
+#include "../lib/StaticSearchTree.h"
+#include "../lib/BinarySearch.h"
+#include "../lib/AVLTree.h"
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+
+/*
+Compare membership queries against sorted ints for the Eytzinger and van Emde
+Boas layouts, binarySearch and AVLTree::contains. Sizes go from 2^10 up to
+2^maxLog, where maxLog is the first argument (default 22; 30 is about one
+billion items and needs several GB of memory). The AVL tree is skipped above
+2^avlMaxLog (second argument, default 22) because of its per-node overhead.
+*/
+
+template<typename Function>
+double nsPerQuery( const std::vector<int>& queries, Function f, long long& found ) {
+    auto start = std::chrono::steady_clock::now();
+    long long hits = 0;
+    for (int q : queries) {
+        hits += f(q);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    found = hits;
+    return std::chrono::duration<double, std::nano>(stop - start).count() / queries.size();
+}
+
+int main( int argc, char* argv[] ) {
+    int maxLog = argc > 1 ? std::atoi(argv[1]) : 22;
+    int avlMaxLog = argc > 2 ? std::atoi(argv[2]) : 22;
+    const size_t numQueries = 1 << 20;
+
+    std::mt19937 gen{ 335 };
+
+    std::cout << "n\teytzinger\tveb\tbinarySearch\tavl   (ns/query)\n";
+
+    for (int lg = 10; lg <= maxLog; lg += 2) {
+        size_t n = size_t{ 1 } << lg;
+
+        // even numbers only, so about half of the queries miss
+        std::vector<int> sorted(n);
+        for (size_t i = 0; i < n; ++i) sorted[i] = 2 * static_cast<int>(i);
+
+        std::uniform_int_distribution<int> dist(0, 2 * static_cast<int>(n));
+        std::vector<int> queries(numQueries);
+        for (auto& q : queries) q = dist(gen);
+
+        EytzingerSearchTree<int> eytzinger{ sorted };
+        VanEmdeBoasSearchTree<int> veb{ sorted };
+
+        long long fe, fv, fb, fa = -1;
+        double te = nsPerQuery(queries, [&]( int q ) { return eytzinger.contains(q); }, fe);
+        double tv = nsPerQuery(queries, [&]( int q ) { return veb.contains(q); }, fv);
+        double tb = nsPerQuery(queries, [&]( int q ) { return binarySearch(sorted, q) != -1; }, fb);
+
+        std::cout << n << "\t" << te << "\t" << tv << "\t" << tb << "\t";
+
+        if (lg <= avlMaxLog) {
+            AVLTree<int> avl{};
+            for (int x : sorted) avl.insert(x);
+            double ta = nsPerQuery(queries, [&]( int q ) { return avl.contains(q); }, fa);
+            std::cout << ta;
+        }
+        else {
+            std::cout << "-";
+        }
+        std::cout << "\n";
+
+        if (fe != fb || fv != fb || (fa != -1 && fa != fb)) {
+            std::cout << "Oops! Search structures disagree at n = " << n << "\n";
+        }
+    }
+
+    return 0;
+}
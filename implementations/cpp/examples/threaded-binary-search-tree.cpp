@@ -0,0 +1,55 @@
+#include "../lib/ThreadedBinarySearchTree.h"
+#include <iostream>
+#include <vector>
+#include <set>
+#include <cstdlib>
+
+int main() {
+    ThreadedBinarySearchTree<int> tbst{};
+
+    if (tbst.isEmpty()) {
+        std::cout << "1. Threaded BST is empty.\n";
+    }
+
+    std::vector<int> items = {6, 2, 8, 1, 4, 3};
+    for (auto item : items) {
+        tbst.insert(item);
+    }
+
+    if (tbst.findMin() == 1 && tbst.findMax() == 8) {
+        std::cout << "2. Found the smallest and largest values.\n";
+    }
+
+    std::cout << "3. In-order traversal through threads: ";
+    tbst.printTree();
+
+    tbst.remove(2);
+    if (!tbst.contains(2)) {
+        std::cout << "4. Threads survive removing a node with two children: ";
+        tbst.printTree();
+    }
+
+    // Random inserts and removes checked against std::set after every step.
+    std::set<int> reference;
+    ThreadedBinarySearchTree<int> big{};
+    std::srand(335);
+    bool ok = true;
+    for (int i = 0; i < 20000 && ok; ++i) {
+        int x = std::rand() % 500;
+        if (std::rand() % 3 == 0) { big.remove(x); reference.erase(x); }
+        else                      { big.insert(x); reference.insert(x); }
+
+        if (i % 97 == 0) {
+            ok = std::equal(big.begin(), big.end(), reference.begin(), reference.end());
+        }
+    }
+
+    ThreadedBinarySearchTree<int> copy = big;
+    ok = ok && std::equal(copy.begin(), copy.end(), reference.begin(), reference.end());
+
+    if (ok) {
+        std::cout << "5. Threaded traversal matches std::set after random updates.\n";
+    }
+
+    return 0;
+}
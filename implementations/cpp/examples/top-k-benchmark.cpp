@@ -0,0 +1,121 @@
+#include "../lib/Selection.h"
+#include "../lib/BinaryHeap.h"
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+
+/*
+Top-k of a stream and k-th smallest of an array:
+  stream: a BinaryHeap holding every item (lecture 13, 1st algorithm)
+          against TopK on one thread and per-thread TopK sets joined with
+          mergeTopK
+  array:  std::sort against introSelect, on random input and on input
+          that defeats median-of-three (organ pipe and all-equal)
+Compile with -pthread.
+*/
+
+template<typename Function>
+double millis( Function f ) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// the k largest by sorting, largest first
+std::vector<int> expectedTopK( std::vector<int> items, int k ) {
+    std::sort(items.begin(), items.end(), std::greater<>{});
+    items.resize(std::min<size_t>(k, items.size()));
+    return items;
+}
+
+bool checkSelect( std::vector<int> items, int k, double& tSort, double& tSelect ) {
+    std::vector<int> sorted = items;
+    tSort = millis([&]() { std::sort(sorted.begin(), sorted.end()); });
+    tSelect = millis([&]() { introSelect(items.begin(), items.begin() + k, items.end()); });
+
+    if (items[k] != sorted[k]) return false;
+    for (int i = 0; i < k; ++i) {
+        if (sorted[k] < items[i]) return false;
+    }
+    for (size_t i = k + 1; i < items.size(); ++i) {
+        if (items[i] < sorted[k]) return false;
+    }
+    return true;
+}
+
+int main( int argc, char* argv[] ) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    int k = argc > 2 ? std::atoi(argv[2]) : 100;
+    int numThreads = argc > 3 ? std::atoi(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::mt19937 gen{ 13 };
+    std::vector<int> items(n);
+    for (auto& x : items) x = static_cast<int>(gen() % 1000000000);
+    std::vector<int> expected = expectedTopK(items, k);
+
+    // 1. every item in a BinaryHeap: O(n) memory, the k largest are at the
+    // bottom so they are found by deleting all the others
+    std::vector<int> fromHeap;
+    double tHeap = millis([&]() {
+        BinaryHeap<int> h{};
+        for (int x : items) h.insert(x);
+        int x;
+        for (int i = 0; i < n - k; ++i) h.deleteMin();
+        while (!h.isEmpty()) {
+            h.deleteMin(x);
+            fromHeap.insert(fromHeap.begin(), x);
+        }
+    });
+    std::cout << "1. BinaryHeap of all items: " << tHeap << " ms\n";
+    if (fromHeap != expected) std::cout << "Oops! BinaryHeap top-k is wrong.\n";
+
+    // 2. one TopK
+    std::vector<int> fromTopK;
+    double tTopK = millis([&]() {
+        TopK<int> top{ k };
+        for (int x : items) top.insert(x);
+        fromTopK = top.items();
+    });
+    std::cout << "2. TopK: " << tTopK << " ms\n";
+    if (fromTopK != expected) std::cout << "Oops! TopK is wrong.\n";
+
+    // 3. one TopK per thread over a slice each, then a parallel merge
+    std::vector<int> fromParallel;
+    double tParallel = millis([&]() {
+        std::vector<TopK<int>> parts(numThreads, TopK<int>{ k });
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&, t]() {
+                size_t begin = static_cast<size_t>(n) * t / numThreads;
+                size_t end = static_cast<size_t>(n) * (t + 1) / numThreads;
+                for (size_t i = begin; i < end; ++i) parts[t].insert(items[i]);
+            });
+        }
+        for (auto& th : threads) th.join();
+        fromParallel = mergeTopK(parts).items();
+    });
+    std::cout << "3. TopK on " << numThreads << " threads + mergeTopK: " << tParallel << " ms\n";
+    if (fromParallel != expected) std::cout << "Oops! mergeTopK is wrong.\n";
+
+    // 4.-6. k-th smallest with std::sort and introSelect
+    std::vector<int> organPipe(n), equal(n, 42);
+    for (int i = 0; i < n; ++i) organPipe[i] = i < n / 2 ? i : n - i;
+
+    const char* names[] = { "random", "organ pipe", "all equal" };
+    const std::vector<int>* inputs[] = { &items, &organPipe, &equal };
+    for (int i = 0; i < 3; ++i) {
+        double tSort, tSelect;
+        bool ok = checkSelect(*inputs[i], n / 2, tSort, tSelect);
+        std::cout << i + 4 << ". median of " << names[i] << ": std::sort " << tSort
+                  << " ms, introSelect " << tSelect << " ms\n";
+        if (!ok) std::cout << "Oops! introSelect is wrong on " << names[i] << " input.\n";
+    }
+
+    return 0;
+}
@@ -3,8 +3,14 @@
 
 #include <iostream>
 #include <algorithm>
+#include <stdexcept>
 
-template<typename Comparable>
+/*
+AVL tree. When OrderStatistics is true every node also stores the size of
+its subtree, which is maintained by insert, remove and every rotation, and
+enables select, rank and countRange in O(log n).
+*/
+template<typename Comparable, bool OrderStatistics = false>
 class AVLTree {
     public:
         // zero-parameter constructor
@@ -12,13 +18,13 @@ class AVLTree {
         // copy constructor
         AVLTree( const AVLTree& rhs );
         // move constructor
-        AVLTree( const AVLTree&& rhs );
+        AVLTree( AVLTree&& rhs );
         // destructor
         ~AVLTree();
         // copy assignment
         AVLTree& operator=( const AVLTree& rhs );
         // move assignment
-        AVLTree& operator=( const AVLTree&& rhs );
+        AVLTree& operator=( AVLTree&& rhs );
 
         /*
         @brief Find the smallest item in a subtree t.
@@ -68,27 +74,55 @@ class AVLTree {
         @brief Print tree in order.
         @return void
         */
-        void printTree() const;
         void printTree( std::ostream& out = std::cout ) const;
 
+        /*
+        @brief Return the number of items in the tree. Requires
+               OrderStatistics.
+        @return int
+        */
+        int size() const;
+
+        /*
+        @brief Find the item with exactly k smaller items in the tree, i.e.,
+               the (k+1)-th smallest item. Requires OrderStatistics.
+        @throw out_of_range exception if k is not in [0, size())
+        @return Comparable&
+        */
+        const Comparable& select( int k ) const;
+
+        /*
+        @brief Count the items less than x. Requires OrderStatistics.
+        @return int
+        */
+        int rank( const Comparable& x ) const;
+
+        /*
+        @brief Count the items in the closed range [lo, hi]. Requires
+               OrderStatistics.
+        @return int
+        */
+        int countRange( const Comparable& lo, const Comparable& hi ) const;
+
     private:
         struct AVLNode {
             Comparable item;
             AVLNode* left;
             AVLNode* right;
             int height;
+            int size;   // subtree size; only maintained with OrderStatistics
 
-            AVLNode( const Comparable& item, AVLNode* left, AVLNode* right, int h = 0)
-                : item{ item }, left{ left }, right{ right }, height{ h } {}
+            AVLNode( const Comparable& item, AVLNode* left, AVLNode* right, int h = 0, int s = 1)
+                : item{ item }, left{ left }, right{ right }, height{ h }, size{ s } {}
 
-            AVLNode( const Comparable&& item, AVLNode* left, AVLNode* right, int h = 0)
-                : item{ std::move(item) }, left{ left }, right{ right }, height{ h } {}
+            AVLNode( const Comparable&& item, AVLNode* left, AVLNode* right, int h = 0, int s = 1)
+                : item{ std::move(item) }, left{ left }, right{ right }, height{ h }, size{ s } {}
         };
 
         AVLNode* _root;
         static const int ALLOWED_IMBALANCE = 1;
 
-        void _insert( const Comparable& x, AVLNode* t );
+        void _insert( const Comparable& x, AVLNode*& t );
         void _remove( const Comparable& x, AVLNode*& t );
         void _balance( AVLNode*& t );
         AVLNode* _findMin( AVLNode* t ) const;
@@ -98,7 +132,10 @@ class AVLTree {
         AVLNode* _clone( AVLNode* t ) const;
         int _height( AVLNode* t ) const;
         int _max( int  lhs, int rhs ) const;
-        void _print( std::ostream& out, AVLNode* t );
+        int _size( AVLNode* t ) const;
+        void _updateSize( AVLNode* t );
+        int _rank( const Comparable& x, bool inclusive ) const;
+        void _print( std::ostream& out, AVLNode* t ) const;
         void _rotateWithLeftChild( AVLNode*& k2 );
         void _rotateWithRightChild( AVLNode*& k1 );
         void _doubleWithLeftChild( AVLNode*& k3 );
@@ -107,102 +144,125 @@ class AVLTree {
 
 //PUBLIC
 
-template<typename Comparable>
-AVLTree<Comparable>::AVLTree() : _root{ nullptr } {}
+template<typename Comparable, bool OrderStatistics>
+AVLTree<Comparable, OrderStatistics>::AVLTree() : _root{ nullptr } {}
 
-template<typename Comparable>
-AVLTree<Comparable>::AVLTree( const AVLTree& rhs ) : _root{ nullptr } {
+template<typename Comparable, bool OrderStatistics>
+AVLTree<Comparable, OrderStatistics>::AVLTree( const AVLTree& rhs ) : _root{ nullptr } {
     _root = _clone(rhs._root);
 }
 
-template<typename Comparable>
-AVLTree<Comparable>::AVLTree( const AVLTree&& rhs ) : _root{ rhs._root } {
+template<typename Comparable, bool OrderStatistics>
+AVLTree<Comparable, OrderStatistics>::AVLTree( AVLTree&& rhs ) : _root{ rhs._root } {
     rhs._root = nullptr;
 }
 
-template<typename Comparable>
-AVLTree<Comparable>::~AVLTree() {
+template<typename Comparable, bool OrderStatistics>
+AVLTree<Comparable, OrderStatistics>::~AVLTree() {
     makeEmpty();
 }
 
-template<typename Comparable>
-AVLTree<Comparable>& AVLTree<Comparable>::operator=( const AVLTree& rhs ) {
+template<typename Comparable, bool OrderStatistics>
+AVLTree<Comparable, OrderStatistics>& AVLTree<Comparable, OrderStatistics>::operator=( const AVLTree& rhs ) {
     AVLTree copy = rhs;
     std::swap(*this, copy);
     return *this;
 }
 
-template<typename Comparable>
-AVLTree<Comparable>& AVLTree<Comparable>::operator=( const AVLTree&& rhs ) {
+template<typename Comparable, bool OrderStatistics>
+AVLTree<Comparable, OrderStatistics>& AVLTree<Comparable, OrderStatistics>::operator=( AVLTree&& rhs ) {
     std::swap(_root, rhs._root);
     return *this;
 }
 
-template<typename Comparable>
-const Comparable& AVLTree<Comparable>::findMin() const {
+template<typename Comparable, bool OrderStatistics>
+const Comparable& AVLTree<Comparable, OrderStatistics>::findMin() const {
     return _findMin(_root)->item;
 }
 
-template<typename Comparable>
-const Comparable& AVLTree<Comparable>::findMax() const {
+template<typename Comparable, bool OrderStatistics>
+const Comparable& AVLTree<Comparable, OrderStatistics>::findMax() const {
     return _findMax(_root)->item;
 }
 
-template<typename Comparable>
-bool AVLTree<Comparable>::contains( const Comparable& x ) {
+template<typename Comparable, bool OrderStatistics>
+bool AVLTree<Comparable, OrderStatistics>::contains( const Comparable& x ) {
     return _contains(x, _root);
 }
 
 
-template<typename Comparable>
-bool AVLTree<Comparable>::isEmpty() const {
+template<typename Comparable, bool OrderStatistics>
+bool AVLTree<Comparable, OrderStatistics>::isEmpty() const {
     return _root == nullptr;
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::makeEmpty() {
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::makeEmpty() {
     _makeEmpty(_root);
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::insert( const Comparable& x ) {
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::insert( const Comparable& x ) {
     _insert(x, _root);
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::insert( const Comparable&& x ) {
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::insert( const Comparable&& x ) {
     _insert(std::move(x), _root);
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::remove( const Comparable& x ) {
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::remove( const Comparable& x ) {
     _remove(x, _root);
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::printTree() const {
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::printTree( std::ostream& out ) const {
     if (isEmpty()) {
-        std::cout << "Empty tree\n";
+        out << "Empty tree\n";
     }
     else {
-        _print(std::cout, _root);
+        _print(out, _root);
     }
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::printTree( std::ostream& out ) const {
-    if (isEmpty()) {
-        out << "Empty tree\n";
+template<typename Comparable, bool OrderStatistics>
+int AVLTree<Comparable, OrderStatistics>::size() const {
+    static_assert(OrderStatistics, "size() needs AVLTree<Comparable, true>");
+    return _size(_root);
+}
+
+template<typename Comparable, bool OrderStatistics>
+const Comparable& AVLTree<Comparable, OrderStatistics>::select( int k ) const {
+    static_assert(OrderStatistics, "select() needs AVLTree<Comparable, true>");
+    if (k < 0 || k >= _size(_root)) {
+        throw std::out_of_range("AVLTree::select: rank out of range.\n");
     }
-    else {
-        _print(out, _root);
+
+    AVLNode* t = _root;
+    while (true) {
+        int leftSize = _size(t->left);
+        if      (k < leftSize)  { t = t->left; }
+        else if (k == leftSize) { return t->item; }
+        else                    { k -= leftSize + 1; t = t->right; }
     }
 }
 
+template<typename Comparable, bool OrderStatistics>
+int AVLTree<Comparable, OrderStatistics>::rank( const Comparable& x ) const {
+    return _rank(x, false);
+}
+
+template<typename Comparable, bool OrderStatistics>
+int AVLTree<Comparable, OrderStatistics>::countRange( const Comparable& lo, const Comparable& hi ) const {
+    if (hi < lo) { return 0; }
+    return _rank(hi, true) - _rank(lo, false);
+}
+
 // PRIVATE
 
-template<typename Comparable>
-void AVLTree<Comparable>::_insert( const Comparable& x, AVLNode* t ) {
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::_insert( const Comparable& x, AVLNode*& t ) {
     if (t == nullptr)     { t = new AVLNode{x, nullptr, nullptr}; }
     else if (x < t->item) { _insert(x, t->left);  }
     else if (t->item < x) { _insert(x, t->right); }
@@ -210,8 +270,8 @@ void AVLTree<Comparable>::_insert( const Comparable& x, AVLNode* t ) {
     _balance(t);
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::_remove( const Comparable& x, AVLNode*& t ) {
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::_remove( const Comparable& x, AVLNode*& t ) {
     if (t == nullptr) { return; }
 
     if      (x < t->item) { _remove(x, t->left);  }
@@ -219,7 +279,7 @@ void AVLTree<Comparable>::_remove( const Comparable& x, AVLNode*& t ) {
     else if (t->left != nullptr && t->right != nullptr) {
         Comparable item = _findMin(t->right)->item;
         t->item = item;
-        remove(item, t->right);
+        _remove(item, t->right);
     }
     else {
         AVLNode* oldNode = t;
@@ -230,8 +290,8 @@ void AVLTree<Comparable>::_remove( const Comparable& x, AVLNode*& t ) {
     _balance(t);
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::_balance( AVLNode*& t ) {
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::_balance( AVLNode*& t ) {
     if (t == nullptr) { return; }
     else if (_height(t->left) - _height(t->right) > ALLOWED_IMBALANCE) {
         if (_height(t->left->left) >= _height(t->left->right)) {
@@ -251,33 +311,34 @@ void AVLTree<Comparable>::_balance( AVLNode*& t ) {
     }
 
     t->height = _max(_height(t->left), _height(t->right)) + 1;
+    _updateSize(t);
 }
 
-template<typename Comparable>
-typename AVLTree<Comparable>::AVLNode* AVLTree<Comparable>::_findMin( AVLNode* t ) const {
+template<typename Comparable, bool OrderStatistics>
+typename AVLTree<Comparable, OrderStatistics>::AVLNode* AVLTree<Comparable, OrderStatistics>::_findMin( AVLNode* t ) const {
     if (t == nullptr)       { return nullptr; }
     if (t->left == nullptr) { return t; }
     return _findMin(t->left);
 }
 
 
-template<typename Comparable>
-typename  AVLTree<Comparable>::AVLNode* AVLTree<Comparable>::_findMax( AVLNode* t ) const {
+template<typename Comparable, bool OrderStatistics>
+typename  AVLTree<Comparable, OrderStatistics>::AVLNode* AVLTree<Comparable, OrderStatistics>::_findMax( AVLNode* t ) const {
     if (t == nullptr)        { return nullptr; }
     if (t->right == nullptr) { return t; }
     return _findMax(t->right);
 }
 
-template<typename Comparable>
-bool AVLTree<Comparable>::_contains( const Comparable& x, AVLNode* t ) const {
+template<typename Comparable, bool OrderStatistics>
+bool AVLTree<Comparable, OrderStatistics>::_contains( const Comparable& x, AVLNode* t ) const {
     if (t == nullptr)     { return false; }
     else if (x < t->item) { return _contains(x, t->left); }
     else if (t->item < x) { return _contains(x, t->right); }
     else                  { return true; }
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::_makeEmpty( AVLNode*& t ) {
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::_makeEmpty( AVLNode*& t ) {
     if (t != nullptr) {
         _makeEmpty(t->left);
         _makeEmpty(t->right);
@@ -286,56 +347,98 @@ void AVLTree<Comparable>::_makeEmpty( AVLNode*& t ) {
     t = nullptr;
 }
 
-template<typename Comparable>
-typename AVLTree<Comparable>::AVLNode* AVLTree<Comparable>::_clone( AVLNode* t ) const {
+template<typename Comparable, bool OrderStatistics>
+typename AVLTree<Comparable, OrderStatistics>::AVLNode* AVLTree<Comparable, OrderStatistics>::_clone( AVLNode* t ) const {
     if (t == nullptr) { return nullptr; }
-    else { return new AVLNode{t->item, _clone(t->left), _clone(t->right), t->height };  }
+    else { return new AVLNode{t->item, _clone(t->left), _clone(t->right), t->height, t->size };  }
 }
 
-template<typename Comparable>
-int AVLTree<Comparable>::_height( AVLNode* t ) const {
+template<typename Comparable, bool OrderStatistics>
+int AVLTree<Comparable, OrderStatistics>::_height( AVLNode* t ) const {
     return t == nullptr ? -1 : t->height; 
 }
 
-template<typename Comparable>
-int AVLTree<Comparable>::_max( int  lhs, int rhs ) const {
+template<typename Comparable, bool OrderStatistics>
+int AVLTree<Comparable, OrderStatistics>::_max( int  lhs, int rhs ) const {
     return lhs > rhs ? lhs : rhs;
 }
 
-template<typename Comparable>
-void AVLTree<Comparable>::_print( std::ostream& out, AVLNode* t ) {
-    _print(out, t->left);
-    out << t->item << " ";
-    _print(out, t->right);
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::_print( std::ostream& out, AVLNode* t ) const {
+    if (t != nullptr) {
+        _print(out, t->left);
+        out << t->item << " ";
+        _print(out, t->right);
+    }
+}
+
+template<typename Comparable, bool OrderStatistics>
+int AVLTree<Comparable, OrderStatistics>::_size( AVLNode* t ) const {
+    return t == nullptr ? 0 : t->size;
+}
+
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::_updateSize( AVLNode* t ) {
+    if (OrderStatistics) {
+        t->size = _size(t->left) + _size(t->right) + 1;
+    }
+}
+
+/*
+@brief Count the items less than x (or not greater than x if inclusive) by
+       adding up the left subtrees passed on the way down.
+@return int
+*/
+template<typename Comparable, bool OrderStatistics>
+int AVLTree<Comparable, OrderStatistics>::_rank( const Comparable& x, bool inclusive ) const {
+    static_assert(OrderStatistics, "rank queries need AVLTree<Comparable, true>");
+    int count = 0;
+    AVLNode* t = _root;
+    while (t != nullptr) {
+        if (x < t->item || (!inclusive && !(t->item < x))) {
+            t = t->left;
+        }
+        else {
+            count += _size(t->left) + 1;
+            t = t->right;
+        }
+    }
+    return count;
 }
 
 /*
 @brief Rotate binary tree node with left child. This performs a left-left
-       single rotation (case 1). Update heights, then sets new root.
+       single rotation (case 1). Update heights (and subtree sizes),
+       then sets new root.
 @return void
 */
-template<typename Comparable>
-void AVLTree<Comparable>::_rotateWithLeftChild( AVLNode*& k2 ) {
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::_rotateWithLeftChild( AVLNode*& k2 ) {
     AVLNode *k1 = k2->left;
     k2->left = k1->right;
     k1->right = k2;
     k2->height = _max(_height(k2->left), _height(k2->right)) + 1;
-    k1->height = _max(_height(k2->left), k2->height) + 1;
+    k1->height = _max(_height(k1->left), k2->height) + 1;
+    _updateSize(k2);
+    _updateSize(k1);
     k2 = k1;
 }
 
 /*
 @brief Rotate binary tree node with right child. This performs a right-right
-       single rotation (case 4). Update heights, then sets new root.
+       single rotation (case 4). Update heights (and subtree sizes),
+       then sets new root.
 @return void
 */
-template<typename Comparable>
-void AVLTree<Comparable>::_rotateWithRightChild( AVLNode*& k1 ) {
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::_rotateWithRightChild( AVLNode*& k1 ) {
     AVLNode *k2 = k1->right;
     k1->right = k2->left;
-    k2->right = k1;
+    k2->left = k1;
     k1->height = _max(_height(k1->left), _height(k1->right)) + 1;
     k2->height = _max(_height(k2->right), k1->height) + 1;
+    _updateSize(k1);
+    _updateSize(k2);
     k1 = k2;
 }
 
@@ -345,8 +448,8 @@ void AVLTree<Comparable>::_rotateWithRightChild( AVLNode*& k1 ) {
        right-left double rotation. Update heights, then set new root.
 @return void
 */
-template<typename Comparable>
-void AVLTree<Comparable>::_doubleWithLeftChild( AVLNode*& k3 ) {
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::_doubleWithLeftChild( AVLNode*& k3 ) {
     _rotateWithRightChild(k3->left);
     _rotateWithLeftChild(k3);
 }
@@ -357,8 +460,8 @@ void AVLTree<Comparable>::_doubleWithLeftChild( AVLNode*& k3 ) {
        left-right double rotation. Update heights, then set new root.
 @return void
 */
-template<typename Comparable>
-void AVLTree<Comparable>::_doubleWithRightChild( AVLNode*& k1 ) {
+template<typename Comparable, bool OrderStatistics>
+void AVLTree<Comparable, OrderStatistics>::_doubleWithRightChild( AVLNode*& k1 ) {
     _rotateWithLeftChild(k1->right);
     _rotateWithRightChild(k1);
 }
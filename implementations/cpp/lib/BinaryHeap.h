@@ -3,12 +3,20 @@
 
 #include <iostream>
 #include <vector>
+#include <iterator>
+#include <type_traits>
 
 template<typename Comparable>
 class BinaryHeap {
     public:
         explicit BinaryHeap( int capacity = 100 );
         explicit BinaryHeap( const std::vector<Comparable>& items);
+        explicit BinaryHeap( std::vector<Comparable>&& items );
+
+        // Build a heap from the items in [first, last) in linear time.
+        // Pass move iterators to move the items in instead of copying.
+        template<typename InputIt>
+        BinaryHeap( InputIt first, InputIt last );
 
         // Find the minimum item in the heap.
         const Comparable& findMin() const;
@@ -17,15 +25,39 @@ class BinaryHeap {
         void insert( const Comparable& x );
         void insert( Comparable&& x );
 
+        // Insert the items in [first, last). A batch that is large compared
+        // to the heap is appended and the heap rebuilt in O(n) instead.
+        template<typename InputIt>
+        void insertMany( InputIt first, InputIt last );
+
         // Remove the minimum item.
         void deleteMin();
 
         // Remove the minimum item and place it in minItem.
         void deleteMin( Comparable& minItem );
 
+        /*
+        @brief Remove the k smallest items (or all, if there are fewer) and
+               write them to out in increasing order.
+        @return OutputIt, past the last item written
+        */
+        template<typename OutputIt>
+        OutputIt popK( int k, OutputIt out );
+
+        // Replace the minimum item with x in a single percolate down;
+        // cheaper than deleteMin followed by insert.
+        void replaceMin( const Comparable& x );
+
+        // Merge rhs into this heap; rhs becomes empty. Appends rhs's items
+        // and rebuilds the heap, so this is O(n) in the combined size.
+        void merge( BinaryHeap& rhs );
+
         // Check if heap is empty.
         bool isEmpty() const;
 
+        // Return the number of items in the heap.
+        int size() const;
+
         // Empty the heap.
         void makeEmpty();
 
@@ -50,12 +82,28 @@ BinaryHeap<Comparable>::BinaryHeap( int capacity )
 
 template<typename Comparable>
 BinaryHeap<Comparable>::BinaryHeap( const std::vector<Comparable> & items ) 
-    : _array( items.size( ) + 10 ), _currentSize{ items.size( ) } {
-    for (int i = 0; i < items.size( ); ++i) {
-        _array[i + 1] = items[i];
-    }
+    : BinaryHeap( items.begin( ), items.end( ) )
+{ }
+
+template<typename Comparable>
+BinaryHeap<Comparable>::BinaryHeap( std::vector<Comparable>&& items )
+    : _currentSize{ 0 }, _array( std::move(items) ) {
+    // slot 0 is unused; the items are shifted by moves, never copied
+    _array.insert(_array.begin(), Comparable{});
+    _currentSize = static_cast<int>(_array.size()) - 1;
 
-    _buildHeap( );
+    _buildHeap();
+}
+
+template<typename Comparable>
+template<typename InputIt>
+BinaryHeap<Comparable>::BinaryHeap( InputIt first, InputIt last )
+    : _currentSize{ 0 }, _array( 1 ) {
+    _array.insert(_array.end(), first, last);
+    _currentSize = static_cast<int>(_array.size()) - 1;
+    _array.resize(_array.size() + 10);
+
+    _buildHeap();
 }
 
 template<typename Comparable>
@@ -79,19 +127,16 @@ void BinaryHeap<Comparable>::insert( const Comparable& x ) {
         _array.resize(_array.size() * 2);
     }
 
-    // percolate up
+    // percolate up, comparing against x in place so that it is copied
+    // exactly once, into its final slot
     _currentSize += 1;
     int hole = _currentSize;
-    Comparable copy = x;
 
-    _array[0] = std::move(copy);
-    //while (x < _array[hole/2]) {
-    for (; x < _array[hole/2]; hole /= 2) {
+    for (; hole > 1 && x < _array[hole/2]; hole /= 2) {
         _array[hole] = std::move(_array[hole/2]);
-        //hole = hole / 2;
     }
 
-    _array[hole] = std::move(_array[0]);
+    _array[hole] = x;
 }
 
 template<typename Comparable>
@@ -111,6 +156,41 @@ void BinaryHeap<Comparable>::insert( Comparable&& x ) {
     _array[hole] = std::move(x);
 }
 
+/*
+Inserting k items one at a time costs O(k log(n + k)); appending them and
+rebuilding costs O(n + k). The rebuild is used once the batch is big enough
+for that to be the cheaper of the two.
+*/
+template<typename Comparable>
+template<typename InputIt>
+void BinaryHeap<Comparable>::insertMany( InputIt first, InputIt last ) {
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if (!std::is_base_of<std::forward_iterator_tag, Category>::value) {
+        for (; first != last; ++first) insert(*first);
+        return;
+    }
+
+    long long k = std::distance(first, last);
+    long long total = _currentSize + k;
+    int logTotal = 0;
+    for (long long t = total; t > 1; t /= 2) logTotal += 1;
+
+    if (k * logTotal <= total) {
+        for (; first != last; ++first) insert(*first);
+        return;
+    }
+
+    if (total >= static_cast<long long>(_array.size())) {
+        _array.resize(2 * total + 1);
+    }
+    for (int i = _currentSize + 1; first != last; ++first, ++i) {
+        _array[i] = *first;
+    }
+    _currentSize = static_cast<int>(total);
+
+    _buildHeap();
+}
+
 template<typename Comparable>
 void BinaryHeap<Comparable>::deleteMin() {
     if (isEmpty()) {
@@ -134,6 +214,50 @@ void BinaryHeap<Comparable>::deleteMin( Comparable& minItem ) {
     _percolateDown(1);
 }
 
+template<typename Comparable>
+template<typename OutputIt>
+OutputIt BinaryHeap<Comparable>::popK( int k, OutputIt out ) {
+    for (; k > 0 && !isEmpty(); --k) {
+        *out++ = std::move(_array[1]);
+        _array[1] = std::move(_array[_currentSize--]);
+        _percolateDown(1);
+    }
+    return out;
+}
+
+template<typename Comparable>
+void BinaryHeap<Comparable>::replaceMin( const Comparable& x ) {
+    if (isEmpty()) {
+        std::cout << "Error: Underflow\n";
+        std::abort();
+    }
+
+    _array[1] = x;
+    _percolateDown(1);
+}
+
+template<typename Comparable>
+void BinaryHeap<Comparable>::merge( BinaryHeap& rhs ) {
+    if (this == &rhs) return; // avoid aliasing problems
+
+    if (_currentSize + rhs._currentSize >= static_cast<int>(_array.size())) {
+        _array.resize(2 * (_currentSize + rhs._currentSize) + 1);
+    }
+
+    for (int i = 1; i <= rhs._currentSize; ++i) {
+        _array[_currentSize + i] = std::move(rhs._array[i]);
+    }
+    _currentSize += rhs._currentSize;
+    rhs.makeEmpty();
+
+    _buildHeap();
+}
+
+template<typename Comparable>
+int BinaryHeap<Comparable>::size() const {
+    return _currentSize;
+}
+
 template<typename Comparable>
 void BinaryHeap<Comparable>::makeEmpty() {
     _currentSize = 0;
@@ -2,17 +2,199 @@
 #define BINARYSEARCH_H
 
 #include <vector>
+#include <iterator>
+#include <functional>
+#include <utility>
+#include <cstddef>
 
-int binarySearch( const std::vector<int> &A, int &x ) {
-    int low = 0;
-    int high = A.size() - 1;
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BINARY_SEARCH_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define BINARY_SEARCH_PREFETCH(addr) ((void) 0)
+#endif
+
+/*
+@brief Classic three-way binary search for x in the sorted vector A.
+@return std::ptrdiff_t, the position of x or -1 if x is not in A
+*/
+template<typename Comparable, typename Compare = std::less<>>
+std::ptrdiff_t binarySearch( const std::vector<Comparable>& A, const Comparable& x,
+                             Compare comp = Compare{} ) {
+    std::ptrdiff_t low = 0;
+    std::ptrdiff_t high = static_cast<std::ptrdiff_t>(A.size()) - 1;
     while (low <= high) {
-        int mid = (low + high) / 2;
-        if      (A[mid] < x) { low = mid + 1;  }
-        else if (A[mid] > x) { high = mid - 1; }
-        else                 { return mid;     }
+        std::ptrdiff_t mid = low + (high - low) / 2; // (low + high) / 2 can overflow
+        if      (comp(A[mid], x)) { low = mid + 1;  }
+        else if (comp(x, A[mid])) { high = mid - 1; }
+        else                      { return mid;     }
     }
     return -1;
 }
 
+/*
+@brief Find the first position in the sorted range [first, last) whose item
+       is not less than x.
+@return ForwardIt
+*/
+template<typename ForwardIt, typename T, typename Compare = std::less<>>
+ForwardIt lowerBound( ForwardIt first, ForwardIt last, const T& x, Compare comp = Compare{} ) {
+    auto len = std::distance(first, last);
+    while (len > 0) {
+        auto half = len / 2;
+        ForwardIt mid = std::next(first, half);
+        if (comp(*mid, x)) {
+            first = std::next(mid);
+            len -= half + 1;
+        }
+        else {
+            len = half;
+        }
+    }
+    return first;
+}
+
+/*
+@brief Find the first position in the sorted range [first, last) whose item
+       is greater than x.
+@return ForwardIt
+*/
+template<typename ForwardIt, typename T, typename Compare = std::less<>>
+ForwardIt upperBound( ForwardIt first, ForwardIt last, const T& x, Compare comp = Compare{} ) {
+    auto len = std::distance(first, last);
+    while (len > 0) {
+        auto half = len / 2;
+        ForwardIt mid = std::next(first, half);
+        if (!comp(x, *mid)) {
+            first = std::next(mid);
+            len -= half + 1;
+        }
+        else {
+            len = half;
+        }
+    }
+    return first;
+}
+
+/*
+@brief Find the subrange of [first, last) whose items are equivalent to x.
+@return std::pair<ForwardIt, ForwardIt>
+*/
+template<typename ForwardIt, typename T, typename Compare = std::less<>>
+std::pair<ForwardIt, ForwardIt> equalRange( ForwardIt first, ForwardIt last, const T& x,
+                                            Compare comp = Compare{} ) {
+    ForwardIt lower = lowerBound(first, last, x, comp);
+    return { lower, upperBound(lower, last, x, comp) };
+}
+
+/*
+@brief Branchless lowerBound over a random-access range. The range length
+       shrinks by the same amount whatever the comparison says, so the loop
+       runs exactly ceil(log2 n) times and the comparison only decides
+       whether base moves, which compilers turn into a conditional move.
+@return RandomIt
+*/
+template<typename RandomIt, typename T, typename Compare = std::less<>>
+RandomIt branchlessLowerBound( RandomIt first, RandomIt last, const T& x, Compare comp = Compare{} ) {
+    auto len = last - first;
+    if (len == 0) return first;
+
+    RandomIt base = first;
+    while (len > 1) {
+        auto half = len / 2;
+        base += comp(base[half], x) ? half : 0;
+        len -= half;
+    }
+    return base + comp(*base, x);
+}
+
+/*
+@brief 5-ary lowerBound over sorted ints. Every step compares x against
+       four evenly spaced pivots at once and keeps the fifth of the range
+       that holds the answer; the last few items are counted directly. Uses
+       SSE2 when available, otherwise the same algorithm in scalar code.
+@return std::ptrdiff_t, the position of the first item not less than x
+*/
+inline std::ptrdiff_t simdLowerBound( const int* A, std::ptrdiff_t n, int x ) {
+    const int* base = A;
+    std::ptrdiff_t len = n;
+
+    // invariant: every item before base is less than x, and the answer is
+    // in [base, base + len]
+    while (len > 16) {
+        std::ptrdiff_t step = len / 5;
+#if defined(__SSE2__)
+        __m128i pivots = _mm_set_epi32(base[4 * step], base[3 * step], base[2 * step], base[step]);
+        __m128i less = _mm_cmplt_epi32(pivots, _mm_set1_epi32(x));
+        int c = __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(less)));
+#else
+        int c = (base[step] < x) + (base[2 * step] < x) + (base[3 * step] < x) + (base[4 * step] < x);
+#endif
+        base += c * step;
+        len = (c == 4) ? len - 4 * step : step;
+    }
+
+    std::ptrdiff_t count = 0;
+    for (std::ptrdiff_t i = 0; i < len; ++i) {
+        count += base[i] < x;
+    }
+    return (base - A) + count;
+}
+
+inline std::ptrdiff_t simdLowerBound( const std::vector<int>& A, int x ) {
+    return simdLowerBound(A.data(), static_cast<std::ptrdiff_t>(A.size()), x);
+}
+
+/*
+@brief Run branchlessLowerBound for every needle in [needlesFirst,
+       needlesLast) and write the resulting positions (offsets from first)
+       to out. Needles are searched in groups of BATCH whose descents are
+       interleaved level by level, so the cache misses of one group
+       overlap instead of being paid one after another; the next probes of
+       each needle are prefetched as well.
+@return OutputIt, one past the last position written
+*/
+template<typename RandomIt, typename InputIt, typename OutputIt, typename Compare = std::less<>>
+OutputIt batchLowerBound( RandomIt first, RandomIt last, InputIt needlesFirst, InputIt needlesLast,
+                          OutputIt out, Compare comp = Compare{} ) {
+    static const int BATCH = 16;
+    using Needle = typename std::iterator_traits<InputIt>::value_type;
+    using Diff = typename std::iterator_traits<RandomIt>::difference_type;
+
+    const Diff n = last - first;
+    Needle needles[BATCH];
+    Diff bases[BATCH];
+
+    while (needlesFirst != needlesLast) {
+        int count = 0;
+        for (; count < BATCH && needlesFirst != needlesLast; ++count, ++needlesFirst) {
+            needles[count] = *needlesFirst;
+            bases[count] = 0;
+        }
+
+        if (n > 0) {
+            Diff len = n;
+            while (len > 1) {
+                Diff half = len / 2;
+                for (int j = 0; j < count; ++j) {
+                    bases[j] += comp(first[bases[j] + half], needles[j]) ? half : 0;
+                    BINARY_SEARCH_PREFETCH(&first[bases[j] + (len - half) / 2]);
+                }
+                len -= half;
+            }
+            for (int j = 0; j < count; ++j) {
+                bases[j] += comp(first[bases[j]], needles[j]);
+            }
+        }
+
+        for (int j = 0; j < count; ++j) {
+            *out++ = bases[j];
+        }
+    }
+    return out;
+}
+
 #endif
@@ -0,0 +1,303 @@
+#ifndef BINOMIAL_QUEUE_H
+#define BINOMIAL_QUEUE_H
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include "NodePool.h"
+
+/*
+Binomial queue (lecture 14): a forest of heap-ordered binomial trees with
+at most one tree of each rank. _trees[k] is the tree of rank k (2^k nodes)
+or nullptr. Trees use the first child/next sibling representation with the
+children kept in decreasing rank order. merge adds the forests like binary
+numbers, so merge, deleteMin and insert are O(log n); insert is O(1)
+amortized.
+*/
+template<typename Comparable>
+class BinomialQueue {
+    public:
+        BinomialQueue();
+        BinomialQueue( const BinomialQueue& rhs ) = delete;            // queues are merged, not copied
+        BinomialQueue( BinomialQueue&& rhs );                          // move constructor
+        BinomialQueue& operator=( const BinomialQueue& rhs ) = delete;
+        BinomialQueue& operator=( BinomialQueue&& rhs );               // move assignment
+        ~BinomialQueue();
+
+        // Find the minimum item in the queue.
+        const Comparable& findMin() const;
+
+        // Insert item x, allowing duplicates.
+        void insert( const Comparable& x );
+        void insert( Comparable&& x );
+
+        // Remove the minimum item.
+        void deleteMin();
+
+        // Remove the minimum item and place it in minItem.
+        void deleteMin( Comparable& minItem );
+
+        // Merge rhs into this queue in O(log n); rhs becomes empty.
+        void merge( BinomialQueue& rhs );
+
+        // Check if queue is empty.
+        bool isEmpty() const;
+
+        // Return the number of items in the queue.
+        int size() const;
+
+        // Empty the queue.
+        void makeEmpty();
+
+    private:
+        struct BinomialNode {
+            Comparable    item;
+            BinomialNode* leftChild;
+            BinomialNode* nextSibling;
+
+            BinomialNode( const Comparable& item, BinomialNode* lt = nullptr, BinomialNode* rt = nullptr )
+                : item{ item }, leftChild{ lt }, nextSibling{ rt } {}
+            BinomialNode( Comparable&& item, BinomialNode* lt = nullptr, BinomialNode* rt = nullptr )
+                : item{ std::move(item) }, leftChild{ lt }, nextSibling{ rt } {}
+        };
+
+        int _currentSize;                  // number of items in the queue
+        std::vector<BinomialNode*> _trees; // an array of tree roots
+
+        NodePool<BinomialNode> _pool;   // takes over the pool of rhs on merge
+
+        // Find index of the tree containing the smallest item. The queue
+        // must not be empty.
+        int _findMinIndex() const;
+
+        // Return the result of merging equal-sized trees t1 and t2.
+        BinomialNode* _combineTrees( BinomialNode* t1, BinomialNode* t2 );
+
+        // Add a single-node tree; a merge with a one-item queue that needs
+        // no temporary forest.
+        void _insertTree( BinomialNode* t );
+
+        // Merge a forest of trees with the given number of items into this
+        // queue.
+        void _mergeTrees( std::vector<BinomialNode*>& rhsTrees, int rhsSize );
+
+        void _checkNotEmpty() const;
+};
+
+template<typename Comparable>
+BinomialQueue<Comparable>::BinomialQueue() : _currentSize{ 0 } {}
+
+template<typename Comparable>
+BinomialQueue<Comparable>::BinomialQueue( BinomialQueue&& rhs )
+    : _currentSize{ rhs._currentSize }, _trees{ std::move(rhs._trees) }, _pool{ std::move(rhs._pool) } {
+    rhs._currentSize = 0;
+    rhs._trees.clear();
+}
+
+template<typename Comparable>
+BinomialQueue<Comparable>& BinomialQueue<Comparable>::operator=( BinomialQueue&& rhs ) {
+    std::swap(_currentSize, rhs._currentSize);
+    std::swap(_trees, rhs._trees);
+    std::swap(_pool, rhs._pool);
+    return *this;
+}
+
+template<typename Comparable>
+BinomialQueue<Comparable>::~BinomialQueue() {
+    makeEmpty();
+}
+
+template<typename Comparable>
+const Comparable& BinomialQueue<Comparable>::findMin() const {
+    _checkNotEmpty();
+    return _trees[_findMinIndex()]->item;
+}
+
+template<typename Comparable>
+void BinomialQueue<Comparable>::insert( const Comparable& x ) {
+    _insertTree(_pool.allocate(x));
+}
+
+template<typename Comparable>
+void BinomialQueue<Comparable>::insert( Comparable&& x ) {
+    _insertTree(_pool.allocate(std::move(x)));
+}
+
+template<typename Comparable>
+void BinomialQueue<Comparable>::deleteMin() {
+    Comparable x;
+    deleteMin(x);
+}
+
+/*
+Removing the root of the rank-k tree leaves its k children, which are
+binomial trees of ranks k-1, ..., 0; they form a queue of their own that is
+merged back.
+*/
+template<typename Comparable>
+void BinomialQueue<Comparable>::deleteMin( Comparable& minItem ) {
+    _checkNotEmpty();
+
+    int minIndex = _findMinIndex();
+    BinomialNode* oldRoot = _trees[minIndex];
+    minItem = std::move(oldRoot->item);
+    BinomialNode* child = oldRoot->leftChild;
+    _pool.release(oldRoot);
+
+    std::vector<BinomialNode*> deletedTrees(minIndex, nullptr);
+    for (int j = minIndex - 1; j >= 0; --j) {
+        deletedTrees[j] = child;
+        child = child->nextSibling;
+        deletedTrees[j]->nextSibling = nullptr;
+    }
+
+    _trees[minIndex] = nullptr;
+    _currentSize -= (1 << minIndex);
+    _mergeTrees(deletedTrees, (1 << minIndex) - 1);
+}
+
+template<typename Comparable>
+void BinomialQueue<Comparable>::merge( BinomialQueue& rhs ) {
+    if (this == &rhs) return; // avoid aliasing problems
+
+    _mergeTrees(rhs._trees, rhs._currentSize);
+    rhs._trees.clear();
+    rhs._currentSize = 0;
+    _pool.splice(rhs._pool);
+}
+
+template<typename Comparable>
+bool BinomialQueue<Comparable>::isEmpty() const {
+    return _currentSize == 0;
+}
+
+template<typename Comparable>
+int BinomialQueue<Comparable>::size() const {
+    return _currentSize;
+}
+
+template<typename Comparable>
+void BinomialQueue<Comparable>::makeEmpty() {
+    std::vector<BinomialNode*> stack;
+    for (BinomialNode* root : _trees) {
+        if (root != nullptr) stack.push_back(root);
+    }
+
+    while (!stack.empty()) {
+        BinomialNode* t = stack.back();
+        stack.pop_back();
+        if (t->leftChild != nullptr)   stack.push_back(t->leftChild);
+        if (t->nextSibling != nullptr) stack.push_back(t->nextSibling);
+        _pool.release(t);
+    }
+
+    _trees.clear();
+    _currentSize = 0;
+}
+
+template<typename Comparable>
+int BinomialQueue<Comparable>::_findMinIndex() const {
+    int i = 0;
+    while (_trees[i] == nullptr) ++i;
+
+    int minIndex = i;
+    for (; i < static_cast<int>(_trees.size()); ++i) {
+        if (_trees[i] != nullptr && _trees[i]->item < _trees[minIndex]->item) {
+            minIndex = i;
+        }
+    }
+    return minIndex;
+}
+
+template<typename Comparable>
+typename BinomialQueue<Comparable>::BinomialNode*
+BinomialQueue<Comparable>::_combineTrees( BinomialNode* t1, BinomialNode* t2 ) {
+    if (t2->item < t1->item) {
+        return _combineTrees(t2, t1);
+    }
+    t2->nextSibling = t1->leftChild;
+    t1->leftChild = t2;
+    return t1;
+}
+
+template<typename Comparable>
+void BinomialQueue<Comparable>::_insertTree( BinomialNode* carry ) {
+    _currentSize += 1;
+    for (size_t i = 0; ; ++i) {
+        if (i == _trees.size()) {
+            _trees.push_back(nullptr);
+        }
+        if (_trees[i] == nullptr) {
+            _trees[i] = carry;
+            return;
+        }
+        carry = _combineTrees(_trees[i], carry);
+        _trees[i] = nullptr;
+    }
+}
+
+/*
+Add the two forests rank by rank with a carry, like binary addition. The
+trees of rhsTrees are taken over; the vector itself is left with dangling
+entries and must be discarded by the caller.
+*/
+template<typename Comparable>
+void BinomialQueue<Comparable>::_mergeTrees( std::vector<BinomialNode*>& rhsTrees, int rhsSize ) {
+    _currentSize += rhsSize;
+
+    size_t needed = 0;
+    while ((size_t{ 1 } << needed) <= static_cast<size_t>(_currentSize)) ++needed;
+    if (_trees.size() < needed) {
+        _trees.resize(needed, nullptr);
+    }
+
+    BinomialNode* carry = nullptr;
+    for (size_t i = 0; i < _trees.size() && (i < rhsTrees.size() || carry != nullptr); ++i) {
+        BinomialNode* t1 = _trees[i];
+        BinomialNode* t2 = i < rhsTrees.size() ? rhsTrees[i] : nullptr;
+
+        int whichCase = t1 == nullptr ? 0 : 1;
+        whichCase += t2 == nullptr ? 0 : 2;
+        whichCase += carry == nullptr ? 0 : 4;
+
+        switch (whichCase) {
+            case 0: // no trees
+            case 1: // only this
+                break;
+            case 2: // only rhs
+                _trees[i] = t2;
+                break;
+            case 4: // only carry
+                _trees[i] = carry;
+                carry = nullptr;
+                break;
+            case 3: // this and rhs
+                carry = _combineTrees(t1, t2);
+                _trees[i] = nullptr;
+                break;
+            case 5: // this and carry
+                carry = _combineTrees(t1, carry);
+                _trees[i] = nullptr;
+                break;
+            case 6: // rhs and carry
+                carry = _combineTrees(t2, carry);
+                break;
+            case 7: // all three
+                _trees[i] = carry;
+                carry = _combineTrees(t1, t2);
+                break;
+        }
+    }
+}
+
+template<typename Comparable>
+void BinomialQueue<Comparable>::_checkNotEmpty() const {
+    if (isEmpty()) {
+        std::cout << "Error: Underflow\n";
+        std::abort();
+    }
+}
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef D_HEAP_H
+#define D_HEAP_H
+
+#include <iostream>
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <cstdlib>
+
+#if defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+/*
+Allocator returning storage aligned to Align bytes, so that the positions
+DHeap reserves for each group of siblings map onto cache lines.
+*/
+template<typename T, size_t Align>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind { using other = AlignedAllocator<U, Align>; };
+
+    AlignedAllocator() = default;
+    template<typename U>
+    AlignedAllocator( const AlignedAllocator<U, Align>& ) {}
+
+    T* allocate( size_t n ) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align)));
+    }
+
+    void deallocate( T* p, size_t ) {
+        ::operator delete(p, std::align_val_t(Align));
+    }
+
+    template<typename U>
+    bool operator==( const AlignedAllocator<U, Align>& ) const { return true; }
+    template<typename U>
+    bool operator!=( const AlignedAllocator<U, Align>& ) const { return false; }
+};
+
+/*
+Index of the smallest of the D items starting at p. The generic version is
+a scalar scan; full groups of 4 or 8 ints use SSE4.1/AVX2 when the compiler
+targets them.
+*/
+template<typename Comparable, int D>
+struct MinChild {
+    static int index( const Comparable* p, int count ) {
+        int best = 0;
+        for (int i = 1; i < count; ++i) {
+            if (p[i] < p[best]) best = i;
+        }
+        return best;
+    }
+};
+
+#if defined(__SSE4_1__)
+template<>
+struct MinChild<int, 4> {
+    static int index( const int* p, int count ) {
+        if (count != 4) return MinChild<int, 1>::index(p, count);
+
+        __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i m = _mm_min_epi32(v, _mm_shuffle_epi32(v, 0x4E));
+        m = _mm_min_epi32(m, _mm_shuffle_epi32(m, 0xB1));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, m)));
+        return __builtin_ctz(mask);
+    }
+};
+#endif
+
+#if defined(__AVX2__)
+template<>
+struct MinChild<int, 8> {
+    static int index( const int* p, int count ) {
+        if (count != 8) return MinChild<int, 1>::index(p, count);
+
+        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(p));
+        __m128i m = _mm_min_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        m = _mm_min_epi32(m, _mm_shuffle_epi32(m, 0x4E));
+        m = _mm_min_epi32(m, _mm_shuffle_epi32(m, 0xB1));
+        __m256i eq = _mm256_cmpeq_epi32(v, _mm256_broadcastd_epi32(m));
+        return __builtin_ctz(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+    }
+};
+#endif
+
+/*
+d-ary min-heap (lecture 13). Shallower than a binary heap, so insert does
+fewer percolate-up steps while deleteMin does more comparisons per level.
+Item i lives at _array[i + D - 1]; this puts the D children of every node
+at a multiple of D, so with a cache-line aligned array a sibling group
+never straddles a cache line when D * sizeof(Comparable) divides 64.
+*/
+template<typename Comparable, int D = 4>
+class DHeap {
+    static_assert(D >= 2, "a d-heap needs at least two children per node");
+
+    public:
+        explicit DHeap( int capacity = 100 );
+        explicit DHeap( const std::vector<Comparable>& items );
+
+        // Find the minimum item in the heap.
+        const Comparable& findMin() const;
+
+        // Insert item x, allowing duplicates.
+        void insert( const Comparable& x );
+        void insert( Comparable&& x );
+
+        // Remove the minimum item.
+        void deleteMin();
+
+        // Remove the minimum item and place it in minItem.
+        void deleteMin( Comparable& minItem );
+
+        // Check if heap is empty.
+        bool isEmpty() const;
+
+        // Return the number of items in the heap.
+        int size() const;
+
+        // Empty the heap.
+        void makeEmpty();
+
+    private:
+        static const int OFFSET = D - 1;
+
+        int _currentSize;                                              // number of elements in heap
+        std::vector<Comparable, AlignedAllocator<Comparable, 64>> _array; // the heap array
+
+        // Establish heap order property from an arbitrary arrangement
+        // of items. Runs in linear time.
+        void _buildHeap();
+
+        // Percolate up from logical index hole and store x there.
+        template<typename T>
+        void _percolateUp( int hole, T&& x );
+
+        // Percolate down in the heap.
+        // hole is the logical index at which the percolate begins.
+        void _percolateDown( int hole );
+};
+
+template<typename Comparable, int D>
+DHeap<Comparable, D>::DHeap( int capacity )
+    : _currentSize{ 0 }, _array( capacity + OFFSET )
+{ }
+
+template<typename Comparable, int D>
+DHeap<Comparable, D>::DHeap( const std::vector<Comparable>& items )
+    : _currentSize{ static_cast<int>(items.size()) }, _array( items.size() + OFFSET + 10 ) {
+    for (size_t i = 0; i < items.size(); ++i) {
+        _array[i + OFFSET] = items[i];
+    }
+
+    _buildHeap();
+}
+
+template<typename Comparable, int D>
+bool DHeap<Comparable, D>::isEmpty() const {
+    return _currentSize == 0;
+}
+
+template<typename Comparable, int D>
+int DHeap<Comparable, D>::size() const {
+    return _currentSize;
+}
+
+template<typename Comparable, int D>
+const Comparable& DHeap<Comparable, D>::findMin() const {
+    if (isEmpty()) {
+        std::cout << "Error: Underflow\n";
+        std::abort();
+    }
+
+    return _array[OFFSET];
+}
+
+template<typename Comparable, int D>
+void DHeap<Comparable, D>::insert( const Comparable& x ) {
+    _percolateUp(_currentSize, x);
+}
+
+template<typename Comparable, int D>
+void DHeap<Comparable, D>::insert( Comparable&& x ) {
+    _percolateUp(_currentSize, std::move(x));
+}
+
+template<typename Comparable, int D>
+void DHeap<Comparable, D>::deleteMin() {
+    if (isEmpty()) {
+        std::cout << "Error: Underflow\n";
+        std::abort();
+    }
+
+    _array[OFFSET] = std::move(_array[OFFSET + --_currentSize]);
+    _percolateDown(0);
+}
+
+template<typename Comparable, int D>
+void DHeap<Comparable, D>::deleteMin( Comparable& minItem ) {
+    if (isEmpty()) {
+        std::cout << "Error: Underflow\n";
+        std::abort();
+    }
+
+    minItem = std::move(_array[OFFSET]);
+    _array[OFFSET] = std::move(_array[OFFSET + --_currentSize]);
+    _percolateDown(0);
+}
+
+template<typename Comparable, int D>
+void DHeap<Comparable, D>::makeEmpty() {
+    _currentSize = 0;
+}
+
+template<typename Comparable, int D>
+void DHeap<Comparable, D>::_buildHeap() {
+    for (int i = (_currentSize - 2) / D; i >= 0; --i) {
+        _percolateDown(i);
+    }
+}
+
+template<typename Comparable, int D>
+template<typename T>
+void DHeap<Comparable, D>::_percolateUp( int hole, T&& x ) {
+    if (_currentSize + OFFSET == static_cast<int>(_array.size())) {
+        _array.resize(_array.size() * 2);
+    }
+    _currentSize += 1;
+
+    for (; hole > 0 && x < _array[OFFSET + (hole - 1) / D]; hole = (hole - 1) / D) {
+        _array[OFFSET + hole] = std::move(_array[OFFSET + (hole - 1) / D]);
+    }
+
+    _array[OFFSET + hole] = std::forward<T>(x);
+}
+
+template<typename Comparable, int D>
+void DHeap<Comparable, D>::_percolateDown( int hole ) {
+    Comparable tmp = std::move(_array[OFFSET + hole]);
+
+    for (int first = D * hole + 1; first < _currentSize; first = D * hole + 1) {
+        int count = _currentSize - first < D ? _currentSize - first : D;
+        int child = first + MinChild<Comparable, D>::index(&_array[OFFSET + first], count);
+
+        if (_array[OFFSET + child] < tmp) {
+            _array[OFFSET + hole] = std::move(_array[OFFSET + child]);
+            hole = child;
+        }
+        else {
+            break;
+        }
+    }
+
+    _array[OFFSET + hole] = std::move(tmp);
+}
+
+#endif
@@ -0,0 +1,239 @@
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+
+#include "Graph.h"
+#include "TaskScheduler.h"
+
+/*
+Delta-stepping single-source shortest paths (Meyer and Sanders) on a
+TaskScheduler. Dijkstra settles one vertex at a time, in the order of a
+single priority queue; delta-stepping instead keeps the tentative
+distances in buckets of width delta, vertex v in bucket dist[v] / delta,
+and empties the lowest non-empty bucket in parallel:
+  light edges (weight < delta) of the vertices in the bucket are relaxed
+  in rounds, since they may put vertices back into the same bucket, until
+  the bucket stays empty; then the heavy edges of every vertex removed
+  from it are relaxed once, which reaches later buckets, except when
+  d + w rounds down into the same bucket (floating-point weights). The
+  bucket is then emptied again, and the vertices removed in that round
+  have their heavy edges relaxed again.
+Distances are lowered with a compare-and-swap, so threads may relax edges
+into the same vertex at once. A small delta does little extra work but
+needs many bucket rounds (delta -> 0 is Dijkstra), a large one does few
+rounds but relaxes edges from vertices whose distances later drop
+(delta -> infinity is Bellman-Ford).
+*/
+
+namespace delta_stepping_detail {
+    // Fewest vertices or edges worth a task of their own.
+    const int GRAIN = 1024;
+
+    // Lower x to d if d is smaller; return true if it was.
+    template<typename Weight>
+    bool atomicMin( std::atomic<Weight>& x, Weight d ) {
+        Weight old = x.load(std::memory_order_relaxed);
+        while (d < old) {
+            if (x.compare_exchange_weak(old, d, std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+}
+
+/*
+@brief Shortest paths from s by delta-stepping, with the same distances as
+       dijkstra in Graph.h. Weights must not be negative. delta <= 0 picks
+       the maximum weight over the average out-degree, the choice of Meyer
+       and Sanders for random weights. path is rebuilt from the distances
+       after the search, along edges (u, v) with dist[u] + weight == dist[v].
+@return ShortestPaths<Weight>
+*/
+template<typename Weight>
+ShortestPaths<Weight> deltaStepping( const Graph<Weight>& g, Vertex s, TaskScheduler& scheduler,
+                                     Weight delta = Weight{ 0 } ) {
+    using namespace delta_stepping_detail;
+    typedef std::vector<Vertex> Bucket;
+    const Weight INFINITY_DISTANCE = ShortestPaths<Weight>::INFINITY_DISTANCE;
+
+    int n = g.numVertices();
+    std::int64_t m = g.numEdges();
+    const std::int64_t* offsets = g.offsets();
+    int vertexBlocks = numBlocks(n, scheduler, GRAIN);
+
+    Weight maxWeight{ 0 };
+    bool zeroWeights = false;
+    for (std::int64_t e = 0; e < m; ++e) {
+        maxWeight = std::max(maxWeight, g.weight(e));
+        zeroWeights = zeroWeights || g.weight(e) == Weight{ 0 };
+    }
+    if (!(delta > Weight{ 0 })) {
+        delta = m == 0 ? Weight{ 1 } : static_cast<Weight>(maxWeight * n / m);
+        if (!(delta > Weight{ 0 })) delta = Weight{ 1 };
+    }
+
+    // a copy of the edges with the light edges of each vertex first
+    std::vector<Vertex> targets(m);
+    std::vector<Weight> weights(m);
+    std::vector<std::int64_t> lightEnd(n);
+    parallelFor(vertexBlocks, scheduler, [&]( int b ) {
+        Vertex first = static_cast<Vertex>(static_cast<std::int64_t>(n) * b / vertexBlocks);
+        Vertex last = static_cast<Vertex>(static_cast<std::int64_t>(n) * (b + 1) / vertexBlocks);
+        for (Vertex v = first; v < last; ++v) {
+            std::int64_t light = offsets[v], heavy = offsets[v + 1];
+            for (std::int64_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+                std::int64_t i = g.weight(e) < delta ? light++ : --heavy;
+                targets[i] = g.target(e);
+                weights[i] = g.weight(e);
+            }
+            lightEnd[v] = light;
+        }
+    });
+
+    std::unique_ptr<std::atomic<Weight>[]> dist{ new std::atomic<Weight>[n] };
+    std::unique_ptr<std::atomic<std::int64_t>[]> removedIn{ new std::atomic<std::int64_t>[n] };
+    parallelFor(vertexBlocks, scheduler, [&]( int b ) {
+        Vertex first = static_cast<Vertex>(static_cast<std::int64_t>(n) * b / vertexBlocks);
+        Vertex last = static_cast<Vertex>(static_cast<std::int64_t>(n) * (b + 1) / vertexBlocks);
+        for (Vertex v = first; v < last; ++v) {
+            dist[v].store(INFINITY_DISTANCE, std::memory_order_relaxed);
+            removedIn[v].store(-1, std::memory_order_relaxed);
+        }
+    });
+    auto bucketOf = [delta]( Weight d ) { return static_cast<std::size_t>(d / delta); };
+
+    // buckets[i] holds vertices of tentative distance in [i delta, (i + 1) delta),
+    // and stale entries of vertices that have since moved to a lower bucket;
+    // each block of a round collects its insertions in bins[block] first
+    int maxBlocks = numBlocks(std::int64_t{ GRAIN } * 8 * scheduler.numThreads(), scheduler, GRAIN);
+    std::vector<Bucket> buckets(1);
+    std::vector<std::vector<Bucket>> bins(maxBlocks);
+    std::vector<Bucket> removed(maxBlocks);
+    Bucket frontier, settled;
+    std::int64_t round = 0;       // rounds of light then heavy edges, for removedIn
+    dist[s].store(Weight{ 0 }, std::memory_order_relaxed);
+    buckets[0].push_back(s);
+
+    // Relax edges [first, last) of a vertex at distance dv; file improved vertices in bins[block].
+    auto relax = [&]( int block, Weight dv, std::int64_t first, std::int64_t last ) {
+        for (std::int64_t e = first; e < last; ++e) {
+            Weight d = dv + weights[e];
+            Vertex w = targets[e];
+            if (atomicMin(dist[w], d)) {
+                std::size_t i = bucketOf(d);
+                if (i >= bins[block].size()) bins[block].resize(i + 1);
+                bins[block][i].push_back(w);
+            }
+        }
+    };
+
+    // Move the bins into the buckets, except bucket current, which is
+    // returned as the next frontier.
+    auto collect = [&]( std::size_t current, Bucket& next ) {
+        next.clear();
+        for (auto& bin : bins) {
+            if (bin.size() > buckets.size()) buckets.resize(bin.size());
+            for (std::size_t i = current; i < bin.size(); ++i) {
+                Bucket& to = i == current ? next : buckets[i];
+                to.insert(to.end(), bin[i].begin(), bin[i].end());
+                bin[i].clear();
+            }
+        }
+    };
+
+    for (std::size_t current = 0; current < buckets.size(); ++current) {
+        frontier.swap(buckets[current]);
+        Bucket().swap(buckets[current]);
+
+        while (!frontier.empty()) {
+            settled.clear();
+            round += 1;
+            while (!frontier.empty()) {
+                int blocks = numBlocks(static_cast<std::int64_t>(frontier.size()), scheduler, GRAIN);
+                parallelFor(blocks, scheduler, [&]( int b ) {
+                    std::size_t first = frontier.size() * b / blocks, last = frontier.size() * (b + 1) / blocks;
+                    removed[b].clear();
+                    for (std::size_t i = first; i < last; ++i) {
+                        Vertex v = frontier[i];
+                        Weight dv = dist[v].load(std::memory_order_relaxed);
+                        if (bucketOf(dv) != current) continue; // stale
+
+                        if (removedIn[v].exchange(round, std::memory_order_relaxed) != round) {
+                            removed[b].push_back(v);
+                        }
+                        relax(b, dv, offsets[v], lightEnd[v]);
+                    }
+                });
+                for (int b = 0; b < blocks; ++b) {
+                    settled.insert(settled.end(), removed[b].begin(), removed[b].end());
+                }
+                collect(current, frontier);
+            }
+
+            // the light edges are done: relax the heavy edges of the vertices
+            // removed in this round; their distances are final unless one of
+            // them rounds back into bucket current and starts another round
+            int blocks = numBlocks(static_cast<std::int64_t>(settled.size()), scheduler, GRAIN);
+            parallelFor(blocks, scheduler, [&]( int b ) {
+                std::size_t first = settled.size() * b / blocks, last = settled.size() * (b + 1) / blocks;
+                for (std::size_t i = first; i < last; ++i) {
+                    Vertex v = settled[i];
+                    relax(b, dist[v].load(std::memory_order_relaxed), lightEnd[v], offsets[v + 1]);
+                }
+            });
+            collect(current, frontier);
+        }
+    }
+
+    ShortestPaths<Weight> result;
+    result.dist.resize(n);
+    result.path.assign(n, NOT_A_VERTEX);
+    for (Vertex v = 0; v < n; ++v) result.dist[v] = dist[v].load(std::memory_order_relaxed);
+
+    // parents along positive tight edges strictly lower the distance, so
+    // they cannot form a cycle; any parent will do
+    std::unique_ptr<std::atomic<Vertex>[]> parent{ new std::atomic<Vertex>[n] };
+    for (Vertex v = 0; v < n; ++v) parent[v].store(NOT_A_VERTEX, std::memory_order_relaxed);
+    parallelFor(vertexBlocks, scheduler, [&]( int b ) {
+        Vertex first = static_cast<Vertex>(static_cast<std::int64_t>(n) * b / vertexBlocks);
+        Vertex last = static_cast<Vertex>(static_cast<std::int64_t>(n) * (b + 1) / vertexBlocks);
+        for (Vertex u = first; u < last; ++u) {
+            Weight du = result.dist[u];
+            if (du == INFINITY_DISTANCE) continue;
+            for (std::int64_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+                Vertex w = targets[e];
+                if (weights[e] > Weight{ 0 } && w != s && du + weights[e] == result.dist[w]) {
+                    parent[w].store(u, std::memory_order_relaxed);
+                }
+            }
+        }
+    });
+    for (Vertex v = 0; v < n; ++v) result.path[v] = parent[v].load(std::memory_order_relaxed);
+
+    if (zeroWeights) {
+        // vertices reached only over zero-weight edges get their parents by
+        // a search along tight zero-weight edges from the others
+        Bucket queue;
+        for (Vertex v = 0; v < n; ++v) {
+            if (v == s || result.path[v] != NOT_A_VERTEX) queue.push_back(v);
+        }
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            Vertex u = queue[head];
+            for (std::int64_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+                Vertex w = targets[e];
+                if (weights[e] == Weight{ 0 } && w != s && result.path[w] == NOT_A_VERTEX
+                    && result.dist[u] == result.dist[w]) {
+                    result.path[w] = u;
+                    queue.push_back(w);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,227 @@
+#ifndef DISJOINT_SETS_H
+#define DISJOINT_SETS_H
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+/*
+Disjoint sets over the elements 0..N-1 (lecture 16), in the implicit array
+representation: s[x] is the parent of x, or, for a root, the negative of
+its rank minus 1. Union-by-rank keeps the trees O(log N) deep and path
+halving (every other node on a find path is pointed at its grandparent)
+flattens them as they are used, for O(M alpha(N)) total time over M
+operations. One int32 per element.
+*/
+class DisjointSets {
+    public:
+        explicit DisjointSets( int numElements );
+
+        // Return the root of the set containing x.
+        int find( int x );
+
+        /*
+        @brief Union of the two sets with roots root1 and root2 (union is a
+               keyword, hence the name). The root of lower rank is made a
+               child of the other.
+        @return int, the root of the union
+        */
+        int unionSets( int root1, int root2 );
+
+        /*
+        @brief Union of the sets containing x and y.
+        @return bool, false if x and y were already in the same set
+        */
+        bool unite( int x, int y );
+
+        // Check if x and y are in the same set.
+        bool connected( int x, int y );
+
+        // Return the number of elements.
+        int size() const;
+
+        // Return the number of sets.
+        int numSets() const;
+
+    private:
+        std::vector<std::int32_t> _s;
+        int _numSets;
+};
+
+inline DisjointSets::DisjointSets( int numElements )
+    : _s( numElements, -1 ), _numSets{ numElements }
+{ }
+
+inline int DisjointSets::find( int x ) {
+    while (_s[x] >= 0) {
+        int parent = _s[x];
+        if (_s[parent] < 0) return parent;
+
+        _s[x] = _s[parent]; // path halving
+        x = _s[x];
+    }
+    return x;
+}
+
+inline int DisjointSets::unionSets( int root1, int root2 ) {
+    if (root1 == root2) return root1;
+
+    // root2 is deeper so make root2 the new root
+    if (_s[root2] < _s[root1]) {
+        _s[root1] = root2;
+        _numSets -= 1;
+        return root2;
+    }
+
+    // update rank if both sets are the same
+    if (_s[root1] == _s[root2]) {
+        _s[root1]--;
+    }
+
+    // make root1 the new root
+    _s[root2] = root1;
+    _numSets -= 1;
+    return root1;
+}
+
+inline bool DisjointSets::unite( int x, int y ) {
+    int root1 = find(x);
+    int root2 = find(y);
+    if (root1 == root2) return false;
+
+    unionSets(root1, root2);
+    return true;
+}
+
+inline bool DisjointSets::connected( int x, int y ) {
+    return find(x) == find(y);
+}
+
+inline int DisjointSets::size() const {
+    return static_cast<int>(_s.size());
+}
+
+inline int DisjointSets::numSets() const {
+    return _numSets;
+}
+
+/*
+Concurrent disjoint sets for many threads uniting and finding at once,
+without locks. p[x] is the parent of x, and a root is its own parent.
+  find:  path halving, where each shortcut is a single compare-and-swap
+         that is simply dropped if another thread changed p[x] first, so
+         a find never retries or waits
+  unite: link one root under the other with a compare-and-swap on the
+         child's parent, which fails only if that root was linked by
+         another thread meanwhile; then it starts over from the new roots
+Instead of ranks, which cannot be updated together with the link, roots are
+linked by a fixed random priority of each element (a bijective hash), the
+randomized linking of Jayanti and Tarjan, which keeps the expected depth
+O(log N). One 32-bit atomic per element.
+*/
+class ConcurrentDisjointSets {
+    public:
+        explicit ConcurrentDisjointSets( int numElements );
+
+        ConcurrentDisjointSets( const ConcurrentDisjointSets& rhs ) = delete;
+        ConcurrentDisjointSets& operator=( const ConcurrentDisjointSets& rhs ) = delete;
+
+        // Return the root of the set containing x. Thread-safe.
+        int find( int x );
+
+        /*
+        @brief Union of the sets containing x and y. Thread-safe.
+        @return bool, false if x and y were already in the same set
+        */
+        bool unite( int x, int y );
+
+        // Check if x and y are in the same set. Thread-safe.
+        bool connected( int x, int y );
+
+        // Return the number of elements.
+        int size() const;
+
+        // Return the number of sets. Only a snapshot under concurrency.
+        int numSets() const;
+
+    private:
+        int _numElements;
+        std::unique_ptr<std::atomic<std::uint32_t>[]> _p;
+        std::atomic<int> _numSets;
+
+        static std::uint32_t _priority( std::uint32_t x );
+};
+
+inline ConcurrentDisjointSets::ConcurrentDisjointSets( int numElements )
+    : _numElements{ numElements },
+      _p{ new std::atomic<std::uint32_t>[numElements] },
+      _numSets{ numElements } {
+    for (int i = 0; i < numElements; ++i) {
+        _p[i].store(static_cast<std::uint32_t>(i), std::memory_order_relaxed);
+    }
+}
+
+inline int ConcurrentDisjointSets::find( int x ) {
+    std::uint32_t u = static_cast<std::uint32_t>(x);
+    while (true) {
+        std::uint32_t parent = _p[u].load(std::memory_order_acquire);
+        if (parent == u) return static_cast<int>(u);
+
+        std::uint32_t grandparent = _p[parent].load(std::memory_order_acquire);
+        if (parent != grandparent) {
+            _p[u].compare_exchange_weak(parent, grandparent, std::memory_order_release,
+                                        std::memory_order_relaxed);
+        }
+        u = grandparent;
+    }
+}
+
+inline bool ConcurrentDisjointSets::unite( int x, int y ) {
+    while (true) {
+        std::uint32_t root1 = static_cast<std::uint32_t>(find(x));
+        std::uint32_t root2 = static_cast<std::uint32_t>(find(y));
+        if (root1 == root2) return false;
+
+        // link the root of lower priority under the other
+        if (_priority(root1) > _priority(root2)) std::swap(root1, root2);
+
+        std::uint32_t expected = root1;
+        if (_p[root1].compare_exchange_strong(expected, root2, std::memory_order_acq_rel)) {
+            _numSets.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+inline bool ConcurrentDisjointSets::connected( int x, int y ) {
+    while (true) {
+        std::uint32_t root1 = static_cast<std::uint32_t>(find(x));
+        std::uint32_t root2 = static_cast<std::uint32_t>(find(y));
+        if (root1 == root2) return true;
+
+        // root1 may have been linked under root2 after it was found
+        if (_p[root1].load(std::memory_order_acquire) == root1) return false;
+    }
+}
+
+inline int ConcurrentDisjointSets::size() const {
+    return _numElements;
+}
+
+inline int ConcurrentDisjointSets::numSets() const {
+    return _numSets.load(std::memory_order_relaxed);
+}
+
+inline std::uint32_t ConcurrentDisjointSets::_priority( std::uint32_t x ) {
+    // murmur3 finalizer: a bijection, so no two elements tie
+    x ^= x >> 16;
+    x *= 0x85ebca6bu;
+    x ^= x >> 13;
+    x *= 0xc2b2ae35u;
+    x ^= x >> 16;
+    return x;
+}
+
+#endif
@@ -1,8 +1,710 @@
 #ifndef EXPRESSION_TREE_H
 #define EXPRESSION_TREE_H
 
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+
+/*
+A binary expression tree (lecture 6) over double operands: the leaves are
+constants and variables, the other nodes the operators + - * / and unary
+minus (written ~ in postfix). Variables are numbered in order of first
+appearance, and evaluate and the columns of a Program are indexed by those
+numbers.
+  fromPostfix: the lecture algorithm. An operand is pushed as a one-node
+               tree; an operator pops the trees of its operands and pushes
+               the tree it makes with them.
+  fromInfix:   the same stack of trees, plus a stack of operators waiting
+               for their right operand (Dijkstra's shunting yard). Before
+               a binary operator is pushed, the operators on the stack of
+               the same or higher precedence are applied, so + - * / are
+               left associative; parentheses hold operators back.
+
+The nodes of a tree live in one arena, a vector in which the children of
+a node are indices, and which holds the children before their parents (the
+builders make a node after its operands). Building a tree is one
+allocation with no per-node new, copying it is a copy of the vector, and
+freeing it is one deallocation: the nodes are trivially destructible, so
+there is no walk of the tree, O(1).
+
+compile turns the tree into a Program of three-address instructions on
+registers. Along the way, constant subtrees are folded, the identities
+x - 0, x * 1, x / 1 and -(-x) are dropped (not x + 0 or x - -0, which turn
+-0 into 0, so that 1 / (x + 0) is not 1 / x), and equal subtrees are
+computed once: every node gets a value number from its operator and the
+value numbers of its children, and a node whose key was seen before reuses
+that value (common-subexpression elimination). A Program evaluates BLOCK
+rows at a time: each instruction is a loop over BLOCK-long registers that
+the compiler vectorizes, instead of a walk of the tree for every row.
+*/
 class ExpressionTree {
+    public:
+        enum Op { CONSTANT, VARIABLE, NEGATE, ADD, SUBTRACT, MULTIPLY, DIVIDE };
+        class Column;
+        class Program;
+
+        ExpressionTree();
+
+        /*
+        @brief Build the tree of a postfix expression such as "a b + 2 *".
+               Numbers, names and the operators + - * / ~ are the tokens;
+               spaces are needed only between two numbers or names.
+        @throw std::invalid_argument on a malformed expression
+        @return ExpressionTree
+        */
+        static ExpressionTree fromPostfix( const std::string& expression );
+
+        /*
+        @brief Build the tree of an infix expression such as "(a + b) * 2",
+               with the usual precedence and unary minus.
+        @throw std::invalid_argument on a malformed expression
+        @return ExpressionTree
+        */
+        static ExpressionTree fromInfix( const std::string& expression );
+
+        // Return the names of the variables, in order of first appearance.
+        const std::vector<std::string>& variables() const;
+
+        bool isEmpty() const;
+
+        // Make the tree empty, keeping its arena for reuse. O(1).
+        void makeEmpty();
+
+        // Return the number of nodes.
+        int size() const;
+
+        /*
+        @brief Evaluate the tree node by node in index order, children
+               first, with values[v] for variable v.
+        @throw std::invalid_argument if values has too few entries
+        @throw std::logic_error if the tree is empty
+        @return double
+        */
+        double evaluate( const std::vector<double>& values ) const;
+
+        /*
+        @brief Evaluate the rows 0..n-1, with columns[v] the column of
+               variable v, into out[0..n-1]: compile and run the Program.
+               To evaluate the same expression again, keep the Program.
+        @return void
+        */
+        void evaluate( const std::vector<Column>& columns, std::size_t n, double* out ) const;
+
+        // Return the fully parenthesized infix form (in-order traversal).
+        std::string infix() const;
+
+        // Return the postfix form (post-order traversal).
+        std::string postfix() const;
+
+        /*
+        @brief Fold, share and lower the tree to a Program.
+        @throw std::logic_error if the tree is empty
+        @return Program
+        */
+        Program compile() const;
+
+    private:
+        // A node of the arena; left and right are indices of nodes, or -1.
+        struct Node {
+            Op op;
+            int variable;     // of a VARIABLE
+            int left;         // the operand of NEGATE
+            int right;
+            double value;     // of a CONSTANT
+        };
+
+        // A node of the tree after compile has shared its equal subtrees:
+        // the children are value numbers.
+        struct Value {
+            Op op;
+            double constant;
+            int variable;
+            int left, right;
+        };
+
+        struct Token {
+            enum Kind { NUMBER, NAME, OPERATOR, LEFT, RIGHT };
+            Kind kind;
+            double value;
+            std::string text;
+        };
+
+        std::vector<Node> _nodes;           // the arena
+        int _root;                          // -1 if empty
+        std::vector<std::string> _variables;
 
+        static std::vector<Token> _tokenize( const std::string& expression );
+        static int _precedence( char op );
+        static Op _binary( char op );
+        static std::string _format( double x );
+
+        int _variable( const std::string& name );
+        int _leaf( const Token& token );
+        int _apply( char op, std::vector<int>& operands );
+        void _infix( std::ostream& out ) const;
+        void _postfix( std::ostream& out ) const;
+        int _number( int t, const std::vector<int>& number,
+                     std::map<std::tuple<int, std::uint64_t, int, int>, int>& numbers, std::vector<Value>& values ) const;
+};
+
+// The values of a variable in rows 0..n-1: an array of doubles or of 64-bit
+// integers, which are converted to double (exactly, up to 2^53).
+class ExpressionTree::Column {
+    public:
+        Column( const double* values ) : _doubles{ values }, _integers{ nullptr } { }
+        Column( const std::int64_t* values ) : _doubles{ nullptr }, _integers{ values } { }
+
+    private:
+        friend class Program;
+
+        const double* _doubles;
+        const std::int64_t* _integers;
+};
+
+class ExpressionTree::Program {
+    public:
+        static const int BLOCK = 256;
+
+        /*
+        @brief Evaluate the rows 0..n-1, with columns[v] the column of
+               variable v, into out[0..n-1]. Integer columns are converted
+               BLOCK rows at a time into a register.
+        @throw std::invalid_argument if there are too few columns
+        @return void
+        */
+        void evaluate( const std::vector<Column>& columns, std::size_t n, double* out ) const;
+        void evaluate( const std::vector<const double*>& columns, std::size_t n, double* out ) const;
+
+        // Evaluate one row, with values[v] for variable v.
+        double evaluate( const std::vector<double>& values ) const;
+
+        int numVariables() const;
+        int numRegisters() const;
+        int numInstructions() const;
+
+        // Print the instructions, one per line.
+        void print( std::ostream& out = std::cout ) const;
+
+    private:
+        friend class ExpressionTree;
+
+        // target = left op right; NEGATE ignores right.
+        struct Instruction {
+            Op op;
+            int target, left, right;
+        };
+
+        // Registers 0..V-1 are the variables, V..V+C-1 the constants and
+        // the rest temporaries.
+        int _numVariables;
+        std::vector<double> _constants;
+        int _numTemporaries;
+        std::vector<Instruction> _code;
+        int _result;
 };
 
+/******************************************************************************
+PUBLIC METHODS
+******************************************************************************/
+inline ExpressionTree::ExpressionTree()
+    : _root{ -1 }
+{ }
+
+inline ExpressionTree ExpressionTree::fromPostfix( const std::string& expression ) {
+    std::vector<Token> tokens = _tokenize(expression);
+    ExpressionTree tree;
+    tree._nodes.reserve(tokens.size());
+    std::vector<int> stack;
+    for (const Token& token : tokens) {
+        if (token.kind == Token::NUMBER || token.kind == Token::NAME) {
+            stack.push_back(tree._leaf(token));
+        }
+        else if (token.kind == Token::OPERATOR) {
+            stack.push_back(tree._apply(token.text[0], stack));
+        }
+        else {
+            throw std::invalid_argument("ExpressionTree: parenthesis in postfix expression");
+        }
+    }
+    if (stack.size() != 1) {
+        throw std::invalid_argument("ExpressionTree: postfix expression leaves "
+                                    + std::to_string(stack.size()) + " operands");
+    }
+    tree._root = stack.back();
+    return tree;
+}
+
+inline ExpressionTree ExpressionTree::fromInfix( const std::string& expression ) {
+    std::vector<Token> tokens = _tokenize(expression);
+    ExpressionTree tree;
+    tree._nodes.reserve(tokens.size());
+    std::vector<int> operands;
+    std::vector<char> operators;  // '(' or an operator; '~' is unary minus
+    bool expectOperand = true;
+    auto unwind = [&]( int precedence ) {
+        while (!operators.empty() && operators.back() != '(' && _precedence(operators.back()) >= precedence) {
+            operands.push_back(tree._apply(operators.back(), operands));
+            operators.pop_back();
+        }
+    };
+    for (const Token& token : tokens) {
+        if (token.kind == Token::NUMBER || token.kind == Token::NAME) {
+            if (!expectOperand) throw std::invalid_argument("ExpressionTree: missing operator before " + token.text);
+            operands.push_back(tree._leaf(token));
+            expectOperand = false;
+        }
+        else if (token.kind == Token::LEFT) {
+            if (!expectOperand) throw std::invalid_argument("ExpressionTree: missing operator before (");
+            operators.push_back('(');
+        }
+        else if (token.kind == Token::RIGHT) {
+            if (expectOperand) throw std::invalid_argument("ExpressionTree: missing operand before )");
+            unwind(0);
+            if (operators.empty()) throw std::invalid_argument("ExpressionTree: unbalanced )");
+            operators.pop_back();
+        }
+        else if (expectOperand) {
+            // a prefix operator: unary minus, or a unary plus, which does nothing
+            if (token.text == "-" || token.text == "~") operators.push_back('~');
+            else if (token.text != "+") throw std::invalid_argument("ExpressionTree: missing operand before " + token.text);
+        }
+        else {
+            if (token.text == "~") throw std::invalid_argument("ExpressionTree: ~ after an operand");
+            unwind(_precedence(token.text[0]));
+            operators.push_back(token.text[0]);
+            expectOperand = true;
+        }
+    }
+    if (expectOperand) throw std::invalid_argument("ExpressionTree: missing operand at the end");
+    unwind(0);
+    if (!operators.empty()) throw std::invalid_argument("ExpressionTree: unbalanced (");
+    tree._root = operands.back();
+    return tree;
+}
+
+inline const std::vector<std::string>& ExpressionTree::variables() const {
+    return _variables;
+}
+
+inline bool ExpressionTree::isEmpty() const {
+    return _root < 0;
+}
+
+inline void ExpressionTree::makeEmpty() {
+    _nodes.clear();
+    _variables.clear();
+    _root = -1;
+}
+
+inline int ExpressionTree::size() const {
+    return static_cast<int>(_nodes.size());
+}
+
+inline double ExpressionTree::evaluate( const std::vector<double>& values ) const {
+    if (values.size() < _variables.size()) {
+        throw std::invalid_argument("ExpressionTree: too few values for the variables");
+    }
+    if (_root < 0) throw std::logic_error("ExpressionTree: evaluate of an empty tree");
+
+    // children come before their parents, so one pass in index order
+    std::vector<double> result(_root + 1);
+    for (int t = 0; t <= _root; ++t) {
+        const Node& node = _nodes[t];
+        switch (node.op) {
+            case CONSTANT: result[t] = node.value; break;
+            case VARIABLE: result[t] = values[node.variable]; break;
+            case NEGATE:   result[t] = -result[node.left]; break;
+            case ADD:      result[t] = result[node.left] + result[node.right]; break;
+            case SUBTRACT: result[t] = result[node.left] - result[node.right]; break;
+            case MULTIPLY: result[t] = result[node.left] * result[node.right]; break;
+            default:       result[t] = result[node.left] / result[node.right];
+        }
+    }
+    return result[_root];
+}
+
+inline void ExpressionTree::evaluate( const std::vector<Column>& columns, std::size_t n, double* out ) const {
+    compile().evaluate(columns, n, out);
+}
+
+inline std::string ExpressionTree::infix() const {
+    std::ostringstream out;
+    _infix(out);
+    return out.str();
+}
+
+inline std::string ExpressionTree::postfix() const {
+    std::ostringstream out;
+    _postfix(out);
+    std::string s = out.str();
+    return s.empty() ? s : s.substr(1);
+}
+
+inline ExpressionTree::Program ExpressionTree::compile() const {
+    if (_root < 0) throw std::logic_error("ExpressionTree: compile of an empty tree");
+
+    // Number the distinct values bottom-up, in index order, so operands come
+    // before the values that use them and the result is the last value still
+    // needed.
+    std::map<std::tuple<int, std::uint64_t, int, int>, int> numbers;
+    std::vector<Value> values;
+    std::vector<int> number(_root + 1);
+    for (int t = 0; t <= _root; ++t) number[t] = _number(t, number, numbers, values);
+    int result = number[_root];
+
+    // Find the values the result needs (folding leaves some behind) and the
+    // last value that uses each of them.
+    std::vector<bool> live(result + 1, false);
+    std::vector<int> lastUse(result + 1, result + 1);
+    live[result] = true;
+    for (int k = result; k >= 0; --k) {
+        if (!live[k] || values[k].op < NEGATE) continue;
+        for (int operand : { values[k].left, values[k].right }) {
+            if (operand < 0) continue;
+            if (!live[operand]) lastUse[operand] = k;
+            live[operand] = true;
+        }
+    }
+
+    // Registers: the variables, the constants, then temporaries, each one
+    // reused once the value it holds has had its last use.
+    Program program;
+    program._numVariables = static_cast<int>(_variables.size());
+    std::vector<int> reg(result + 1, -1);
+    for (int k = 0; k <= result; ++k) {
+        if (live[k] && values[k].op == VARIABLE) reg[k] = values[k].variable;
+        if (live[k] && values[k].op == CONSTANT) {
+            reg[k] = program._numVariables + static_cast<int>(program._constants.size());
+            program._constants.push_back(values[k].constant);
+        }
+    }
+
+    int base = program._numVariables + static_cast<int>(program._constants.size());
+    std::vector<int> free;
+    program._numTemporaries = 0;
+    for (int k = 0; k <= result; ++k) {
+        const Value& v = values[k];
+        if (!live[k] || v.op < NEGATE) continue;
+        Program::Instruction instruction{ v.op, 0, reg[v.left], v.right >= 0 ? reg[v.right] : 0 };
+        // free the operands first, so the target may be one of them
+        for (int operand : { v.left, v.right }) {
+            if (operand >= 0 && lastUse[operand] == k && reg[operand] >= base) {
+                free.push_back(reg[operand]);
+                lastUse[operand] = -1;
+            }
+        }
+        if (free.empty()) free.push_back(base + program._numTemporaries++);
+        reg[k] = free.back();
+        free.pop_back();
+        instruction.target = reg[k];
+        program._code.push_back(instruction);
+    }
+    program._result = reg[result];
+    return program;
+}
+
+inline void ExpressionTree::Program::evaluate( const std::vector<Column>& columns, std::size_t n, double* out ) const {
+    if (columns.size() < static_cast<std::size_t>(_numVariables)) {
+        throw std::invalid_argument("ExpressionTree::Program: too few columns for the variables");
+    }
+    // scratch: a BLOCK for each constant, temporary and integer column
+    int numConstants = static_cast<int>(_constants.size());
+    int base = _numVariables + numConstants;
+    std::vector<double> scratch(static_cast<std::size_t>(numConstants + _numTemporaries + _numVariables) * BLOCK);
+    auto block = [&]( int k ) { return scratch.data() + static_cast<std::size_t>(k) * BLOCK; };
+    for (int c = 0; c < numConstants; ++c) std::fill(block(c), block(c + 1), _constants[c]);
+
+    std::vector<const double*> reg(base + _numTemporaries);
+    for (int r = _numVariables; r < base + _numTemporaries; ++r) reg[r] = block(r - _numVariables);
+
+    for (std::size_t start = 0; start < n; start += BLOCK) {
+        std::size_t length = std::min<std::size_t>(BLOCK, n - start);
+        for (int v = 0; v < _numVariables; ++v) {
+            if (columns[v]._doubles != nullptr) {
+                reg[v] = columns[v]._doubles + start;
+                continue;
+            }
+            double* x = block(numConstants + _numTemporaries + v);
+            const std::int64_t* integers = columns[v]._integers + start;
+            for (std::size_t i = 0; i < length; ++i) x[i] = static_cast<double>(integers[i]);
+            reg[v] = x;
+        }
+
+        for (std::size_t k = 0; k < _code.size(); ++k) {
+            const Instruction& instruction = _code[k];
+            // the last instruction computes the result: write it to out
+            double* t = k + 1 == _code.size() ? out + start : block(instruction.target - _numVariables);
+            const double* a = reg[instruction.left];
+            const double* b = reg[instruction.right];
+            switch (instruction.op) {
+                case NEGATE:   for (std::size_t i = 0; i < length; ++i) t[i] = -a[i]; break;
+                case ADD:      for (std::size_t i = 0; i < length; ++i) t[i] = a[i] + b[i]; break;
+                case SUBTRACT: for (std::size_t i = 0; i < length; ++i) t[i] = a[i] - b[i]; break;
+                case MULTIPLY: for (std::size_t i = 0; i < length; ++i) t[i] = a[i] * b[i]; break;
+                case DIVIDE:   for (std::size_t i = 0; i < length; ++i) t[i] = a[i] / b[i]; break;
+                default: break;
+            }
+        }
+        if (_code.empty()) std::copy(reg[_result], reg[_result] + length, out + start);
+    }
+}
+
+inline void ExpressionTree::Program::evaluate( const std::vector<const double*>& columns, std::size_t n, double* out ) const {
+    evaluate(std::vector<Column>(columns.begin(), columns.end()), n, out);
+}
+
+inline double ExpressionTree::Program::evaluate( const std::vector<double>& values ) const {
+    std::vector<Column> columns;
+    for (const double& x : values) columns.push_back(Column{ &x });
+    double result;
+    evaluate(columns, 1, &result);
+    return result;
+}
+
+inline int ExpressionTree::Program::numVariables() const {
+    return _numVariables;
+}
+
+inline int ExpressionTree::Program::numRegisters() const {
+    return _numVariables + static_cast<int>(_constants.size()) + _numTemporaries;
+}
+
+inline int ExpressionTree::Program::numInstructions() const {
+    return static_cast<int>(_code.size());
+}
+
+inline void ExpressionTree::Program::print( std::ostream& out ) const {
+    for (std::size_t c = 0; c < _constants.size(); ++c) {
+        out << "r" << _numVariables + c << " = " << _format(_constants[c]) << "\n";
+    }
+    const char* symbol = "  -+-*/";
+    for (const Instruction& instruction : _code) {
+        out << "r" << instruction.target << " = ";
+        if (instruction.op == NEGATE) out << "-r" << instruction.left << "\n";
+        else out << "r" << instruction.left << " " << symbol[instruction.op] << " r" << instruction.right << "\n";
+    }
+    out << "result r" << _result << "\n";
+}
+
+/******************************************************************************
+PRIVATE METHODS
+******************************************************************************/
+inline std::vector<ExpressionTree::Token> ExpressionTree::_tokenize( const std::string& expression ) {
+    std::vector<Token> tokens;
+    std::size_t i = 0;
+    while (i < expression.size()) {
+        char c = expression[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            ++i;
+        }
+        else if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            const char* begin = expression.c_str() + i;
+            char* end;
+            double value = std::strtod(begin, &end);
+            if (end == begin) throw std::invalid_argument("ExpressionTree: bad number at " + std::to_string(i));
+            std::size_t length = static_cast<std::size_t>(end - begin);
+            tokens.push_back(Token{ Token::NUMBER, value, expression.substr(i, length) });
+            i += length;
+        }
+        else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            std::size_t j = i;
+            while (j < expression.size() && (std::isalnum(static_cast<unsigned char>(expression[j])) || expression[j] == '_')) ++j;
+            tokens.push_back(Token{ Token::NAME, 0, expression.substr(i, j - i) });
+            i = j;
+        }
+        else if (std::strchr("+-*/~", c) != nullptr) {
+            tokens.push_back(Token{ Token::OPERATOR, 0, std::string(1, c) });
+            ++i;
+        }
+        else if (c == '(' || c == ')') {
+            tokens.push_back(Token{ c == '(' ? Token::LEFT : Token::RIGHT, 0, std::string(1, c) });
+            ++i;
+        }
+        else {
+            throw std::invalid_argument(std::string("ExpressionTree: unexpected ") + c);
+        }
+    }
+    return tokens;
+}
+
+inline int ExpressionTree::_precedence( char op ) {
+    switch (op) {
+        case '+': case '-': return 1;
+        case '*': case '/': return 2;
+        default:            return 3; // '~'
+    }
+}
+
+inline ExpressionTree::Op ExpressionTree::_binary( char op ) {
+    switch (op) {
+        case '+': return ADD;
+        case '-': return SUBTRACT;
+        case '*': return MULTIPLY;
+        default:  return DIVIDE;
+    }
+}
+
+// The shortest of 15 or 17 significant digits that reads back as x.
+inline std::string ExpressionTree::_format( double x ) {
+    std::ostringstream out;
+    out.precision(15);
+    out << x;
+    if (std::strtod(out.str().c_str(), nullptr) != x) {
+        out.str("");
+        out.precision(std::numeric_limits<double>::max_digits10);
+        out << x;
+    }
+    return out.str();
+}
+
+inline int ExpressionTree::_variable( const std::string& name ) {
+    auto it = std::find(_variables.begin(), _variables.end(), name);
+    if (it != _variables.end()) return static_cast<int>(it - _variables.begin());
+    _variables.push_back(name);
+    return static_cast<int>(_variables.size()) - 1;
+}
+
+inline int ExpressionTree::_leaf( const Token& token ) {
+    if (token.kind == Token::NUMBER) _nodes.push_back(Node{ CONSTANT, -1, -1, -1, token.value });
+    else _nodes.push_back(Node{ VARIABLE, _variable(token.text), -1, -1, 0 });
+    return static_cast<int>(_nodes.size()) - 1;
+}
+
+// Pop the operands of op from operands and return the tree of op on them.
+inline int ExpressionTree::_apply( char op, std::vector<int>& operands ) {
+    std::size_t arity = op == '~' ? 1 : 2;
+    if (operands.size() < arity) {
+        throw std::invalid_argument(std::string("ExpressionTree: missing operand of ") + op);
+    }
+    int right = operands.back();
+    operands.pop_back();
+    if (arity == 1) {
+        _nodes.push_back(Node{ NEGATE, -1, right, -1, 0 });
+    }
+    else {
+        int left = operands.back();
+        operands.pop_back();
+        _nodes.push_back(Node{ _binary(op), -1, left, right, 0 });
+    }
+    return static_cast<int>(_nodes.size()) - 1;
+}
+
+/*
+The tree can be as deep as it has nodes (a long sum is a left spine), so
+infix and postfix walk it with an explicit stack of (node, state) rather
+than recursion.
+*/
+inline void ExpressionTree::_infix( std::ostream& out ) const {
+    // state 0: before the node, 1: after its left operand, 2: after both
+    std::vector<std::pair<int, int>> stack;
+    if (_root >= 0) stack.emplace_back(_root, 0);
+    while (!stack.empty()) {
+        int t = stack.back().first, state = stack.back().second;
+        stack.pop_back();
+        const Node& node = _nodes[t];
+        switch (node.op) {
+            case CONSTANT: out << _format(node.value); break;
+            case VARIABLE: out << _variables[node.variable]; break;
+            default:
+                if (state == 0) {
+                    out << (node.op == NEGATE ? "(-" : "(");
+                    stack.emplace_back(t, node.op == NEGATE ? 2 : 1);
+                    stack.emplace_back(node.left, 0);
+                }
+                else if (state == 1) {
+                    out << " " << "  -+-*/"[node.op] << " ";
+                    stack.emplace_back(t, 2);
+                    stack.emplace_back(node.right, 0);
+                }
+                else {
+                    out << ")";
+                }
+        }
+    }
+}
+
+inline void ExpressionTree::_postfix( std::ostream& out ) const {
+    // (node, whether its operands have been written)
+    std::vector<std::pair<int, bool>> stack;
+    if (_root >= 0) stack.emplace_back(_root, false);
+    while (!stack.empty()) {
+        int t = stack.back().first;
+        bool done = stack.back().second;
+        stack.pop_back();
+        const Node& node = _nodes[t];
+        if (!done && node.left >= 0) {
+            stack.emplace_back(t, true);
+            if (node.right >= 0) stack.emplace_back(node.right, false);
+            stack.emplace_back(node.left, false);
+            continue;
+        }
+        switch (node.op) {
+            case CONSTANT: out << " " << _format(node.value); break;
+            case VARIABLE: out << " " << _variables[node.variable]; break;
+            case NEGATE:   out << " ~"; break;
+            default:       out << " " << "  -+-*/"[node.op];
+        }
+    }
+}
+
+/*
+@brief Value number of node t, whose children are numbered in number,
+       adding it to values if it is new. Constants are folded and
+       identities dropped before the lookup, so a node is keyed by what it
+       simplifies to.
+@return int
+*/
+inline int ExpressionTree::_number( int t, const std::vector<int>& number,
+                                    std::map<std::tuple<int, std::uint64_t, int, int>, int>& numbers,
+                                    std::vector<Value>& values ) const {
+    const Node& node = _nodes[t];
+    Value v{ node.op, node.value, node.variable, -1, -1 };
+    if (v.op >= NEGATE) {
+        v.left = number[node.left];
+        if (v.op != NEGATE) v.right = number[node.right];
+        const Value& a = values[v.left];
+        bool constantLeft = a.op == CONSTANT;
+        bool constantRight = v.right >= 0 && values[v.right].op == CONSTANT;
+        double b = constantRight ? values[v.right].constant : 0;
+
+        if (v.op == NEGATE && a.op == NEGATE) return a.left;
+        if (v.op == NEGATE && constantLeft) {
+            v = Value{ CONSTANT, -a.constant, -1, -1, -1 };
+        }
+        else if (constantLeft && constantRight) {
+            double x = v.op == ADD ? a.constant + b : v.op == SUBTRACT ? a.constant - b
+                       : v.op == MULTIPLY ? a.constant * b : a.constant / b;
+            v = Value{ CONSTANT, x, -1, -1, -1 };
+        }
+        else if (v.op == SUBTRACT && constantRight && b == 0 && !std::signbit(b)) return v.left;
+        else if ((v.op == MULTIPLY || v.op == DIVIDE) && constantRight && b == 1) return v.left;
+        else if (v.op == MULTIPLY && constantLeft && a.constant == 1) return v.right;
+        else if ((v.op == ADD || v.op == MULTIPLY) && v.left > v.right) std::swap(v.left, v.right); // commutative
+    }
+
+    std::uint64_t payload = 0;
+    if (v.op == CONSTANT) std::memcpy(&payload, &v.constant, sizeof v.constant);
+    if (v.op == VARIABLE) payload = static_cast<std::uint64_t>(v.variable);
+    auto key = std::make_tuple(static_cast<int>(v.op), payload, v.left, v.right);
+    auto it = numbers.find(key);
+    if (it != numbers.end()) return it->second;
+
+    values.push_back(v);
+    numbers.emplace(key, static_cast<int>(values.size()) - 1);
+    return static_cast<int>(values.size()) - 1;
+}
+
 #endif
@@ -0,0 +1,240 @@
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <stdexcept>
+#include <filesystem>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <system_error>
+
+#include "BinaryHeap.h"
+#include "RadixSort.h"
+
+/*
+External k-way merge sort of the lines of a text file that does not fit in
+memory (lecture 15). Pass 1 reads as many lines as fit in the memory
+budget, sorts them with americanFlagSort and writes them out as a sorted
+run, until the input is exhausted. The runs are then merged, at most
+fanIn at a time: a BinaryHeap holds the current line of every run, and
+each deleteMin writes the smallest line and refills the heap from the run
+it came from. When there are more runs than fanIn, merged runs are merged
+again, so N lines take 1 + ceil(log_fanIn(runs)) passes over the data.
+*/
+class ExternalSorter {
+    public:
+        /*
+        @brief memoryBytes bounds the text held in memory for one run.
+               Temporary runs go to tmpDir.
+        */
+        explicit ExternalSorter( std::size_t memoryBytes = std::size_t{ 64 } << 20, int fanIn = 64,
+                                 std::filesystem::path tmpDir = std::filesystem::temp_directory_path() );
+
+        /*
+        @brief Sort the lines of inputPath into outputPath. The temporary
+               runs are removed also when the sort throws.
+        @throw std::runtime_error if a file cannot be opened, read or
+               written
+        @return void
+        */
+        void sort( const std::string& inputPath, const std::string& outputPath );
+
+        // Return the number of runs written by pass 1 of the last sort.
+        int numRuns() const;
+
+        // Return the number of merge passes of the last sort.
+        int numMergePasses() const;
+
+    private:
+        // The current line of a run, ordered by line for the heap.
+        struct RunHead {
+            std::string line;
+            int run = 0;
+
+            bool operator<( const RunHead& rhs ) const { return line < rhs.line; }
+        };
+
+        // Names of temporary files, which are removed when it goes out of
+        // scope, whether the sort finishes or throws.
+        struct TempFiles {
+            std::vector<std::string> paths;
+
+            TempFiles() = default;
+            TempFiles( const TempFiles& rhs ) = delete;
+            TempFiles& operator=( const TempFiles& rhs ) = delete;
+            ~TempFiles() {
+                std::error_code ignored;
+                for (const auto& path : paths) std::filesystem::remove(path, ignored);
+            }
+        };
+
+        std::size_t _memoryBytes;
+        int _fanIn;
+        std::filesystem::path _tmpDir;
+        int _numRuns;
+        int _numMergePasses;
+        int _nextFile;
+
+        // Create a fresh name for a temporary run file, to be removed by temps.
+        std::string _tmpName( TempFiles& temps );
+
+        // Write sorted runs of the input, returning their file names.
+        std::vector<std::string> _makeRuns( std::istream& in, TempFiles& temps );
+
+        // Merge the sorted files runs into out, and close it.
+        void _merge( const std::vector<std::string>& runs, std::ofstream& out );
+
+        static std::ifstream _openIn( const std::string& path );
+        static std::ofstream _openOut( const std::string& path );
+        // Close out; throw if any write to it failed, including the final flush.
+        static void _close( std::ofstream& out );
+};
+
+inline ExternalSorter::ExternalSorter( std::size_t memoryBytes, int fanIn, std::filesystem::path tmpDir )
+    : _memoryBytes{ memoryBytes },
+      _fanIn{ fanIn < 2 ? 2 : fanIn },
+      _tmpDir{ std::move(tmpDir) },
+      _numRuns{ 0 },
+      _numMergePasses{ 0 },
+      _nextFile{ 0 }
+{ }
+
+inline void ExternalSorter::sort( const std::string& inputPath, const std::string& outputPath ) {
+    _numMergePasses = 0;
+
+    TempFiles temps;
+    std::vector<std::string> runs;
+    {
+        std::ifstream in = _openIn(inputPath);
+        runs = _makeRuns(in, temps);
+    }
+    _numRuns = static_cast<int>(runs.size());
+
+    // merge groups of fanIn runs until one pass can finish the job
+    while (static_cast<int>(runs.size()) > _fanIn) {
+        std::vector<std::string> merged;
+        for (std::size_t i = 0; i < runs.size(); i += _fanIn) {
+            std::vector<std::string> group(runs.begin() + i,
+                                           runs.begin() + std::min(runs.size(), i + _fanIn));
+            merged.push_back(_tmpName(temps));
+            {
+                std::ofstream out = _openOut(merged.back());
+                _merge(group, out);
+            }
+            for (const auto& path : group) std::filesystem::remove(path);
+        }
+        runs.swap(merged);
+        _numMergePasses += 1;
+    }
+
+    {
+        std::ofstream out = _openOut(outputPath);
+        _merge(runs, out);
+    }
+    _numMergePasses += 1;
+}
+
+inline int ExternalSorter::numRuns() const {
+    return _numRuns;
+}
+
+inline int ExternalSorter::numMergePasses() const {
+    return _numMergePasses;
+}
+
+inline std::string ExternalSorter::_tmpName( TempFiles& temps ) {
+    auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::string name = "external-sort-" + std::to_string(stamp) + "-"
+                     + std::to_string(reinterpret_cast<std::uintptr_t>(this)) + "-"
+                     + std::to_string(_nextFile++) + ".run";
+    temps.paths.push_back((_tmpDir / name).string());
+    return temps.paths.back();
+}
+
+inline std::vector<std::string> ExternalSorter::_makeRuns( std::istream& in, TempFiles& temps ) {
+    std::vector<std::string> runs;
+    std::vector<std::string> lines;
+    std::string line;
+    std::size_t bytes = 0;
+    bool more = true;
+
+    while (more) {
+        more = static_cast<bool>(std::getline(in, line));
+        if (!more && in.bad()) {
+            throw std::runtime_error("ExternalSorter: read failed");
+        }
+        if (more) {
+            bytes += line.size() + sizeof(std::string);
+            lines.push_back(std::move(line));
+        }
+
+        if (!lines.empty() && (!more || bytes >= _memoryBytes)) {
+            americanFlagSort(lines.begin(), lines.end());
+            runs.push_back(_tmpName(temps));
+            std::ofstream out = _openOut(runs.back());
+            for (const auto& l : lines) out << l << '\n';
+            _close(out);
+            lines.clear();
+            bytes = 0;
+        }
+    }
+    return runs;
+}
+
+inline void ExternalSorter::_merge( const std::vector<std::string>& runs, std::ofstream& out ) {
+    std::vector<std::ifstream> files;
+    BinaryHeap<RunHead> heap{ static_cast<int>(runs.size()) };
+
+    for (std::size_t r = 0; r < runs.size(); ++r) {
+        files.push_back(_openIn(runs[r]));
+        RunHead head;
+        head.run = static_cast<int>(r);
+        if (std::getline(files.back(), head.line)) {
+            heap.insert(std::move(head));
+        }
+    }
+
+    RunHead head;
+    while (!heap.isEmpty()) {
+        heap.deleteMin(head);
+        out << head.line << '\n';
+        if (std::getline(files[head.run], head.line)) {
+            heap.insert(std::move(head));
+        }
+    }
+    // getline stops on a read error as it does at the end of the file
+    for (const auto& file : files) {
+        if (file.bad()) throw std::runtime_error("ExternalSorter: read failed");
+    }
+    _close(out);
+}
+
+inline std::ifstream ExternalSorter::_openIn( const std::string& path ) {
+    std::ifstream in{ path };
+    if (!in) {
+        throw std::runtime_error("ExternalSorter: cannot open " + path);
+    }
+    return in;
+}
+
+inline std::ofstream ExternalSorter::_openOut( const std::string& path ) {
+    std::ofstream out{ path };
+    if (!out) {
+        throw std::runtime_error("ExternalSorter: cannot create " + path);
+    }
+    return out;
+}
+
+inline void ExternalSorter::_close( std::ofstream& out ) {
+    out.close();
+    if (!out) {
+        throw std::runtime_error("ExternalSorter: write failed");
+    }
+}
+
+#endif
@@ -0,0 +1,509 @@
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
+#include "IndexedBinaryHeap.h"
+
+typedef int Vertex;
+
+const Vertex NOT_A_VERTEX = -1;
+
+/*
+Directed graph in compressed sparse row (CSR) form. The edges leaving
+vertex v are edges _offsets[v] .. _offsets[v + 1] - 1; edge e goes to
+_targets[e] and, in a weighted graph, costs _weights[e]. The whole graph is
+three flat arrays, so scanning the neighbours of a vertex is a sequential
+read instead of a walk over list nodes. Graphs are immutable; build them
+with GraphBuilder or loadEdgeList.
+*/
+template<typename Weight = long long>
+class Graph {
+    public:
+        // The neighbours of a vertex, for range-based for loops.
+        struct Range {
+            const Vertex* first;
+            const Vertex* last;
+
+            const Vertex* begin() const { return first; }
+            const Vertex* end() const { return last; }
+        };
+
+        Graph() : _offsets( 1, 0 ) {}
+
+        // Return the number of vertices.
+        int numVertices() const;
+
+        // Return the number of edges.
+        std::int64_t numEdges() const;
+
+        // Check if the edges carry weights.
+        bool isWeighted() const;
+
+        // Return the number of edges leaving v.
+        int outDegree( Vertex v ) const;
+
+        // Return the vertices adjacent to v.
+        Range adjacent( Vertex v ) const;
+
+        // Return the first edge of v and one past its last edge.
+        std::int64_t edgesBegin( Vertex v ) const;
+        std::int64_t edgesEnd( Vertex v ) const;
+
+        // Return the head and the weight of edge e (1 if unweighted).
+        Vertex target( std::int64_t e ) const;
+        Weight weight( std::int64_t e ) const;
+
+        // The raw arrays, for algorithms that split the work by hand.
+        const std::int64_t* offsets() const { return _offsets.data(); }
+        const Vertex* targets() const { return _targets.data(); }
+        const Weight* weights() const { return _weights.empty() ? nullptr : _weights.data(); }
+
+        // Return the graph with every edge reversed.
+        Graph transpose() const;
+
+    private:
+        template<typename W> friend class GraphBuilder;
+
+        std::vector<std::int64_t> _offsets; // numVertices + 1 entries
+        std::vector<Vertex> _targets;       // numEdges entries
+        std::vector<Weight> _weights;       // numEdges entries, or none
+};
+
+/*
+Collects edges in any order and builds a Graph from them with a counting
+sort by source vertex, in O(V + E) time. Edges leaving the same vertex
+keep the order in which they were added.
+*/
+template<typename Weight = long long>
+class GraphBuilder {
+    public:
+        // numVertices grows as needed to cover every vertex of an edge.
+        explicit GraphBuilder( int numVertices = 0 );
+
+        void reserve( std::int64_t numEdges );
+
+        // Add an unweighted edge; the graph is weighted if any edge is.
+        void addEdge( Vertex from, Vertex to );
+        void addEdge( Vertex from, Vertex to, Weight w );
+
+        // Return the number of vertices so far.
+        int numVertices() const;
+
+        // Build the graph. The builder is left empty.
+        Graph<Weight> build();
+
+    private:
+        int _numVertices;
+        bool _weighted;
+        std::vector<Vertex> _from;
+        std::vector<Vertex> _to;
+        std::vector<Weight> _weights;
+};
+
+/*
+The output of the single-source shortest-path routines: for every vertex
+its distance from the source (INFINITY_DISTANCE if unreachable) and the
+vertex before it on a shortest path (NOT_A_VERTEX for the source and for
+unreachable vertices).
+*/
+template<typename Distance>
+struct ShortestPaths {
+    static constexpr Distance INFINITY_DISTANCE = std::numeric_limits<Distance>::max();
+
+    std::vector<Distance> dist;
+    std::vector<Vertex> path;
+
+    // Return the vertices of a shortest path from the source to v, or
+    // nothing if v is unreachable.
+    std::vector<Vertex> pathTo( Vertex v ) const;
+};
+
+// Thrown by topsort when the graph has a cycle.
+class CycleFoundException : public std::runtime_error {
+    public:
+        CycleFoundException() : std::runtime_error( "the graph has a cycle" ) {}
+};
+
+/*
+@brief Topological order of the vertices (lecture 17): vertices of
+       indegree 0 are queued, and removing a vertex from the queue
+       decrements the indegree of its neighbours. O(V + E).
+@throw CycleFoundException if the graph is not acyclic
+@return std::vector<Vertex>
+*/
+template<typename Weight>
+std::vector<Vertex> topsort( const Graph<Weight>& g );
+
+/*
+@brief Unweighted shortest paths from s by breadth-first search
+       (lecture 17), with a queue in place of the scans for vertices at
+       the current distance. O(V + E).
+@return ShortestPaths<int>, distances in edges
+*/
+template<typename Weight>
+ShortestPaths<int> unweighted( const Graph<Weight>& g, Vertex s );
+
+/*
+@brief Dijkstra's algorithm from s (lecture 18). The unknown vertices wait
+       in an IndexedBinaryHeap, so the smallest unknown distance is a
+       deleteMin and an update is a decreaseKey. O(E log V). Weights must
+       not be negative.
+@return ShortestPaths<Weight>
+*/
+template<typename Weight>
+ShortestPaths<Weight> dijkstra( const Graph<Weight>& g, Vertex s );
+
+/*
+@brief Load a graph from a text file of edges, one "from to" or, if
+       weighted, "from to weight" per line. Lines starting with '#' or
+       '%' are comments. The file is read in large blocks and parsed by
+       hand, so loading runs at disk speed rather than stream speed.
+@throw std::runtime_error if the file cannot be read or a line is
+       malformed, including trailing text after the edge
+@return Graph<Weight>
+*/
+template<typename Weight = long long>
+Graph<Weight> loadEdgeList( const std::string& path, bool weighted );
+
+template<typename Weight>
+int Graph<Weight>::numVertices() const {
+    return static_cast<int>(_offsets.size()) - 1;
+}
+
+template<typename Weight>
+std::int64_t Graph<Weight>::numEdges() const {
+    return static_cast<std::int64_t>(_targets.size());
+}
+
+template<typename Weight>
+bool Graph<Weight>::isWeighted() const {
+    return !_weights.empty();
+}
+
+template<typename Weight>
+int Graph<Weight>::outDegree( Vertex v ) const {
+    return static_cast<int>(_offsets[v + 1] - _offsets[v]);
+}
+
+template<typename Weight>
+typename Graph<Weight>::Range Graph<Weight>::adjacent( Vertex v ) const {
+    return Range{ _targets.data() + _offsets[v], _targets.data() + _offsets[v + 1] };
+}
+
+template<typename Weight>
+std::int64_t Graph<Weight>::edgesBegin( Vertex v ) const {
+    return _offsets[v];
+}
+
+template<typename Weight>
+std::int64_t Graph<Weight>::edgesEnd( Vertex v ) const {
+    return _offsets[v + 1];
+}
+
+template<typename Weight>
+Vertex Graph<Weight>::target( std::int64_t e ) const {
+    return _targets[e];
+}
+
+template<typename Weight>
+Weight Graph<Weight>::weight( std::int64_t e ) const {
+    return _weights.empty() ? Weight{ 1 } : _weights[e];
+}
+
+template<typename Weight>
+Graph<Weight> Graph<Weight>::transpose() const {
+    GraphBuilder<Weight> builder{ numVertices() };
+    builder.reserve(numEdges());
+    for (Vertex v = 0; v < numVertices(); ++v) {
+        for (std::int64_t e = _offsets[v]; e < _offsets[v + 1]; ++e) {
+            if (_weights.empty()) builder.addEdge(_targets[e], v);
+            else                  builder.addEdge(_targets[e], v, _weights[e]);
+        }
+    }
+    return builder.build();
+}
+
+template<typename Weight>
+GraphBuilder<Weight>::GraphBuilder( int numVertices )
+    : _numVertices{ numVertices }, _weighted{ false }
+{ }
+
+template<typename Weight>
+void GraphBuilder<Weight>::reserve( std::int64_t numEdges ) {
+    _from.reserve(numEdges);
+    _to.reserve(numEdges);
+}
+
+template<typename Weight>
+void GraphBuilder<Weight>::addEdge( Vertex from, Vertex to ) {
+    if (from < 0 || to < 0) {
+        throw std::invalid_argument("GraphBuilder: negative vertex");
+    }
+    _from.push_back(from);
+    _to.push_back(to);
+    if (_weighted) _weights.push_back(Weight{ 1 });
+    if (from >= _numVertices) _numVertices = from + 1;
+    if (to >= _numVertices) _numVertices = to + 1;
+}
+
+template<typename Weight>
+void GraphBuilder<Weight>::addEdge( Vertex from, Vertex to, Weight w ) {
+    if (!_weighted) {
+        // earlier unweighted edges cost 1
+        _weights.reserve(_from.capacity());
+        _weights.assign(_from.size(), Weight{ 1 });
+        _weighted = true;
+    }
+    addEdge(from, to);
+    _weights.back() = w;
+}
+
+template<typename Weight>
+int GraphBuilder<Weight>::numVertices() const {
+    return _numVertices;
+}
+
+template<typename Weight>
+Graph<Weight> GraphBuilder<Weight>::build() {
+    Graph<Weight> g;
+    std::int64_t m = static_cast<std::int64_t>(_from.size());
+
+    g._offsets.assign(_numVertices + 1, 0);
+    for (Vertex v : _from) g._offsets[v + 1] += 1;
+    for (int v = 0; v < _numVertices; ++v) g._offsets[v + 1] += g._offsets[v];
+
+    std::vector<std::int64_t> next(g._offsets.begin(), g._offsets.end() - 1);
+    g._targets.resize(m);
+    if (_weighted) g._weights.resize(m);
+    for (std::int64_t i = 0; i < m; ++i) {
+        std::int64_t e = next[_from[i]]++;
+        g._targets[e] = _to[i];
+        if (_weighted) g._weights[e] = _weights[i];
+    }
+
+    *this = GraphBuilder{ 0 };
+    return g;
+}
+
+template<typename Distance>
+std::vector<Vertex> ShortestPaths<Distance>::pathTo( Vertex v ) const {
+    std::vector<Vertex> result;
+    if (dist[v] == INFINITY_DISTANCE) return result;
+
+    for (; v != NOT_A_VERTEX; v = path[v]) {
+        result.push_back(v);
+    }
+    return std::vector<Vertex>(result.rbegin(), result.rend());
+}
+
+template<typename Weight>
+std::vector<Vertex> topsort( const Graph<Weight>& g ) {
+    int n = g.numVertices();
+    std::vector<int> indegree(n, 0);
+    for (std::int64_t e = 0; e < g.numEdges(); ++e) {
+        indegree[g.target(e)] += 1;
+    }
+
+    // the output doubles as the queue: vertices are numbered as they are
+    // dequeued, in the order they were enqueued
+    std::vector<Vertex> order;
+    order.reserve(n);
+    for (Vertex v = 0; v < n; ++v) {
+        if (indegree[v] == 0) order.push_back(v);
+    }
+
+    for (std::size_t head = 0; head < order.size(); ++head) {
+        for (Vertex w : g.adjacent(order[head])) {
+            if (--indegree[w] == 0) order.push_back(w);
+        }
+    }
+
+    if (static_cast<int>(order.size()) != n) {
+        throw CycleFoundException{};
+    }
+    return order;
+}
+
+template<typename Weight>
+ShortestPaths<int> unweighted( const Graph<Weight>& g, Vertex s ) {
+    int n = g.numVertices();
+    ShortestPaths<int> result;
+    result.dist.assign(n, ShortestPaths<int>::INFINITY_DISTANCE);
+    result.path.assign(n, NOT_A_VERTEX);
+
+    std::vector<Vertex> queue;
+    queue.reserve(n);
+    result.dist[s] = 0;
+    queue.push_back(s);
+
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        Vertex v = queue[head];
+        for (Vertex w : g.adjacent(v)) {
+            if (result.dist[w] == ShortestPaths<int>::INFINITY_DISTANCE) {
+                result.dist[w] = result.dist[v] + 1;
+                result.path[w] = v;
+                queue.push_back(w);
+            }
+        }
+    }
+    return result;
+}
+
+template<typename Weight>
+ShortestPaths<Weight> dijkstra( const Graph<Weight>& g, Vertex s ) {
+    typedef std::pair<Weight, Vertex> Entry; // (distance, vertex)
+    typedef typename IndexedBinaryHeap<Entry>::Handle Handle;
+    const Handle NOT_QUEUED = -1;
+
+    int n = g.numVertices();
+    ShortestPaths<Weight> result;
+    result.dist.assign(n, ShortestPaths<Weight>::INFINITY_DISTANCE);
+    result.path.assign(n, NOT_A_VERTEX);
+
+    std::vector<Handle> handle(n, NOT_QUEUED);
+    std::vector<bool> known(n, false);
+    IndexedBinaryHeap<Entry> pq{};
+
+    result.dist[s] = 0;
+    handle[s] = pq.insert(Entry{ 0, s });
+
+    Entry e;
+    while (!pq.isEmpty()) {
+        pq.deleteMin(e);
+        Vertex v = e.second;
+        handle[v] = NOT_QUEUED;
+        known[v] = true;
+
+        for (std::int64_t i = g.edgesBegin(v); i < g.edgesEnd(v); ++i) {
+            Vertex w = g.target(i);
+            if (known[w]) continue;
+
+            Weight d = e.first + g.weight(i);
+            if (d < result.dist[w]) {
+                result.dist[w] = d;
+                result.path[w] = v;
+                if (handle[w] == NOT_QUEUED) {
+                    handle[w] = pq.insert(Entry{ d, w });
+                }
+                else {
+                    pq.decreaseKey(handle[w], Entry{ d, w });
+                }
+            }
+        }
+    }
+    return result;
+}
+
+namespace graph_detail {
+    // Parse a non-negative integer at p, advancing p past it.
+    inline bool parseVertex( const char*& p, const char* end, Vertex& v ) {
+        while (p < end && (*p == ' ' || *p == '\t')) ++p;
+        if (p == end || *p < '0' || *p > '9') return false;
+
+        std::int64_t x = 0;
+        for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+            x = 10 * x + (*p - '0');
+            if (x > std::numeric_limits<Vertex>::max()) return false;
+        }
+        v = static_cast<Vertex>(x);
+        return true;
+    }
+
+    template<typename Weight>
+    bool parseWeight( const char*& p, const char* end, Weight& w ) {
+        while (p < end && (*p == ' ' || *p == '\t')) ++p;
+        if (p == end) return false;
+
+        // the line is copied so strtod and strtoll stop at its end
+        char buffer[64];
+        std::size_t len = 0;
+        while (p + len < end && len < sizeof(buffer) - 1 && p[len] != ' ' && p[len] != '\t'
+               && p[len] != '\r') {
+            buffer[len] = p[len];
+            ++len;
+        }
+        buffer[len] = '\0';
+
+        char* stop;
+        if (std::is_integral<Weight>::value) {
+            w = static_cast<Weight>(std::strtoll(buffer, &stop, 10));
+        }
+        else {
+            w = static_cast<Weight>(std::strtod(buffer, &stop));
+        }
+        p += len;
+        return len > 0 && stop == buffer + len;
+    }
+}
+
+template<typename Weight>
+Graph<Weight> loadEdgeList( const std::string& path, bool weighted ) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::runtime_error("loadEdgeList: cannot open " + path);
+    }
+
+    GraphBuilder<Weight> builder{};
+    std::vector<char> block(std::size_t{ 1 } << 22);
+    std::size_t carry = 0;     // bytes of an unfinished line kept from the last block
+    std::int64_t lineNumber = 0;
+    bool atEnd = false;
+
+    while (!atEnd) {
+        std::size_t got = std::fread(block.data() + carry, 1, block.size() - carry, file);
+        atEnd = got < block.size() - carry;
+        std::size_t size = carry + got;
+        if (atEnd && size > 0 && block[size - 1] != '\n') {
+            block.resize(size + 1);
+            block[size++] = '\n'; // terminate the last line
+        }
+
+        const char* p = block.data();
+        const char* end = block.data() + size;
+        while (true) {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (eol == nullptr) break;
+
+            lineNumber += 1;
+            const char* q = p;
+            while (q < eol && (*q == ' ' || *q == '\t' || *q == '\r')) ++q;
+            if (q < eol && *q != '#' && *q != '%') {
+                Vertex from, to;
+                Weight w{ 1 };
+                bool ok = graph_detail::parseVertex(q, eol, from) && graph_detail::parseVertex(q, eol, to)
+                          && (!weighted || graph_detail::parseWeight(q, eol, w));
+                while (q < eol && (*q == ' ' || *q == '\t' || *q == '\r')) ++q;
+                if (!ok || q != eol) {
+                    std::fclose(file);
+                    throw std::runtime_error("loadEdgeList: malformed line " + std::to_string(lineNumber)
+                                             + " in " + path);
+                }
+                if (weighted) builder.addEdge(from, to, w);
+                else          builder.addEdge(from, to);
+            }
+            p = eol + 1;
+        }
+
+        carry = end - p;
+        std::copy(p, end, block.data());
+        if (carry == block.size()) {
+            block.resize(2 * block.size()); // a line longer than the block
+        }
+    }
+
+    std::fclose(file);
+    return builder.build();
+}
+
+#endif
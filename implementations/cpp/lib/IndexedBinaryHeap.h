@@ -0,0 +1,278 @@
+#ifndef INDEXED_BINARY_HEAP_H
+#define INDEXED_BINARY_HEAP_H
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+
+/*
+Addressable binary heap (lecture 12). insert returns a handle that stays
+valid until its item leaves the heap; handles of removed items are reused.
+Each entry records its handle and a position table maps handles back to
+heap positions, so decreaseKey, increaseKey and remove run in O(log n)
+instead of leaving stale duplicates behind.
+*/
+template<typename Comparable>
+class IndexedBinaryHeap {
+    public:
+        using Handle = int;
+
+        explicit IndexedBinaryHeap( int capacity = 100 );
+
+        // Find the minimum item in the heap.
+        const Comparable& findMin() const;
+
+        // Return the handle of the minimum item.
+        Handle findMinHandle() const;
+
+        // Insert item x, allowing duplicates. Return its handle.
+        Handle insert( const Comparable& x );
+        Handle insert( Comparable&& x );
+
+        // Remove the minimum item.
+        void deleteMin();
+
+        // Remove the minimum item and place it in minItem.
+        void deleteMin( Comparable& minItem );
+
+        // Return the item with handle h.
+        const Comparable& get( Handle h ) const;
+
+        // Check if handle h refers to an item in the heap.
+        bool contains( Handle h ) const;
+
+        // Lower the item with handle h to newValue, which must not be larger.
+        void decreaseKey( Handle h, const Comparable& newValue );
+
+        // Raise the item with handle h to newValue, which must not be smaller.
+        void increaseKey( Handle h, const Comparable& newValue );
+
+        // Remove the item with handle h.
+        void remove( Handle h );
+
+        // Check if heap is empty.
+        bool isEmpty() const;
+
+        // Return the number of items in the heap.
+        int size() const;
+
+        // Empty the heap. Every handle becomes invalid.
+        void makeEmpty();
+
+    private:
+        struct Entry {
+            Comparable item;
+            Handle handle;
+        };
+
+        int _currentSize;              // number of elements in heap
+        std::vector<Entry> _array;     // the heap array, 1-indexed
+        std::vector<int> _positions;   // heap position of each handle, 0 if free
+        std::vector<Handle> _free;     // handles available for reuse
+
+        template<typename T>
+        Handle _insert( T&& x );
+
+        // Store entry e at position hole and record where its handle is.
+        void _place( int hole, Entry&& e );
+
+        // Percolate up in the heap.
+        // hole is the index at which the percolate begins.
+        void _percolateUp( int hole );
+
+        // Percolate down in the heap.
+        // hole is the index at which the percolate begins.
+        void _percolateDown( int hole );
+
+        void _checkHandle( Handle h ) const;
+        void _checkNotEmpty() const;
+};
+
+template<typename Comparable>
+IndexedBinaryHeap<Comparable>::IndexedBinaryHeap( int capacity )
+    : _currentSize{ 0 }, _array( capacity + 1 )
+{ }
+
+template<typename Comparable>
+bool IndexedBinaryHeap<Comparable>::isEmpty() const {
+    return _currentSize == 0;
+}
+
+template<typename Comparable>
+int IndexedBinaryHeap<Comparable>::size() const {
+    return _currentSize;
+}
+
+template<typename Comparable>
+const Comparable& IndexedBinaryHeap<Comparable>::findMin() const {
+    _checkNotEmpty();
+    return _array[1].item;
+}
+
+template<typename Comparable>
+typename IndexedBinaryHeap<Comparable>::Handle IndexedBinaryHeap<Comparable>::findMinHandle() const {
+    _checkNotEmpty();
+    return _array[1].handle;
+}
+
+template<typename Comparable>
+typename IndexedBinaryHeap<Comparable>::Handle IndexedBinaryHeap<Comparable>::insert( const Comparable& x ) {
+    return _insert(x);
+}
+
+template<typename Comparable>
+typename IndexedBinaryHeap<Comparable>::Handle IndexedBinaryHeap<Comparable>::insert( Comparable&& x ) {
+    return _insert(std::move(x));
+}
+
+template<typename Comparable>
+void IndexedBinaryHeap<Comparable>::deleteMin() {
+    _checkNotEmpty();
+    remove(_array[1].handle);
+}
+
+template<typename Comparable>
+void IndexedBinaryHeap<Comparable>::deleteMin( Comparable& minItem ) {
+    _checkNotEmpty();
+    minItem = std::move(_array[1].item);
+    remove(_array[1].handle);
+}
+
+template<typename Comparable>
+const Comparable& IndexedBinaryHeap<Comparable>::get( Handle h ) const {
+    _checkHandle(h);
+    return _array[_positions[h]].item;
+}
+
+template<typename Comparable>
+bool IndexedBinaryHeap<Comparable>::contains( Handle h ) const {
+    return h >= 0 && h < static_cast<int>(_positions.size()) && _positions[h] != 0;
+}
+
+template<typename Comparable>
+void IndexedBinaryHeap<Comparable>::decreaseKey( Handle h, const Comparable& newValue ) {
+    _checkHandle(h);
+    int hole = _positions[h];
+    _array[hole].item = newValue;
+    _percolateUp(hole);
+}
+
+template<typename Comparable>
+void IndexedBinaryHeap<Comparable>::increaseKey( Handle h, const Comparable& newValue ) {
+    _checkHandle(h);
+    int hole = _positions[h];
+    _array[hole].item = newValue;
+    _percolateDown(hole);
+}
+
+/*
+The last entry fills the hole and then moves up or down, whichever restores
+heap order.
+*/
+template<typename Comparable>
+void IndexedBinaryHeap<Comparable>::remove( Handle h ) {
+    _checkHandle(h);
+    int hole = _positions[h];
+    _positions[h] = 0;
+    _free.push_back(h);
+
+    if (hole != _currentSize) {
+        _place(hole, std::move(_array[_currentSize--]));
+        if (hole > 1 && _array[hole].item < _array[hole / 2].item) {
+            _percolateUp(hole);
+        }
+        else {
+            _percolateDown(hole);
+        }
+    }
+    else {
+        _currentSize -= 1;
+    }
+}
+
+template<typename Comparable>
+void IndexedBinaryHeap<Comparable>::makeEmpty() {
+    _currentSize = 0;
+    _positions.clear();
+    _free.clear();
+}
+
+template<typename Comparable>
+template<typename T>
+typename IndexedBinaryHeap<Comparable>::Handle IndexedBinaryHeap<Comparable>::_insert( T&& x ) {
+    if (_currentSize == static_cast<int>(_array.size()) - 1) {
+        _array.resize(_array.size() * 2);
+    }
+
+    Handle h;
+    if (!_free.empty()) {
+        h = _free.back();
+        _free.pop_back();
+    }
+    else {
+        h = static_cast<Handle>(_positions.size());
+        _positions.push_back(0);
+    }
+
+    _currentSize += 1;
+    _place(_currentSize, Entry{ std::forward<T>(x), h });
+    _percolateUp(_currentSize);
+    return h;
+}
+
+template<typename Comparable>
+void IndexedBinaryHeap<Comparable>::_place( int hole, Entry&& e ) {
+    _positions[e.handle] = hole;
+    _array[hole] = std::move(e);
+}
+
+template<typename Comparable>
+void IndexedBinaryHeap<Comparable>::_percolateUp( int hole ) {
+    Entry tmp = std::move(_array[hole]);
+
+    for (; hole > 1 && tmp.item < _array[hole / 2].item; hole /= 2) {
+        _place(hole, std::move(_array[hole / 2]));
+    }
+
+    _place(hole, std::move(tmp));
+}
+
+template<typename Comparable>
+void IndexedBinaryHeap<Comparable>::_percolateDown( int hole ) {
+    int child;
+    Entry tmp = std::move(_array[hole]);
+
+    for (; hole * 2 <= _currentSize; hole = child) {
+        child = hole * 2;
+        if (child != _currentSize && _array[child + 1].item < _array[child].item) {
+            child++;
+        }
+
+        if (_array[child].item < tmp.item) {
+            _place(hole, std::move(_array[child]));
+        }
+        else {
+            break;
+        }
+    }
+
+    _place(hole, std::move(tmp));
+}
+
+template<typename Comparable>
+void IndexedBinaryHeap<Comparable>::_checkHandle( Handle h ) const {
+    if (!contains(h)) {
+        std::cout << "Error: Invalid handle " << h << "\n";
+        std::abort();
+    }
+}
+
+template<typename Comparable>
+void IndexedBinaryHeap<Comparable>::_checkNotEmpty() const {
+    if (isEmpty()) {
+        std::cout << "Error: Underflow\n";
+        std::abort();
+    }
+}
+
+#endif
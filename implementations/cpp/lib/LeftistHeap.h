@@ -0,0 +1,192 @@
+#ifndef LEFTIST_HEAP_H
+#define LEFTIST_HEAP_H
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include "NodePool.h"
+
+/*
+Leftist heap (lecture 13). For every node the null path length of the left
+child is at least that of the right child, so the right path has at most
+log(n + 1) nodes and merge, which only walks right paths, is O(log n).
+insert and deleteMin are both merges.
+*/
+template<typename Comparable>
+class LeftistHeap {
+    public:
+        LeftistHeap();
+        LeftistHeap( const LeftistHeap& rhs ) = delete;            // heaps are merged, not copied
+        LeftistHeap( LeftistHeap&& rhs );                          // move constructor
+        LeftistHeap& operator=( const LeftistHeap& rhs ) = delete;
+        LeftistHeap& operator=( LeftistHeap&& rhs );               // move assignment
+        ~LeftistHeap();
+
+        // Find the minimum item in the heap.
+        const Comparable& findMin() const;
+
+        // Insert item x, allowing duplicates.
+        void insert( const Comparable& x );
+        void insert( Comparable&& x );
+
+        // Remove the minimum item.
+        void deleteMin();
+
+        // Remove the minimum item and place it in minItem.
+        void deleteMin( Comparable& minItem );
+
+        // Merge rhs into this heap in O(log n); rhs becomes empty.
+        void merge( LeftistHeap& rhs );
+
+        // Check if heap is empty.
+        bool isEmpty() const;
+
+        // Empty the heap.
+        void makeEmpty();
+
+    private:
+        struct LeftistNode {
+            Comparable   item;
+            LeftistNode* left;
+            LeftistNode* right;
+            int          npl;   // null path length
+
+            LeftistNode( const Comparable& item, LeftistNode* left = nullptr, LeftistNode* right = nullptr, int npl = 0 )
+                : item{ item }, left{ left }, right{ right }, npl{ npl } {}
+            LeftistNode( Comparable&& item, LeftistNode* left = nullptr, LeftistNode* right = nullptr, int npl = 0 )
+                : item{ std::move(item) }, left{ left }, right{ right }, npl{ npl } {}
+        };
+
+        LeftistNode* _root;
+
+        NodePool<LeftistNode> _pool;   // takes over the pool of rhs on merge
+
+        // Merge two roots; return the new root.
+        LeftistNode* _merge( LeftistNode* h1, LeftistNode* h2 );
+
+        // Merge h2 into h1, whose root is the smaller one.
+        LeftistNode* _merge1( LeftistNode* h1, LeftistNode* h2 );
+
+        void _checkNotEmpty() const;
+};
+
+template<typename Comparable>
+LeftistHeap<Comparable>::LeftistHeap() : _root{ nullptr } {}
+
+template<typename Comparable>
+LeftistHeap<Comparable>::LeftistHeap( LeftistHeap&& rhs ) : _root{ rhs._root }, _pool{ std::move(rhs._pool) } {
+    rhs._root = nullptr;
+}
+
+template<typename Comparable>
+LeftistHeap<Comparable>& LeftistHeap<Comparable>::operator=( LeftistHeap&& rhs ) {
+    std::swap(_root, rhs._root);
+    std::swap(_pool, rhs._pool);
+    return *this;
+}
+
+template<typename Comparable>
+LeftistHeap<Comparable>::~LeftistHeap() {
+    makeEmpty();
+}
+
+template<typename Comparable>
+const Comparable& LeftistHeap<Comparable>::findMin() const {
+    _checkNotEmpty();
+    return _root->item;
+}
+
+template<typename Comparable>
+void LeftistHeap<Comparable>::insert( const Comparable& x ) {
+    _root = _merge(_pool.allocate(x), _root);
+}
+
+template<typename Comparable>
+void LeftistHeap<Comparable>::insert( Comparable&& x ) {
+    _root = _merge(_pool.allocate(std::move(x)), _root);
+}
+
+template<typename Comparable>
+void LeftistHeap<Comparable>::deleteMin() {
+    _checkNotEmpty();
+    LeftistNode* oldRoot = _root;
+    _root = _merge(_root->left, _root->right);
+    _pool.release(oldRoot);
+}
+
+template<typename Comparable>
+void LeftistHeap<Comparable>::deleteMin( Comparable& minItem ) {
+    _checkNotEmpty();
+    minItem = std::move(_root->item);
+    deleteMin();
+}
+
+template<typename Comparable>
+void LeftistHeap<Comparable>::merge( LeftistHeap& rhs ) {
+    if (this == &rhs) return; // avoid aliasing problems
+
+    _root = _merge(_root, rhs._root);
+    rhs._root = nullptr;
+    _pool.splice(rhs._pool);
+}
+
+template<typename Comparable>
+bool LeftistHeap<Comparable>::isEmpty() const {
+    return _root == nullptr;
+}
+
+/*
+Left paths can be long, so nodes are released with an explicit stack rather
+than recursion.
+*/
+template<typename Comparable>
+void LeftistHeap<Comparable>::makeEmpty() {
+    std::vector<LeftistNode*> stack;
+    if (_root != nullptr) stack.push_back(_root);
+
+    while (!stack.empty()) {
+        LeftistNode* t = stack.back();
+        stack.pop_back();
+        if (t->left != nullptr)  stack.push_back(t->left);
+        if (t->right != nullptr) stack.push_back(t->right);
+        _pool.release(t);
+    }
+    _root = nullptr;
+}
+
+template<typename Comparable>
+typename LeftistHeap<Comparable>::LeftistNode*
+LeftistHeap<Comparable>::_merge( LeftistNode* h1, LeftistNode* h2 ) {
+    if (h1 == nullptr) return h2;
+    if (h2 == nullptr) return h1;
+    if (h1->item < h2->item) return _merge1(h1, h2);
+    else                     return _merge1(h2, h1);
+}
+
+template<typename Comparable>
+typename LeftistHeap<Comparable>::LeftistNode*
+LeftistHeap<Comparable>::_merge1( LeftistNode* h1, LeftistNode* h2 ) {
+    if (h1->left == nullptr) { // single node
+        h1->left = h2;         // other fields in h1 already accurate
+    }
+    else {
+        h1->right = _merge(h1->right, h2);
+        if (h1->left->npl < h1->right->npl) {
+            std::swap(h1->left, h1->right);
+        }
+        h1->npl = h1->right->npl + 1;
+    }
+    return h1;
+}
+
+template<typename Comparable>
+void LeftistHeap<Comparable>::_checkNotEmpty() const {
+    if (isEmpty()) {
+        std::cout << "Error: Underflow\n";
+        std::abort();
+    }
+}
+
+#endif
@@ -0,0 +1,486 @@
+#ifndef MAX_FLOW_H
+#define MAX_FLOW_H
+
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <cstdint>
+#include <algorithm>
+
+#include "Graph.h"
+
+/*
+A flow network (lecture 19) and three maximum-flow algorithms on it:
+  edmondsKarp: the lecture algorithm with the shortest augmenting path,
+               found by breadth-first search. O(V E^2); the reference.
+  dinic:       augments along all shortest paths at once: a breadth-first
+               search numbers the vertices by distance from s, and a
+               blocking flow is pushed along edges from one level to the
+               next. O(V^2 E), far less in practice.
+  pushRelabel: highest-label push-relabel (Goldberg and Tarjan) with the
+               gap and global-relabel heuristics. O(V^2 sqrt(E)), and
+               usually the fastest on large networks.
+
+The residual graph G_r is stored in compressed sparse row form: the arcs
+leaving v are arcs _first[v] .. _first[v + 1] - 1, and every edge (v, w)
+of the network is an arc v -> w paired with a reverse arc w -> v of
+capacity 0, each holding the index of the other. Pushing flow along an arc
+lowers its residual capacity and raises that of its pair by the same
+amount, which is how the algorithms undo flow. Each solve starts from zero
+flow and leaves the final flow in place for flow and minCut.
+*/
+template<typename Capacity = long long>
+class FlowNetwork {
+    public:
+        explicit FlowNetwork( int numVertices = 0 );
+
+        /*
+        @brief Add the edge (from, to) of the given capacity; parallel edges
+               and edges in both directions are allowed.
+        @throw std::invalid_argument on a negative vertex or capacity
+        @return int, the number of the edge, for flow
+        */
+        int addEdge( Vertex from, Vertex to, Capacity capacity );
+
+        int numVertices() const;
+        int numEdges() const;
+
+        // Return the value of a maximum flow from s to t.
+        Capacity edmondsKarp( Vertex s, Vertex t );
+        Capacity dinic( Vertex s, Vertex t );
+        Capacity pushRelabel( Vertex s, Vertex t );
+
+        // Return the flow on edge e, after a solve.
+        Capacity flow( int e ) const;
+
+        /*
+        @brief The minimum cut of the last solve: the vertices reachable
+               from s in the residual graph. The edges leaving them have
+               total capacity equal to the maximum flow.
+        @return std::vector<bool>, true for the vertices on the side of s
+        */
+        std::vector<bool> minCut() const;
+
+        // Return the edges from the side of s to the side of t of minCut.
+        std::vector<int> minCutEdges() const;
+
+    private:
+        int _numVertices;
+        Vertex _source, _sink;
+
+        // the edges as added
+        std::vector<Vertex> _from, _to;
+        std::vector<Capacity> _capacity;
+
+        // the residual graph, built by the first solve after an addEdge
+        bool _built;
+        std::vector<std::int64_t> _first;   // numVertices + 1 entries
+        std::vector<Vertex> _head;          // 2 numEdges arcs
+        std::vector<std::int64_t> _pair;
+        std::vector<Capacity> _residual;
+        std::vector<std::int64_t> _arcOf;   // the forward arc of each edge
+
+        // push-relabel state
+        std::vector<int> _label;
+        std::vector<Capacity> _excess;
+        std::vector<std::int64_t> _current;
+        std::vector<Vertex> _allHead, _allNext, _allPrev; // vertices by label
+        std::vector<Vertex> _activeHead, _activeNext;     // active vertices by label
+
+        // Build the arcs if needed and reset the flow to zero.
+        void _start( Vertex s, Vertex t );
+
+        Vertex _tail( std::int64_t arc ) const { return _head[_pair[arc]]; }
+
+        void _push( std::int64_t arc, Capacity amount );
+
+        // Breadth-first search from s over arcs of positive residual
+        // capacity; return the levels, -1 if unreached.
+        std::vector<int> _levels( Vertex s ) const;
+
+        // Move the excess of every vertex except excluded to target, as far
+        // as the residual graph allows.
+        void _discharge( Vertex target, Vertex excluded );
+
+        // Label every vertex with its residual distance to target.
+        void _globalRelabel( Vertex target, Vertex excluded );
+
+        void _insertLabeled( Vertex v );
+        void _removeLabeled( Vertex v );
+        void _activate( Vertex v );
+};
+
+template<typename Capacity>
+FlowNetwork<Capacity>::FlowNetwork( int numVertices )
+    : _numVertices{ numVertices }, _source{ NOT_A_VERTEX }, _sink{ NOT_A_VERTEX }, _built{ false }
+{ }
+
+template<typename Capacity>
+int FlowNetwork<Capacity>::addEdge( Vertex from, Vertex to, Capacity capacity ) {
+    if (from < 0 || to < 0) {
+        throw std::invalid_argument("FlowNetwork: negative vertex");
+    }
+    if (capacity < Capacity{ 0 }) {
+        throw std::invalid_argument("FlowNetwork: negative capacity");
+    }
+    _from.push_back(from);
+    _to.push_back(to);
+    _capacity.push_back(capacity);
+    _numVertices = std::max(_numVertices, std::max(from, to) + 1);
+    _built = false;
+    return static_cast<int>(_from.size()) - 1;
+}
+
+template<typename Capacity>
+int FlowNetwork<Capacity>::numVertices() const {
+    return _numVertices;
+}
+
+template<typename Capacity>
+int FlowNetwork<Capacity>::numEdges() const {
+    return static_cast<int>(_from.size());
+}
+
+template<typename Capacity>
+void FlowNetwork<Capacity>::_start( Vertex s, Vertex t ) {
+    if (s < 0 || t < 0 || s >= _numVertices || t >= _numVertices || s == t) {
+        throw std::invalid_argument("FlowNetwork: bad source or sink");
+    }
+    _source = s;
+    _sink = t;
+
+    int n = _numVertices;
+    std::int64_t m = static_cast<std::int64_t>(_from.size());
+    if (!_built) {
+        // counting sort of the 2m arcs by tail
+        _first.assign(n + 1, 0);
+        for (std::int64_t e = 0; e < m; ++e) {
+            _first[_from[e] + 1] += 1;
+            _first[_to[e] + 1] += 1;
+        }
+        for (int v = 0; v < n; ++v) _first[v + 1] += _first[v];
+
+        std::vector<std::int64_t> next(_first.begin(), _first.end() - 1);
+        _head.resize(2 * m);
+        _pair.resize(2 * m);
+        _arcOf.resize(m);
+        for (std::int64_t e = 0; e < m; ++e) {
+            std::int64_t forward = next[_from[e]]++, backward = next[_to[e]]++;
+            _head[forward] = _to[e];
+            _head[backward] = _from[e];
+            _pair[forward] = backward;
+            _pair[backward] = forward;
+            _arcOf[e] = forward;
+        }
+        _built = true;
+    }
+
+    _residual.assign(2 * m, Capacity{ 0 });
+    for (std::int64_t e = 0; e < m; ++e) {
+        _residual[_arcOf[e]] = _capacity[e];
+    }
+}
+
+template<typename Capacity>
+void FlowNetwork<Capacity>::_push( std::int64_t arc, Capacity amount ) {
+    _residual[arc] -= amount;
+    _residual[_pair[arc]] += amount;
+}
+
+template<typename Capacity>
+std::vector<int> FlowNetwork<Capacity>::_levels( Vertex s ) const {
+    std::vector<int> level(_numVertices, -1);
+    std::vector<Vertex> queue;
+    queue.reserve(_numVertices);
+    level[s] = 0;
+    queue.push_back(s);
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        Vertex v = queue[i];
+        for (std::int64_t a = _first[v]; a < _first[v + 1]; ++a) {
+            Vertex w = _head[a];
+            if (level[w] < 0 && _residual[a] > Capacity{ 0 }) {
+                level[w] = level[v] + 1;
+                queue.push_back(w);
+            }
+        }
+    }
+    return level;
+}
+
+template<typename Capacity>
+Capacity FlowNetwork<Capacity>::edmondsKarp( Vertex s, Vertex t ) {
+    _start(s, t);
+    Capacity total{ 0 };
+
+    std::vector<std::int64_t> parentArc(_numVertices);
+    std::vector<Vertex> queue;
+    queue.reserve(_numVertices);
+    while (true) {
+        // shortest augmenting path by breadth-first search
+        std::fill(parentArc.begin(), parentArc.end(), -1);
+        queue.clear();
+        queue.push_back(s);
+        for (std::size_t i = 0; i < queue.size() && parentArc[t] < 0; ++i) {
+            Vertex v = queue[i];
+            for (std::int64_t a = _first[v]; a < _first[v + 1]; ++a) {
+                Vertex w = _head[a];
+                if (w != s && parentArc[w] < 0 && _residual[a] > Capacity{ 0 }) {
+                    parentArc[w] = a;
+                    queue.push_back(w);
+                }
+            }
+        }
+        if (parentArc[t] < 0) return total;
+
+        Capacity bottleneck = std::numeric_limits<Capacity>::max();
+        for (Vertex v = t; v != s; v = _tail(parentArc[v])) {
+            bottleneck = std::min(bottleneck, _residual[parentArc[v]]);
+        }
+        for (Vertex v = t; v != s; v = _tail(parentArc[v])) {
+            _push(parentArc[v], bottleneck);
+        }
+        total += bottleneck;
+    }
+}
+
+template<typename Capacity>
+Capacity FlowNetwork<Capacity>::dinic( Vertex s, Vertex t ) {
+    _start(s, t);
+    Capacity total{ 0 };
+
+    std::vector<std::int64_t> current(_numVertices);
+    std::vector<std::int64_t> path; // arcs from s to v
+    while (true) {
+        std::vector<int> level = _levels(s);
+        if (level[t] < 0) return total;
+        std::copy(_first.begin(), _first.end() - 1, current.begin());
+
+        // blocking flow by depth-first search without recursion: advance
+        // along the current arc of v, retreat from dead ends, and augment
+        // when t is reached
+        Vertex v = s;
+        path.clear();
+        while (true) {
+            if (v == t) {
+                Capacity bottleneck = std::numeric_limits<Capacity>::max();
+                for (std::int64_t a : path) bottleneck = std::min(bottleneck, _residual[a]);
+
+                std::size_t saturated = path.size();
+                for (std::size_t i = 0; i < path.size(); ++i) {
+                    _push(path[i], bottleneck);
+                    if (saturated == path.size() && _residual[path[i]] == Capacity{ 0 }) saturated = i;
+                }
+                total += bottleneck;
+
+                // resume from the tail of the first saturated arc
+                v = _tail(path[saturated]);
+                path.resize(saturated);
+                continue;
+            }
+
+            std::int64_t& a = current[v];
+            while (a < _first[v + 1] && !(_residual[a] > Capacity{ 0 } && level[_head[a]] == level[v] + 1)) ++a;
+
+            if (a < _first[v + 1]) {
+                path.push_back(a);
+                v = _head[a];
+            }
+            else {
+                // no way on from v at this level
+                level[v] = -1;
+                if (path.empty()) break;
+                v = _tail(path.back());
+                path.pop_back();
+                current[v] += 1;
+            }
+        }
+    }
+}
+
+template<typename Capacity>
+void FlowNetwork<Capacity>::_insertLabeled( Vertex v ) {
+    int h = _label[v];
+    _allPrev[v] = NOT_A_VERTEX;
+    _allNext[v] = _allHead[h];
+    if (_allHead[h] != NOT_A_VERTEX) _allPrev[_allHead[h]] = v;
+    _allHead[h] = v;
+}
+
+template<typename Capacity>
+void FlowNetwork<Capacity>::_removeLabeled( Vertex v ) {
+    int h = _label[v];
+    if (_allPrev[v] != NOT_A_VERTEX) _allNext[_allPrev[v]] = _allNext[v];
+    else                             _allHead[h] = _allNext[v];
+    if (_allNext[v] != NOT_A_VERTEX) _allPrev[_allNext[v]] = _allPrev[v];
+}
+
+template<typename Capacity>
+void FlowNetwork<Capacity>::_activate( Vertex v ) {
+    _activeNext[v] = _activeHead[_label[v]];
+    _activeHead[_label[v]] = v;
+}
+
+template<typename Capacity>
+void FlowNetwork<Capacity>::_globalRelabel( Vertex target, Vertex excluded ) {
+    int n = _numVertices;
+    std::fill(_label.begin(), _label.end(), n);
+    std::fill(_allHead.begin(), _allHead.end(), NOT_A_VERTEX);
+    std::fill(_activeHead.begin(), _activeHead.end(), NOT_A_VERTEX);
+
+    // backwards breadth-first search from target: v gets a label through
+    // w if the arc v -> w, the pair of w -> v, has residual capacity
+    std::vector<Vertex> queue;
+    queue.reserve(n);
+    _label[target] = 0;
+    queue.push_back(target);
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        Vertex w = queue[i];
+        for (std::int64_t a = _first[w]; a < _first[w + 1]; ++a) {
+            Vertex v = _head[a];
+            if (_label[v] == n && v != target && v != excluded && _residual[_pair[a]] > Capacity{ 0 }) {
+                _label[v] = _label[w] + 1;
+                queue.push_back(v);
+            }
+        }
+    }
+
+    for (Vertex v : queue) {
+        _current[v] = _first[v];
+        if (v == target) continue;
+        _insertLabeled(v);
+        if (_excess[v] > Capacity{ 0 }) _activate(v);
+    }
+}
+
+template<typename Capacity>
+void FlowNetwork<Capacity>::_discharge( Vertex target, Vertex excluded ) {
+    int n = _numVertices;
+    std::int64_t m = static_cast<std::int64_t>(_head.size());
+
+    // relabels since the last global relabel, weighted by degree, that
+    // trigger the next one
+    const std::int64_t GLOBAL_RELABEL_WORK = 6 * static_cast<std::int64_t>(n) + m / 2;
+    std::int64_t work = 0;
+
+    _globalRelabel(target, excluded);
+    int highest = n - 1;     // no active vertex is above this label
+    int maxLabel = n - 1;    // no labeled vertex is above this label
+
+    while (true) {
+        while (highest >= 0 && _activeHead[highest] == NOT_A_VERTEX) --highest;
+        if (highest < 0) return;
+
+        Vertex v = _activeHead[highest];
+        _activeHead[highest] = _activeNext[v];
+
+        // discharge v: push along admissible arcs, relabel when none is left
+        while (_excess[v] > Capacity{ 0 }) {
+            std::int64_t& a = _current[v];
+            for (; a < _first[v + 1]; ++a) {
+                Vertex w = _head[a];
+                if (_residual[a] > Capacity{ 0 } && _label[w] == _label[v] - 1) {
+                    Capacity amount = std::min(_excess[v], _residual[a]);
+                    bool wasIdle = !(_excess[w] > Capacity{ 0 });
+                    _push(a, amount);
+                    _excess[v] -= amount;
+                    _excess[w] += amount;
+                    if (wasIdle && w != target && w != excluded) _activate(w);
+                    if (!(_excess[v] > Capacity{ 0 })) break;
+                }
+            }
+            if (!(_excess[v] > Capacity{ 0 })) break;
+
+            // relabel
+            int old = _label[v];
+            _removeLabeled(v);
+            if (_allHead[old] == NOT_A_VERTEX) {
+                // gap: nothing labeled old is left, so no vertex above it
+                // can reach target any more
+                for (int h = old + 1; h <= maxLabel; ++h) {
+                    for (Vertex u = _allHead[h]; u != NOT_A_VERTEX; u = _allNext[u]) _label[u] = n;
+                    _allHead[h] = NOT_A_VERTEX;
+                    _activeHead[h] = NOT_A_VERTEX;
+                }
+                maxLabel = old - 1;
+                _label[v] = n;
+                break;
+            }
+
+            int lowest = n;
+            for (std::int64_t b = _first[v]; b < _first[v + 1]; ++b) {
+                if (_residual[b] > Capacity{ 0 }) lowest = std::min(lowest, _label[_head[b]] + 1);
+            }
+            work += 12 + (_first[v + 1] - _first[v]);
+            _label[v] = lowest;
+            _current[v] = _first[v];
+            if (lowest >= n) {
+                _label[v] = n;
+                break;
+            }
+            _insertLabeled(v);
+            maxLabel = std::max(maxLabel, lowest);
+            highest = std::max(highest, lowest);
+        }
+
+        if (work > GLOBAL_RELABEL_WORK) {
+            work = 0;
+            _globalRelabel(target, excluded);
+            highest = n - 1;
+            maxLabel = n - 1;
+        }
+    }
+}
+
+template<typename Capacity>
+Capacity FlowNetwork<Capacity>::pushRelabel( Vertex s, Vertex t ) {
+    _start(s, t);
+    int n = _numVertices;
+    _label.assign(n, n);
+    _excess.assign(n, Capacity{ 0 });
+    _current.assign(n, 0);
+    _allHead.assign(n + 1, NOT_A_VERTEX);
+    _allNext.assign(n, NOT_A_VERTEX);
+    _allPrev.assign(n, NOT_A_VERTEX);
+    _activeHead.assign(n + 1, NOT_A_VERTEX);
+    _activeNext.assign(n, NOT_A_VERTEX);
+
+    // saturate the edges out of s
+    for (std::int64_t a = _first[s]; a < _first[s + 1]; ++a) {
+        Capacity amount = _residual[a];
+        if (amount > Capacity{ 0 } && _head[a] != s) {
+            _push(a, amount);
+            _excess[_head[a]] += amount;
+        }
+    }
+
+    // phase 1 finds a maximum preflow: all the excess that can reach t;
+    // phase 2 returns the rest to s, which turns the preflow into a flow
+    _discharge(t, s);
+    _discharge(s, t);
+    return _excess[t];
+}
+
+template<typename Capacity>
+Capacity FlowNetwork<Capacity>::flow( int e ) const {
+    return _capacity[e] - _residual[_arcOf[e]];
+}
+
+template<typename Capacity>
+std::vector<bool> FlowNetwork<Capacity>::minCut() const {
+    std::vector<int> level = _levels(_source);
+    std::vector<bool> side(_numVertices);
+    for (Vertex v = 0; v < _numVertices; ++v) side[v] = level[v] >= 0;
+    return side;
+}
+
+template<typename Capacity>
+std::vector<int> FlowNetwork<Capacity>::minCutEdges() const {
+    std::vector<bool> side = minCut();
+    std::vector<int> edges;
+    for (int e = 0; e < numEdges(); ++e) {
+        if (side[_from[e]] && !side[_to[e]]) edges.push_back(e);
+    }
+    return edges;
+}
+
+#endif
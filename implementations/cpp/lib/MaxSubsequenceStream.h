@@ -0,0 +1,216 @@
+#ifndef MAX_SUBSEQUENCE_STREAM_H
+#define MAX_SUBSEQUENCE_STREAM_H
+
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+
+#include "MaxSubsequenceSum.h"
+
+/*
+The maximum subsequence sum of a stream of samples, which arrive one at a
+time or in chunks and are numbered 0, 1, 2, ... in order of arrival:
+  Stream: over all the samples so far. The Summary of the stream (see
+          MaxSubsequenceSum.h) is combined with that of each new sample or
+          chunk; a chunk is summarized with summarizeBlocked first. O(1)
+          per sample; a sample pushed alone is one step of Kadane's
+          algorithm (append).
+  Window: over the last W samples only. The window is a queue of
+          summaries kept as two stacks: the front stack holds, for each of
+          the oldest samples, the summary from that sample to the end of
+          the stack, and the back of the queue is kept as one summary of
+          the newest samples. The window is the front summary of the
+          oldest sample combined with the back summary. When the front
+          stack runs empty, the back samples are moved onto it in one pass
+          from newest to oldest; each sample is moved once, so the work is
+          O(1) amortized per sample.
+best() returns the best subsequence by sample number: the samples
+begin .. end - 1.
+*/
+namespace MaxSubsequenceSum {
+    // Summary of the single sample x, number position.
+    template<typename T>
+    Summary<typename Wide<T>::type> single( T x, std::size_t position ) {
+        typedef typename Wide<T>::type Sum;
+        if (x > 0) {
+            return Summary<Sum>{ x, x, position + 1, x, position, Subsequence<Sum>{ x, position, position + 1 } };
+        }
+        return Summary<Sum>{ x, 0, position, 0, position + 1, Subsequence<Sum>{ 0, position, position } };
+    }
+
+    /*
+    @brief Extend s, the summary of the samples up to position - 1, by the
+           sample x: the sums of combine(s, single(x, position)) in one step
+           of Kadane's algorithm on the best suffix.
+    */
+    template<typename Sum, typename T>
+    void append( Summary<Sum>& s, T x, std::size_t position ) {
+        s.total += x;
+        if (s.total > s.prefix) { s.prefix = s.total; s.prefixEnd = position + 1; }
+        if (s.suffix + x > 0)   { s.suffix += x; }
+        else                    { s.suffix = 0; s.suffixBegin = position + 1; }
+        if (s.suffix > s.best.sum) s.best = Subsequence<Sum>{ s.suffix, s.suffixBegin, position + 1 };
+    }
+
+    // Extend s, the summary of the samples from position + 1 on, by the
+    // sample x in front: the mirror image of append.
+    template<typename Sum, typename T>
+    void prepend( Summary<Sum>& s, T x, std::size_t position ) {
+        s.total += x;
+        if (s.total > s.suffix) { s.suffix = s.total; s.suffixBegin = position; }
+        if (x + s.prefix > 0)   { s.prefix += x; }
+        else                    { s.prefix = 0; s.prefixEnd = position; }
+        if (s.prefix > s.best.sum) s.best = Subsequence<Sum>{ s.prefix, position, s.prefixEnd };
+    }
+
+    // Summary s with offset added to all its positions.
+    template<typename Sum>
+    Summary<Sum> shifted( Summary<Sum> s, std::size_t offset ) {
+        s.prefixEnd += offset;
+        s.suffixBegin += offset;
+        s.best.begin += offset;
+        s.best.end += offset;
+        return s;
+    }
+
+    template<typename T>
+    class Stream {
+        public:
+            typedef typename Wide<T>::type Sum;
+
+            Stream();
+
+            void push( T x );
+            void push( const T* samples, std::size_t n );
+
+            Subsequence<Sum> best() const;
+            std::size_t size() const;
+
+        private:
+            Summary<Sum> _summary;
+            std::size_t _size;
+    };
+
+    template<typename T>
+    class Window {
+        public:
+            typedef typename Wide<T>::type Sum;
+
+            /*
+            @brief A window over the last width samples.
+            @throw std::invalid_argument if width is 0
+            */
+            explicit Window( std::size_t width );
+
+            void push( T x );
+            // Push the samples in order; only the last width of them are kept.
+            void push( const T* samples, std::size_t n );
+
+            Subsequence<Sum> best() const;
+            // Return the number of samples in the window: min(pushed, width).
+            std::size_t size() const;
+            std::size_t width() const;
+
+        private:
+            std::size_t _width;
+            std::vector<T> _samples;          // sample i at i % width
+            std::vector<Summary<Sum>> _front; // summary of [i, _frontEnd) at i % width
+            Summary<Sum> _back;               // summary of [_frontEnd, _end)
+            std::size_t _begin, _frontEnd, _end;
+
+            void _pop();
+            void _flip();
+    };
+}
+
+template<typename T>
+MaxSubsequenceSum::Stream<T>::Stream()
+    : _summary{ 0, 0, 0, 0, 0, Subsequence<Sum>{ 0, 0, 0 } }, _size{ 0 } { }
+
+template<typename T>
+void MaxSubsequenceSum::Stream<T>::push( T x ) {
+    append(_summary, x, _size);
+    ++_size;
+}
+
+template<typename T>
+void MaxSubsequenceSum::Stream<T>::push( const T* samples, std::size_t n ) {
+    _summary = combine(_summary, shifted(summarizeBlocked(samples, 0, n), _size));
+    _size += n;
+}
+
+template<typename T>
+MaxSubsequenceSum::Subsequence<typename MaxSubsequenceSum::Stream<T>::Sum> MaxSubsequenceSum::Stream<T>::best() const {
+    return _summary.best;
+}
+
+template<typename T>
+std::size_t MaxSubsequenceSum::Stream<T>::size() const {
+    return _size;
+}
+
+template<typename T>
+MaxSubsequenceSum::Window<T>::Window( std::size_t width )
+    : _width{ width }, _samples(width), _front(width), _back{}, _begin{ 0 }, _frontEnd{ 0 }, _end{ 0 } {
+    if (width == 0) {
+        throw std::invalid_argument("Window: width must be positive");
+    }
+}
+
+template<typename T>
+void MaxSubsequenceSum::Window<T>::push( T x ) {
+    if (_end - _begin == _width) _pop();
+    _samples[_end % _width] = x;
+    if (_frontEnd == _end) _back = single(x, _end);
+    else append(_back, x, _end);
+    ++_end;
+}
+
+template<typename T>
+void MaxSubsequenceSum::Window<T>::push( const T* samples, std::size_t n ) {
+    if (n >= _width) {
+        // the window will hold nothing but the last width samples
+        _end += n - _width;
+        _begin = _frontEnd = _end;
+        samples += n - _width;
+        n = _width;
+    }
+    for (std::size_t i = 0; i < n; ++i) push(samples[i]);
+}
+
+template<typename T>
+void MaxSubsequenceSum::Window<T>::_pop() {
+    if (_frontEnd == _begin) _flip();
+    ++_begin;
+}
+
+template<typename T>
+void MaxSubsequenceSum::Window<T>::_flip() {
+    Summary<Sum> s = single(_samples[(_end - 1) % _width], _end - 1);
+    _front[(_end - 1) % _width] = s;
+    for (std::size_t i = _end - 1; i-- > _begin; ) {
+        prepend(s, _samples[i % _width], i);
+        _front[i % _width] = s;
+    }
+    _frontEnd = _end;
+}
+
+template<typename T>
+MaxSubsequenceSum::Subsequence<typename MaxSubsequenceSum::Window<T>::Sum> MaxSubsequenceSum::Window<T>::best() const {
+    if (_begin == _end) return Subsequence<Sum>{ 0, _end, _end };
+    if (_begin == _frontEnd) return _back.best;
+    const Summary<Sum>& front = _front[_begin % _width];
+    return _frontEnd == _end ? front.best : combine(front, _back).best;
+}
+
+template<typename T>
+std::size_t MaxSubsequenceSum::Window<T>::size() const {
+    return _end - _begin;
+}
+
+template<typename T>
+std::size_t MaxSubsequenceSum::Window<T>::width() const {
+    return _width;
+}
+
+#endif
@@ -3,6 +3,12 @@
 
 #include <iostream>
 #include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+#include "TaskScheduler.h"
 
 namespace MaxSubsequenceSum {
     int v1( const std::vector<int> &a ) {
@@ -36,6 +42,266 @@ namespace MaxSubsequenceSum {
 
         return maxSum;
     }
+
+    /*
+    The sums of the versions below are kept in an accumulator twice as wide
+    as the items, so they cannot overflow for fewer than 2^32 items:
+    int items are summed as 64-bit integers, 64-bit items as 128-bit ones.
+    */
+    template<typename T> struct Wide;
+    template<> struct Wide<int> { typedef std::int64_t type; };
+    template<> struct Wide<long long> { typedef __int128 type; };
+    template<> struct Wide<long> {
+        typedef std::conditional<sizeof(long) == 8, __int128, std::int64_t>::type type;
+    };
+
+    // The subsequence a[begin, end) and its sum. An empty subsequence of
+    // sum 0 is the answer when every item is negative.
+    template<typename Sum>
+    struct Subsequence {
+        Sum sum;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /*
+    What the divide-and-conquer versions need to know of a range
+    a[first, last) to combine it with its neighbours: its total, its best
+    prefix a[first, prefixEnd), its best suffix a[suffixBegin, last) and
+    its best subsequence.
+    */
+    template<typename Sum>
+    struct Summary {
+        Sum total;
+        Sum prefix;
+        std::size_t prefixEnd;
+        Sum suffix;
+        std::size_t suffixBegin;
+        Subsequence<Sum> best;
+    };
+
+    // Summary of a range followed by the range after it. Associative.
+    template<typename Sum>
+    Summary<Sum> combine( const Summary<Sum>& left, const Summary<Sum>& right ) {
+        Summary<Sum> s;
+        s.total = left.total + right.total;
+
+        s.prefix = left.prefix;
+        s.prefixEnd = left.prefixEnd;
+        if (left.total + right.prefix > s.prefix) {
+            s.prefix = left.total + right.prefix;
+            s.prefixEnd = right.prefixEnd;
+        }
+
+        s.suffix = right.suffix;
+        s.suffixBegin = right.suffixBegin;
+        if (left.suffix + right.total > s.suffix) {
+            s.suffix = left.suffix + right.total;
+            s.suffixBegin = left.suffixBegin;
+        }
+
+        s.best = left.best;
+        if (right.best.sum > s.best.sum) s.best = right.best;
+        if (left.suffix + right.prefix > s.best.sum) {
+            s.best = Subsequence<Sum>{ left.suffix + right.prefix, left.suffixBegin, right.prefixEnd };
+        }
+        return s;
+    }
+
+    /*
+    @brief Summary of a[first, last) in one pass over the prefix sums
+           P(j) = a[first] + ... + a[j - 1]: the best subsequence ending
+           at j is P(j) minus the smallest P(i), i <= j, the best prefix is
+           the largest P(j), and the best suffix is P(last) minus the
+           smallest P(i).
+    @return Summary
+    */
+    template<typename T>
+    Summary<typename Wide<T>::type> summarize( const T* a, std::size_t first, std::size_t last ) {
+        typedef typename Wide<T>::type Sum;
+        Sum p = 0, minP = 0, maxP = 0, best = 0;
+        std::size_t minPos = first, maxPos = first, bestBegin = first, bestEnd = first;
+
+        for (std::size_t j = first; j < last; ++j) {
+            p += a[j];
+            if (p - minP > best) { best = p - minP; bestBegin = minPos; bestEnd = j + 1; }
+            if (p > maxP)        { maxP = p; maxPos = j + 1; }
+            if (p < minP)        { minP = p; minPos = j + 1; }
+        }
+        return Summary<Sum>{ p, maxP, maxPos, p - minP, minPos, Subsequence<Sum>{ best, bestBegin, bestEnd } };
+    }
+
+    // Algorithm 3 on a[left, right).
+    template<typename T>
+    Subsequence<typename Wide<T>::type> maxSumRec( const std::vector<T>& a, std::size_t left, std::size_t right ) {
+        typedef typename Wide<T>::type Sum;
+        if (right - left <= 1) {
+            if (right - left == 1 && a[left] > 0) return Subsequence<Sum>{ a[left], left, right };
+            return Subsequence<Sum>{ 0, left, left };
+        }
+
+        std::size_t center = left + (right - left) / 2;
+        Subsequence<Sum> maxLeft = maxSumRec(a, left, center);
+        Subsequence<Sum> maxRight = maxSumRec(a, center, right);
+
+        Sum maxLeftBorderSum = 0, leftBorderSum = 0;
+        std::size_t begin = center;
+        for (std::size_t i = center; i-- > left; ) {
+            leftBorderSum += a[i];
+            if (leftBorderSum > maxLeftBorderSum) {
+                maxLeftBorderSum = leftBorderSum;
+                begin = i;
+            }
+        }
+
+        Sum maxRightBorderSum = 0, rightBorderSum = 0;
+        std::size_t end = center;
+        for (std::size_t j = center; j < right; ++j) {
+            rightBorderSum += a[j];
+            if (rightBorderSum > maxRightBorderSum) {
+                maxRightBorderSum = rightBorderSum;
+                end = j + 1;
+            }
+        }
+
+        Subsequence<Sum> best = maxLeft.sum >= maxRight.sum ? maxLeft : maxRight;
+        if (maxLeftBorderSum + maxRightBorderSum > best.sum) {
+            best = Subsequence<Sum>{ maxLeftBorderSum + maxRightBorderSum, begin, end };
+        }
+        return best;
+    }
+
+    /*
+    @brief Algorithm 3: divide and conquer. The best subsequence lies in
+           the left half, in the right half, or across the middle, where
+           it is the best suffix of the left half and the best prefix of
+           the right half. O(N log N).
+    @return Subsequence
+    */
+    template<typename T>
+    Subsequence<typename Wide<T>::type> v3( const std::vector<T>& a ) {
+        return maxSumRec(a, 0, a.size());
+    }
+
+    /*
+    @brief Algorithm 4 (Kadane): a running sum that restarts whenever it
+           drops below 0, since a negative prefix never helps. O(N).
+    @return Subsequence
+    */
+    template<typename T>
+    Subsequence<typename Wide<T>::type> v4( const std::vector<T>& a ) {
+        typedef typename Wide<T>::type Sum;
+        Subsequence<Sum> best{ 0, 0, 0 };
+        Sum currentSum = 0;
+        std::size_t begin = 0;
+
+        for (std::size_t j = 0; j < a.size(); ++j) {
+            currentSum += a[j];
+            if (currentSum > best.sum) {
+                best = Subsequence<Sum>{ currentSum, begin, j + 1 };
+            }
+            else if (currentSum < 0) {
+                currentSum = 0;
+                begin = j + 1;
+            }
+        }
+        return best;
+    }
+
+    /*
+    @brief Summary of a[first, last) cut into blocks of BLOCK items that
+           are scanned LANES at a time, side by side. The scan keeps only
+           the values of summarize (running sum, smallest and largest
+           prefix sum, best gain) for each block, with max and min instead
+           of branches, so the inner loop over the lanes has no dependency
+           from one lane to the next and compiles to vector instructions.
+           The block summaries are combined with block numbers in place
+           of positions; the positions are then found by running
+           summarize again on the (at most four) blocks they fall in.
+    @return Summary
+    */
+    template<typename T>
+    Summary<typename Wide<T>::type> summarizeBlocked( const T* a, std::size_t first, std::size_t last ) {
+        typedef typename Wide<T>::type Sum;
+        const int LANES = 8;
+        const std::size_t BLOCK = 2048;
+        std::size_t groups = (last - first) / (LANES * BLOCK);
+        if (groups == 0) return summarize(a, first, last);
+
+        // In s, every position is the number of the block it lies in, and
+        // a best subsequence inside block b is [b, b).
+        Summary<Sum> s{};
+        for (std::size_t g = 0; g < groups; ++g) {
+            const T* lane[LANES];
+            Sum p[LANES], minP[LANES], maxP[LANES], best[LANES];
+            for (int k = 0; k < LANES; ++k) {
+                lane[k] = a + first + (g * LANES + k) * BLOCK;
+                p[k] = minP[k] = maxP[k] = best[k] = 0;
+            }
+            for (std::size_t j = 0; j < BLOCK; ++j) {
+                for (int k = 0; k < LANES; ++k) {
+                    p[k] += lane[k][j];
+                    best[k] = std::max(best[k], p[k] - minP[k]);
+                    maxP[k] = std::max(maxP[k], p[k]);
+                    minP[k] = std::min(minP[k], p[k]);
+                }
+            }
+            for (int k = 0; k < LANES; ++k) {
+                std::size_t b = g * LANES + k;
+                Summary<Sum> block{ p[k], maxP[k], b, p[k] - minP[k], b, Subsequence<Sum>{ best[k], b, b } };
+                s = b == 0 ? block : combine(s, block);
+            }
+        }
+
+        auto summary = [&]( std::size_t b ) {
+            return summarize(a, first + b * BLOCK, first + (b + 1) * BLOCK);
+        };
+        s.best = s.best.begin == s.best.end
+                 ? summary(s.best.begin).best
+                 : Subsequence<Sum>{ s.best.sum, summary(s.best.begin).suffixBegin, summary(s.best.end).prefixEnd };
+        s.prefixEnd = summary(s.prefixEnd).prefixEnd;
+        s.suffixBegin = summary(s.suffixBegin).suffixBegin;
+        return combine(s, summarize(a, first + groups * LANES * BLOCK, last));
+    }
+
+    /*
+    @brief Linear-time version over blocks scanned side by side; see
+           summarizeBlocked. O(N).
+    @return Subsequence
+    */
+    template<typename T>
+    Subsequence<typename Wide<T>::type> blocked( const std::vector<T>& a ) {
+        return summarizeBlocked(a.data(), 0, a.size()).best;
+    }
+
+    template<typename T>
+    Summary<typename Wide<T>::type> summarizeParallel( const T* a, std::size_t first, std::size_t last,
+                                                       std::size_t grain, TaskScheduler& scheduler ) {
+        typedef typename Wide<T>::type Sum;
+        if (last - first <= grain) return summarizeBlocked(a, first, last);
+
+        std::size_t center = first + (last - first) / 2;
+        Summary<Sum> left;
+        TaskScheduler::TaskGroup group;
+        scheduler.spawn(group, [&]() { left = summarizeParallel(a, first, center, grain, scheduler); });
+        Summary<Sum> right = summarizeParallel(a, center, last, grain, scheduler);
+        scheduler.wait(group);
+        return combine(left, right);
+    }
+
+    /*
+    @brief Parallel divide and conquer: as algorithm 3, but each half
+           returns its Summary, so the subsequence across the middle
+           comes from the best suffix and prefix already known instead of
+           a rescan, and the halves are solved as tasks of scheduler.
+           O(N) work, O(log N) span.
+    @return Subsequence
+    */
+    template<typename T>
+    Subsequence<typename Wide<T>::type> parallel( const std::vector<T>& a, TaskScheduler& scheduler ) {
+        std::size_t grain = std::max<std::size_t>(a.size() / (8 * scheduler.numThreads()), 1 << 16);
+        return summarizeParallel(a.data(), 0, a.size(), grain, scheduler).best;
+    }
 }
 
 #endif
@@ -0,0 +1,197 @@
+#ifndef MULTI_QUEUE_H
+#define MULTI_QUEUE_H
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <functional>
+
+#include "BinaryHeap.h"
+
+/*
+Relaxed concurrent priority queue (MultiQueue). The items are spread over
+c * P sequential BinaryHeaps, each guarded by its own lock and padded to
+its own cache line. insert pushes into a random heap; deleteMin locks two
+random heaps and takes the smaller of their minima. Threads rarely contend
+for the same heap, so throughput scales with the number of threads, but
+deleteMin may return an item that is not the global minimum: the expected
+rank of the returned item is O(c * P).
+*/
+template<typename Comparable>
+class MultiQueue {
+    public:
+        /*
+        @brief Create a queue of c * numThreads heaps.
+        */
+        explicit MultiQueue( int numThreads, int c = 2 );
+
+        MultiQueue( const MultiQueue& rhs ) = delete;
+        MultiQueue& operator=( const MultiQueue& rhs ) = delete;
+
+        // Insert item x, allowing duplicates. Thread-safe.
+        void insert( const Comparable& x );
+
+        /*
+        @brief Remove a small item, close to the minimum, and place it in
+               minItem. Thread-safe.
+        @return bool, false if the queue was found empty
+        */
+        bool deleteMin( Comparable& minItem );
+
+        // Check if the queue is empty. Only a snapshot under concurrency.
+        bool isEmpty() const;
+
+        // Return the number of items. Only a snapshot under concurrency.
+        int size() const;
+
+        // Return the number of internal heaps.
+        int numHeaps() const;
+
+    private:
+        struct alignas(64) Shard {
+            std::mutex lock;
+            BinaryHeap<Comparable> heap;
+        };
+
+        int _numHeaps;
+        std::unique_ptr<Shard[]> _shards;
+        std::atomic<int> _size;
+
+        static std::mt19937& _random();
+        int _randomIndex();
+};
+
+/*
+Strict concurrent priority queue: one BinaryHeap behind one lock. Used as
+the baseline the MultiQueue is measured against.
+*/
+template<typename Comparable>
+class LockedBinaryHeap {
+    public:
+        // Insert item x, allowing duplicates. Thread-safe.
+        void insert( const Comparable& x ) {
+            std::lock_guard<std::mutex> guard{ _lock };
+            _heap.insert(x);
+        }
+
+        /*
+        @brief Remove the minimum item and place it in minItem. Thread-safe.
+        @return bool, false if the heap was empty
+        */
+        bool deleteMin( Comparable& minItem ) {
+            std::lock_guard<std::mutex> guard{ _lock };
+            if (_heap.isEmpty()) return false;
+            _heap.deleteMin(minItem);
+            return true;
+        }
+
+        // Check if the heap is empty.
+        bool isEmpty() {
+            std::lock_guard<std::mutex> guard{ _lock };
+            return _heap.isEmpty();
+        }
+
+    private:
+        std::mutex _lock;
+        BinaryHeap<Comparable> _heap;
+};
+
+template<typename Comparable>
+MultiQueue<Comparable>::MultiQueue( int numThreads, int c )
+    : _numHeaps{ numThreads * c < 2 ? 2 : numThreads * c },
+      _shards{ new Shard[_numHeaps] },
+      _size{ 0 }
+{ }
+
+template<typename Comparable>
+void MultiQueue<Comparable>::insert( const Comparable& x ) {
+    while (true) {
+        Shard& shard = _shards[_randomIndex()];
+        if (shard.lock.try_lock()) {
+            shard.heap.insert(x);
+            shard.lock.unlock();
+            break;
+        }
+    }
+    _size.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*
+A heap that is locked by another thread is simply passed over for another
+random one. Once the queue looks empty, every heap is checked in turn
+before giving up, so an item is never missed when there is no concurrent
+activity.
+*/
+template<typename Comparable>
+bool MultiQueue<Comparable>::deleteMin( Comparable& minItem ) {
+    while (_size.load(std::memory_order_relaxed) > 0) {
+        int i = _randomIndex();
+        int j = _randomIndex();
+        if (i == j) continue;
+        if (j < i) std::swap(i, j); // lock in index order
+
+        Shard& a = _shards[i];
+        Shard& b = _shards[j];
+        if (!a.lock.try_lock()) continue;
+        if (!b.lock.try_lock()) {
+            a.lock.unlock();
+            continue;
+        }
+
+        Shard* best = nullptr;
+        if (!a.heap.isEmpty()) best = &a;
+        if (!b.heap.isEmpty() && (best == nullptr || b.heap.findMin() < a.heap.findMin())) {
+            best = &b;
+        }
+        if (best != nullptr) {
+            best->heap.deleteMin(minItem);
+            _size.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        b.lock.unlock();
+        a.lock.unlock();
+        if (best != nullptr) return true;
+    }
+
+    for (int i = 0; i < _numHeaps; ++i) {
+        std::lock_guard<std::mutex> guard{ _shards[i].lock };
+        if (!_shards[i].heap.isEmpty()) {
+            _shards[i].heap.deleteMin(minItem);
+            _size.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Comparable>
+bool MultiQueue<Comparable>::isEmpty() const {
+    return _size.load(std::memory_order_relaxed) <= 0;
+}
+
+template<typename Comparable>
+int MultiQueue<Comparable>::size() const {
+    return _size.load(std::memory_order_relaxed);
+}
+
+template<typename Comparable>
+int MultiQueue<Comparable>::numHeaps() const {
+    return _numHeaps;
+}
+
+template<typename Comparable>
+std::mt19937& MultiQueue<Comparable>::_random() {
+    thread_local std::mt19937 gen{ static_cast<unsigned>(std::hash<std::thread::id>{}(std::this_thread::get_id())) };
+    return gen;
+}
+
+template<typename Comparable>
+int MultiQueue<Comparable>::_randomIndex() {
+    return static_cast<int>(_random()() % _numHeaps);
+}
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <vector>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <cstddef>
+
+/*
+Free-list allocator for fixed-size nodes. Nodes are carved out of blocks
+that double from FIRST_BLOCK_SIZE up to BLOCK_SIZE slots, and released nodes
+are recycled, so node-based structures avoid a trip to the general-purpose
+allocator per insert and their nodes end up close together in memory.
+Memory goes back to the system only when the pool is destroyed.
+
+Each structure owns its pool. When two structures are merged, splice hands
+the blocks and free slots of one pool to the other, so nodes move between
+structures without being copied. Not thread-safe, but structures with
+separate pools may be used from separate threads.
+*/
+template<typename Node>
+class NodePool {
+    public:
+        static const size_t FIRST_BLOCK_SIZE = 16;
+        static const size_t BLOCK_SIZE = 1024;     // largest block
+
+        NodePool() : _freeList{ nullptr }, _freeTail{ nullptr }, _nextInBlock{ 0 }, _blockSize{ 0 } {}
+        NodePool( const NodePool& rhs ) = delete;
+        NodePool( NodePool&& rhs );
+        NodePool& operator=( const NodePool& rhs ) = delete;
+        NodePool& operator=( NodePool&& rhs );     // swaps the pools
+
+        /*
+        @brief Construct a node from args in a free slot.
+        @return Node*
+        */
+        template<typename... Args>
+        Node* allocate( Args&&... args );
+
+        /*
+        @brief Destroy node p and make its slot available again.
+        @return void
+        */
+        void release( Node* p );
+
+        /*
+        @brief Take over the blocks and free slots of rhs, which becomes
+               empty; nodes allocated from rhs now belong to this pool.
+               O(number of blocks). The unused slots at the end of one of the
+               two last blocks are given up until the pool is destroyed.
+        @return void
+        */
+        void splice( NodePool& rhs );
+
+    private:
+        union Slot {
+            Slot* next;
+            alignas(Node) unsigned char storage[sizeof(Node)];
+        };
+
+        Slot* _freeList;
+        Slot* _freeTail;                           // last free slot, if _freeList is not null
+        size_t _nextInBlock;                       // next unused slot in the last block
+        size_t _blockSize;                         // number of slots in the last block
+        std::vector<std::unique_ptr<Slot[]>> _blocks;
+
+        void _reset();
+};
+
+template<typename Node>
+NodePool<Node>::NodePool( NodePool&& rhs )
+    : _freeList{ rhs._freeList }, _freeTail{ rhs._freeTail }, _nextInBlock{ rhs._nextInBlock },
+      _blockSize{ rhs._blockSize }, _blocks{ std::move(rhs._blocks) } {
+    rhs._reset();
+}
+
+template<typename Node>
+NodePool<Node>& NodePool<Node>::operator=( NodePool&& rhs ) {
+    std::swap(_freeList, rhs._freeList);
+    std::swap(_freeTail, rhs._freeTail);
+    std::swap(_nextInBlock, rhs._nextInBlock);
+    std::swap(_blockSize, rhs._blockSize);
+    std::swap(_blocks, rhs._blocks);
+    return *this;
+}
+
+template<typename Node>
+template<typename... Args>
+Node* NodePool<Node>::allocate( Args&&... args ) {
+    Slot* slot;
+    if (_freeList != nullptr) {
+        slot = _freeList;
+        _freeList = slot->next;
+    }
+    else {
+        if (_nextInBlock == _blockSize) {
+            _blockSize = _blockSize == 0 ? FIRST_BLOCK_SIZE
+                         : 2 * _blockSize < BLOCK_SIZE ? 2 * _blockSize : BLOCK_SIZE;
+            _blocks.emplace_back(new Slot[_blockSize]);
+            _nextInBlock = 0;
+        }
+        slot = &_blocks.back()[_nextInBlock++];
+    }
+    return new (slot->storage) Node{ std::forward<Args>(args)... };
+}
+
+template<typename Node>
+void NodePool<Node>::release( Node* p ) {
+    p->~Node();
+    Slot* slot = reinterpret_cast<Slot*>(p);
+    slot->next = _freeList;
+    if (_freeList == nullptr) _freeTail = slot;
+    _freeList = slot;
+}
+
+template<typename Node>
+void NodePool<Node>::splice( NodePool& rhs ) {
+    if (this == &rhs) return;
+
+    if (rhs._freeList != nullptr) {
+        rhs._freeTail->next = _freeList;
+        if (_freeList == nullptr) _freeTail = rhs._freeTail;
+        _freeList = rhs._freeList;
+    }
+
+    // Keep carving from whichever last block has more unused slots; the
+    // blocks of rhs go in front of it.
+    size_t at = _blocks.size();
+    if (_blockSize - _nextInBlock >= rhs._blockSize - rhs._nextInBlock) {
+        if (at > 0) at -= 1;
+    }
+    else {
+        _nextInBlock = rhs._nextInBlock;
+        _blockSize = rhs._blockSize;
+    }
+    _blocks.insert(_blocks.begin() + at,
+                   std::make_move_iterator(rhs._blocks.begin()), std::make_move_iterator(rhs._blocks.end()));
+    rhs._reset();
+}
+
+template<typename Node>
+void NodePool<Node>::_reset() {
+    _freeList = _freeTail = nullptr;
+    _nextInBlock = _blockSize = 0;
+    _blocks.clear();
+}
+
+#endif
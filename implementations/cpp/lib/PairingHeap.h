@@ -0,0 +1,285 @@
+#ifndef PAIRING_HEAP_H
+#define PAIRING_HEAP_H
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include "NodePool.h"
+
+/*
+Pairing heap. A heap-ordered multiway tree stored as leftmost child/next
+sibling, with a back pointer to the parent (for a first child) or the left
+sibling. insert, merge and decreaseKey only link two trees, O(1); deleteMin
+re-pairs the root's children with the two-pass method in O(log n)
+amortized. insert returns a Position that decreaseKey uses to find the
+item; it is valid until that item is deleted.
+*/
+template<typename Comparable>
+class PairingHeap {
+    private:
+        struct PairNode;
+
+    public:
+        using Position = PairNode*;
+
+        PairingHeap();
+        PairingHeap( const PairingHeap& rhs ) = delete;            // heaps are merged, not copied
+        PairingHeap( PairingHeap&& rhs );                          // move constructor
+        PairingHeap& operator=( const PairingHeap& rhs ) = delete;
+        PairingHeap& operator=( PairingHeap&& rhs );               // move assignment
+        ~PairingHeap();
+
+        // Find the minimum item in the heap.
+        const Comparable& findMin() const;
+
+        // Insert item x, allowing duplicates. Return its position.
+        Position insert( const Comparable& x );
+        Position insert( Comparable&& x );
+
+        // Remove the minimum item.
+        void deleteMin();
+
+        // Remove the minimum item and place it in minItem.
+        void deleteMin( Comparable& minItem );
+
+        // Lower the item at position p to newValue, which must not be larger.
+        void decreaseKey( Position p, const Comparable& newValue );
+
+        // Merge rhs into this heap in O(1); rhs becomes empty.
+        void merge( PairingHeap& rhs );
+
+        // Check if heap is empty.
+        bool isEmpty() const;
+
+        // Return the number of items in the heap.
+        int size() const;
+
+        // Empty the heap.
+        void makeEmpty();
+
+    private:
+        struct PairNode {
+            Comparable item;
+            PairNode*  leftChild;
+            PairNode*  nextSibling;
+            PairNode*  prev;
+
+            PairNode( const Comparable& item )
+                : item{ item }, leftChild{ nullptr }, nextSibling{ nullptr }, prev{ nullptr } {}
+            PairNode( Comparable&& item )
+                : item{ std::move(item) }, leftChild{ nullptr }, nextSibling{ nullptr }, prev{ nullptr } {}
+        };
+
+        PairNode* _root;
+        int _currentSize;
+        std::vector<PairNode*> _treeArray; // scratch space for _combineSiblings
+
+        NodePool<PairNode> _pool;   // takes over the pool of rhs on merge
+
+        // Link two trees; return the root of the result.
+        PairNode* _compareAndLink( PairNode* first, PairNode* second );
+
+        // Two-pass pairing of a sibling list; return the root of the result.
+        PairNode* _combineSiblings( PairNode* firstSibling );
+
+        void _checkNotEmpty() const;
+};
+
+template<typename Comparable>
+PairingHeap<Comparable>::PairingHeap() : _root{ nullptr }, _currentSize{ 0 } {}
+
+template<typename Comparable>
+PairingHeap<Comparable>::PairingHeap( PairingHeap&& rhs )
+    : _root{ rhs._root }, _currentSize{ rhs._currentSize }, _pool{ std::move(rhs._pool) } {
+    rhs._root = nullptr;
+    rhs._currentSize = 0;
+}
+
+template<typename Comparable>
+PairingHeap<Comparable>& PairingHeap<Comparable>::operator=( PairingHeap&& rhs ) {
+    std::swap(_root, rhs._root);
+    std::swap(_currentSize, rhs._currentSize);
+    std::swap(_pool, rhs._pool);
+    return *this;
+}
+
+template<typename Comparable>
+PairingHeap<Comparable>::~PairingHeap() {
+    makeEmpty();
+}
+
+template<typename Comparable>
+const Comparable& PairingHeap<Comparable>::findMin() const {
+    _checkNotEmpty();
+    return _root->item;
+}
+
+template<typename Comparable>
+typename PairingHeap<Comparable>::Position PairingHeap<Comparable>::insert( const Comparable& x ) {
+    PairNode* newNode = _pool.allocate(x);
+    _root = _root == nullptr ? newNode : _compareAndLink(_root, newNode);
+    _currentSize += 1;
+    return newNode;
+}
+
+template<typename Comparable>
+typename PairingHeap<Comparable>::Position PairingHeap<Comparable>::insert( Comparable&& x ) {
+    PairNode* newNode = _pool.allocate(std::move(x));
+    _root = _root == nullptr ? newNode : _compareAndLink(_root, newNode);
+    _currentSize += 1;
+    return newNode;
+}
+
+template<typename Comparable>
+void PairingHeap<Comparable>::deleteMin() {
+    _checkNotEmpty();
+
+    PairNode* oldRoot = _root;
+    _root = _root->leftChild == nullptr ? nullptr : _combineSiblings(_root->leftChild);
+    _pool.release(oldRoot);
+    _currentSize -= 1;
+}
+
+template<typename Comparable>
+void PairingHeap<Comparable>::deleteMin( Comparable& minItem ) {
+    _checkNotEmpty();
+    minItem = std::move(_root->item);
+    deleteMin();
+}
+
+/*
+Cut the subtree rooted at p out of its sibling list and link it with the
+root again.
+*/
+template<typename Comparable>
+void PairingHeap<Comparable>::decreaseKey( Position p, const Comparable& newValue ) {
+    if (p->item < newValue) {
+        std::cout << "Error: decreaseKey called with a larger value\n";
+        std::abort();
+    }
+
+    p->item = newValue;
+    if (p != _root) {
+        if (p->nextSibling != nullptr) {
+            p->nextSibling->prev = p->prev;
+        }
+        if (p->prev->leftChild == p) {
+            p->prev->leftChild = p->nextSibling;
+        }
+        else {
+            p->prev->nextSibling = p->nextSibling;
+        }
+
+        p->nextSibling = nullptr;
+        p->prev = nullptr;
+        _root = _compareAndLink(_root, p);
+    }
+}
+
+template<typename Comparable>
+void PairingHeap<Comparable>::merge( PairingHeap& rhs ) {
+    if (this == &rhs || rhs._root == nullptr) return;
+
+    _root = _root == nullptr ? rhs._root : _compareAndLink(_root, rhs._root);
+    _currentSize += rhs._currentSize;
+    rhs._root = nullptr;
+    rhs._currentSize = 0;
+    _pool.splice(rhs._pool);
+}
+
+template<typename Comparable>
+bool PairingHeap<Comparable>::isEmpty() const {
+    return _root == nullptr;
+}
+
+template<typename Comparable>
+int PairingHeap<Comparable>::size() const {
+    return _currentSize;
+}
+
+template<typename Comparable>
+void PairingHeap<Comparable>::makeEmpty() {
+    std::vector<PairNode*> stack;
+    if (_root != nullptr) stack.push_back(_root);
+
+    while (!stack.empty()) {
+        PairNode* t = stack.back();
+        stack.pop_back();
+        if (t->leftChild != nullptr)   stack.push_back(t->leftChild);
+        if (t->nextSibling != nullptr) stack.push_back(t->nextSibling);
+        _pool.release(t);
+    }
+
+    _root = nullptr;
+    _currentSize = 0;
+}
+
+/*
+@brief The root with the larger item becomes the leftmost child of the
+       other. Both arguments are tree roots with no siblings.
+@return PairNode*
+*/
+template<typename Comparable>
+typename PairingHeap<Comparable>::PairNode*
+PairingHeap<Comparable>::_compareAndLink( PairNode* first, PairNode* second ) {
+    if (second->item < first->item) std::swap(first, second);
+
+    second->prev = first;
+    second->nextSibling = first->leftChild;
+    if (second->nextSibling != nullptr) {
+        second->nextSibling->prev = second;
+    }
+    first->leftChild = second;
+    first->nextSibling = nullptr;
+    first->prev = nullptr;
+    return first;
+}
+
+/*
+@brief First pass: link siblings in pairs from left to right. Second pass:
+       link the results from right to left into a single tree.
+@return PairNode*
+*/
+template<typename Comparable>
+typename PairingHeap<Comparable>::PairNode*
+PairingHeap<Comparable>::_combineSiblings( PairNode* firstSibling ) {
+    _treeArray.clear();
+    for (PairNode* t = firstSibling; t != nullptr; ) {
+        PairNode* next = t->nextSibling;
+        t->prev = nullptr;
+        t->nextSibling = nullptr;
+        _treeArray.push_back(t);
+        t = next;
+    }
+
+    int numSiblings = static_cast<int>(_treeArray.size());
+    if (numSiblings == 1) return _treeArray[0];
+
+    int i = 0;
+    for (; i + 1 < numSiblings; i += 2) {
+        _treeArray[i] = _compareAndLink(_treeArray[i], _treeArray[i + 1]);
+    }
+
+    // j is the index of the last tree produced by the first pass
+    int j = i - 2;
+    if (j == numSiblings - 3) {
+        _treeArray[j] = _compareAndLink(_treeArray[j], _treeArray[j + 2]);
+    }
+
+    for (; j >= 2; j -= 2) {
+        _treeArray[j - 2] = _compareAndLink(_treeArray[j - 2], _treeArray[j]);
+    }
+    return _treeArray[0];
+}
+
+template<typename Comparable>
+void PairingHeap<Comparable>::_checkNotEmpty() const {
+    if (isEmpty()) {
+        std::cout << "Error: Underflow\n";
+        std::abort();
+    }
+}
+
+#endif
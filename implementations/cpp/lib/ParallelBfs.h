@@ -0,0 +1,221 @@
+#ifndef PARALLEL_BFS_H
+#define PARALLEL_BFS_H
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+
+#include "Graph.h"
+#include "TaskScheduler.h"
+
+/*
+Direction-optimizing breadth-first search (Beamer, Asanovic and Patterson)
+on a TaskScheduler. The search goes level by level, each level in parallel,
+in one of two directions:
+  top-down:  every frontier vertex claims its unvisited neighbours, with
+             an atomic test-and-set on the visited bitmap so each vertex is
+             claimed once. Cheap while the frontier is small.
+  bottom-up: every unvisited vertex scans its in-edges for a parent on the
+             frontier bitmap and stops at the first one. On low-diameter
+             graphs the middle levels hold most of the vertices, and then
+             most unvisited vertices find a parent after a few edges, while
+             top-down would check nearly every edge of the graph.
+The search turns bottom-up when the edges leaving the frontier exceed
+1/alpha of the edges left unexplored, and back top-down once the frontier
+is shrinking and holds less than 1/beta of the vertices.
+*/
+
+namespace parallel_bfs_detail {
+    // One bit per vertex, settable from many threads.
+    class Bitmap {
+        public:
+            explicit Bitmap( int numBits )
+                : _numWords{ (numBits + 63) / 64 },
+                  _words{ new std::atomic<std::uint64_t>[_numWords] } {
+                clear();
+            }
+
+            int numWords() const { return _numWords; }
+
+            void clear() {
+                for (int i = 0; i < _numWords; ++i) _words[i].store(0, std::memory_order_relaxed);
+            }
+
+            bool test( Vertex v ) const {
+                return (_words[v >> 6].load(std::memory_order_relaxed) >> (v & 63)) & 1;
+            }
+
+            // Set bit v; return false if it was set already.
+            bool testAndSet( Vertex v ) {
+                std::uint64_t bit = std::uint64_t{ 1 } << (v & 63);
+                if (_words[v >> 6].load(std::memory_order_relaxed) & bit) return false;
+                return !(_words[v >> 6].fetch_or(bit, std::memory_order_relaxed) & bit);
+            }
+
+            std::uint64_t word( int i ) const { return _words[i].load(std::memory_order_relaxed); }
+            void setWord( int i, std::uint64_t w ) { _words[i].store(w, std::memory_order_relaxed); }
+
+        private:
+            int _numWords;
+            std::unique_ptr<std::atomic<std::uint64_t>[]> _words;
+    };
+
+    // Fewest frontier vertices, edges or bitmap words worth a task.
+    const int GRAIN = 2048;
+
+    // What one block of a level found: new vertices and the edges leaving
+    // them. Blocks count in locals and store here once, since neighbouring
+    // counts share a cache line.
+    struct LevelCount {
+        std::int64_t vertices = 0;
+        std::int64_t edges = 0;
+    };
+}
+
+/*
+@brief Unweighted shortest paths from s, as unweighted in Graph.h, by a
+       parallel direction-optimizing BFS. reverse must be g.transpose(),
+       or g itself if every edge of g has its reverse edge in g. The
+       distances equal those of unweighted; path may name a different
+       parent among the vertices one level closer to s.
+@return ShortestPaths<int>, distances in edges
+*/
+template<typename Weight>
+ShortestPaths<int> parallelUnweighted( const Graph<Weight>& g, const Graph<Weight>& reverse, Vertex s,
+                                       TaskScheduler& scheduler, int alpha = 15, int beta = 18 ) {
+    using namespace parallel_bfs_detail;
+
+    int n = g.numVertices();
+    ShortestPaths<int> result;
+    result.dist.assign(n, ShortestPaths<int>::INFINITY_DISTANCE);
+    result.path.assign(n, NOT_A_VERTEX);
+    int* dist = result.dist.data();
+    Vertex* path = result.path.data();
+
+    Bitmap visited{ n }, front{ n }, next{ n };
+    std::vector<Vertex> frontier{ s };
+    std::vector<std::vector<Vertex>> found;
+    std::vector<LevelCount> counts;
+
+    visited.testAndSet(s);
+    dist[s] = 0;
+    std::int64_t frontierEdges = g.outDegree(s);
+    std::int64_t uncheckedEdges = g.numEdges() - frontierEdges;
+    std::int64_t frontierSize = 1, lastFrontierSize = 0;
+    bool topDown = true;
+
+    // Gather the per-block vertex lists into the frontier queue.
+    auto concatenate = [&]( int blocks ) {
+        std::vector<std::size_t> start(blocks + 1, 0);
+        for (int b = 0; b < blocks; ++b) start[b + 1] = start[b] + found[b].size();
+        frontier.resize(start[blocks]);
+        parallelFor(blocks, scheduler, [&]( int b ) {
+            std::copy(found[b].begin(), found[b].end(), frontier.begin() + start[b]);
+        });
+    };
+
+    for (int level = 0; frontierSize > 0; ++level) {
+        if (topDown && frontierEdges > uncheckedEdges / alpha) {
+            // queue to bitmap
+            topDown = false;
+            front.clear();
+            int blocks = numBlocks(frontierSize, scheduler, GRAIN);
+            parallelFor(blocks, scheduler, [&]( int b ) {
+                std::size_t first = frontier.size() * b / blocks, last = frontier.size() * (b + 1) / blocks;
+                for (std::size_t i = first; i < last; ++i) front.testAndSet(frontier[i]);
+            });
+        }
+        else if (!topDown && frontierSize < lastFrontierSize && frontierSize < n / beta) {
+            // bitmap to queue
+            topDown = true;
+            int blocks = numBlocks(front.numWords(), scheduler, GRAIN);
+            found.resize(blocks);
+            parallelFor(blocks, scheduler, [&]( int b ) {
+                found[b].clear();
+                int first = front.numWords() * b / blocks, last = front.numWords() * (b + 1) / blocks;
+                for (int i = first; i < last; ++i) {
+                    for (std::uint64_t w = front.word(i); w != 0; w &= w - 1) {
+                        found[b].push_back(64 * i + __builtin_ctzll(w));
+                    }
+                }
+            });
+            concatenate(blocks);
+        }
+
+        int blocks;
+        if (topDown) {
+            blocks = numBlocks(frontierEdges, scheduler, GRAIN);
+            found.resize(blocks);
+            counts.assign(blocks, LevelCount{});
+            parallelFor(blocks, scheduler, [&]( int b ) {
+                std::vector<Vertex>& mine = found[b];
+                std::int64_t edges = 0;
+                mine.clear();
+                std::size_t first = frontier.size() * b / blocks, last = frontier.size() * (b + 1) / blocks;
+                for (std::size_t i = first; i < last; ++i) {
+                    Vertex v = frontier[i];
+                    for (Vertex w : g.adjacent(v)) {
+                        if (visited.testAndSet(w)) {
+                            dist[w] = level + 1;
+                            path[w] = v;
+                            mine.push_back(w);
+                            edges += g.outDegree(w);
+                        }
+                    }
+                }
+                counts[b].vertices = static_cast<std::int64_t>(mine.size());
+                counts[b].edges = edges;
+            });
+            concatenate(blocks);
+        }
+        else {
+            // blocks of whole bitmap words, so no two tasks share a word
+            blocks = numBlocks(n, scheduler, GRAIN);
+            counts.assign(blocks, LevelCount{});
+            parallelFor(blocks, scheduler, [&]( int b ) {
+                std::int64_t vertices = 0, edges = 0;
+                int first = visited.numWords() * static_cast<std::int64_t>(b) / blocks;
+                int last = visited.numWords() * static_cast<std::int64_t>(b + 1) / blocks;
+                for (int i = first; i < last; ++i) {
+                    std::uint64_t seen = visited.word(i), added = 0;
+                    std::uint64_t unseen = ~seen;
+                    if (i == visited.numWords() - 1 && n % 64 != 0) {
+                        unseen &= (std::uint64_t{ 1 } << (n % 64)) - 1;
+                    }
+                    for (; unseen != 0; unseen &= unseen - 1) {
+                        Vertex w = 64 * i + __builtin_ctzll(unseen);
+                        for (Vertex v : reverse.adjacent(w)) {
+                            if (front.test(v)) {
+                                dist[w] = level + 1;
+                                path[w] = v;
+                                added |= std::uint64_t{ 1 } << (w & 63);
+                                vertices += 1;
+                                edges += g.outDegree(w);
+                                break;
+                            }
+                        }
+                    }
+                    visited.setWord(i, seen | added);
+                    next.setWord(i, added);
+                }
+                counts[b].vertices = vertices;
+                counts[b].edges = edges;
+            });
+            std::swap(front, next);
+        }
+
+        lastFrontierSize = frontierSize;
+        frontierSize = 0;
+        frontierEdges = 0;
+        for (const LevelCount& count : counts) {
+            frontierSize += count.vertices;
+            frontierEdges += count.edges;
+        }
+        uncheckedEdges -= frontierEdges;
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,221 @@
+#ifndef PARALLEL_SORT_H
+#define PARALLEL_SORT_H
+
+#include <vector>
+#include <iterator>
+#include <functional>
+#include <algorithm>
+#include <random>
+#include <cstdint>
+
+#include "Sorting.h"
+#include "BinarySearch.h"
+#include "TaskScheduler.h"
+
+/*
+Multi-core sorts on a work-stealing TaskScheduler:
+  parallelMergeSort:  stable fork-join mergesort whose merges are split in
+                      parallel too, O(N log N) work and O(log^3 N) span
+  parallelSampleSort: one pass that scatters the items into buckets by
+                      sampled splitters, then sorts every bucket on its own
+*/
+
+namespace parallel_sort_detail {
+    // Ranges at most this long are sorted or merged by one thread.
+    template<typename Iterator>
+    std::ptrdiff_t cutoff( Iterator begin, Iterator end, const TaskScheduler& scheduler ) {
+        std::ptrdiff_t perTask = (end - begin) / (8 * scheduler.numThreads());
+        return perTask < 8192 ? 8192 : perTask;
+    }
+
+    /*
+    @brief Stable merge of the sorted ranges [left, left + nl) and
+           [right, right + nr) into out. Large merges are split at the
+           middle item x of the longer range and the position of x in the
+           other range, and the two halves are merged in parallel.
+    @return void
+    */
+    template<typename InIt, typename OutIt, typename Comparator>
+    void parallelMerge( InIt left, std::ptrdiff_t nl, InIt right, std::ptrdiff_t nr, OutIt out,
+                        std::ptrdiff_t grain, TaskScheduler& scheduler, Comparator lessThan ) {
+        if (nl + nr <= grain) {
+            std::ptrdiff_t i = 0, j = 0;
+            while (i < nl && j < nr) {
+                if (lessThan(right[j], left[i])) { *out++ = std::move(right[j++]); }
+                else                             { *out++ = std::move(left[i++]);  }
+            }
+            out = std::move(left + i, left + nl, out);
+            std::move(right + j, right + nr, out);
+            return;
+        }
+
+        // ties keep left items ahead of right items
+        std::ptrdiff_t ml, mr;
+        if (nl >= nr) {
+            ml = nl / 2;
+            mr = lowerBound(right, right + nr, left[ml], lessThan) - right;
+            out[ml + mr] = std::move(left[ml]);
+        }
+        else {
+            mr = nr / 2;
+            ml = upperBound(left, left + nl, right[mr], lessThan) - left;
+            out[ml + mr] = std::move(right[mr]);
+        }
+        std::ptrdiff_t skipLeft = nl >= nr ? 1 : 0;
+
+        TaskScheduler::TaskGroup group;
+        scheduler.spawn(group, [=, &scheduler]() {
+            parallelMerge(left, ml, right, mr, out, grain, scheduler, lessThan);
+        });
+        parallelMerge(left + ml + skipLeft, nl - ml - skipLeft, right + mr + (1 - skipLeft), nr - mr - (1 - skipLeft),
+                      out + ml + mr + 1, grain, scheduler, lessThan);
+        scheduler.wait(group);
+    }
+
+    /*
+    @brief Sort [a, a + n), leaving the result in a, or in tmp if toBuffer.
+           The halves are sorted into the other array, so each level of
+           the recursion moves every item exactly once.
+    @return void
+    */
+    template<typename Iterator, typename BufferIt, typename Comparator>
+    void parallelMergeSort( Iterator a, BufferIt tmp, std::ptrdiff_t n, bool toBuffer,
+                            std::ptrdiff_t grain, TaskScheduler& scheduler, Comparator lessThan ) {
+        if (n <= grain) {
+            thread_local std::vector<typename std::iterator_traits<Iterator>::value_type> buffer;
+            mergeSort(a, a + n, buffer, lessThan);
+            if (toBuffer) std::move(a, a + n, tmp);
+            return;
+        }
+
+        std::ptrdiff_t half = n / 2;
+        TaskScheduler::TaskGroup group;
+        scheduler.spawn(group, [=, &scheduler]() {
+            parallelMergeSort(a, tmp, half, !toBuffer, grain, scheduler, lessThan);
+        });
+        parallelMergeSort(a + half, tmp + half, n - half, !toBuffer, grain, scheduler, lessThan);
+        scheduler.wait(group);
+
+        if (toBuffer) {
+            parallelMerge(a, half, a + half, n - half, tmp, grain, scheduler, lessThan);
+        }
+        else {
+            parallelMerge(tmp, half, tmp + half, n - half, a, grain, scheduler, lessThan);
+        }
+    }
+}
+
+/*
+@brief Stable parallel mergesort. Uses a buffer of N items.
+@return void
+*/
+template<typename Iterator, typename Comparator = std::less<>>
+void parallelMergeSort( Iterator begin, Iterator end, TaskScheduler& scheduler,
+                        Comparator lessThan = Comparator{} ) {
+    std::ptrdiff_t grain = parallel_sort_detail::cutoff(begin, end, scheduler);
+    if (end - begin <= grain) {
+        mergeSort(begin, end, lessThan);
+        return;
+    }
+
+    std::vector<typename std::iterator_traits<Iterator>::value_type> buffer(end - begin);
+    parallel_sort_detail::parallelMergeSort(begin, buffer.begin(), end - begin, false,
+                                            grain, scheduler, lessThan);
+}
+
+/*
+@brief Parallel sample sort. A sorted random sample picks B - 1 splitters
+       for B = 4P buckets. Each of 4P blocks of the input counts how many
+       of its items fall in each bucket, prefix sums over (bucket, block)
+       give every block a private output slot per bucket, the blocks
+       scatter their items into a buffer in parallel, and the buckets are
+       sorted with introSort in parallel and moved back. If the sample
+       repeats a splitter, the splitters are made distinct and each one
+       gets a bucket of its own for the items equal to it, which needs no
+       sort; few distinct keys then still spread over the threads instead
+       of piling up in one bucket. Not stable. Uses a buffer of N items and
+       N bucket numbers.
+@return void
+*/
+template<typename Iterator, typename Comparator = std::less<>>
+void parallelSampleSort( Iterator begin, Iterator end, TaskScheduler& scheduler,
+                         Comparator lessThan = Comparator{} ) {
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    const int OVERSAMPLE = 32;
+
+    std::ptrdiff_t n = end - begin;
+    int numThreads = scheduler.numThreads();
+    if (numThreads == 1 || n <= 2 * parallel_sort_detail::cutoff(begin, end, scheduler)) {
+        introSort(begin, end, lessThan);
+        return;
+    }
+
+    int numBuckets = std::min(4 * numThreads, 32767);
+    int numBlocks = 4 * numThreads;
+
+    std::mt19937_64 gen{ static_cast<std::uint64_t>(n) };
+    std::vector<T> sample(static_cast<size_t>(numBuckets) * OVERSAMPLE);
+    for (auto& s : sample) s = begin[gen() % n];
+    introSort(sample.begin(), sample.end(), lessThan);
+
+    std::vector<T> splitters;
+    for (int b = 1; b < numBuckets; ++b) {
+        const T& s = sample[static_cast<size_t>(b) * OVERSAMPLE];
+        if (splitters.empty() || lessThan(splitters.back(), s)) splitters.push_back(s);
+    }
+
+    // With equal buckets, bucket 2j holds the items between splitters j - 1
+    // and j, and bucket 2j + 1 the items equal to splitter j.
+    bool equalBuckets = static_cast<int>(splitters.size()) < numBuckets - 1;
+    int numSplitters = static_cast<int>(splitters.size());
+    numBuckets = equalBuckets ? 2 * numSplitters + 1 : numSplitters + 1;
+    auto bucket = [&]( const T& x ) {
+        int j = static_cast<int>(upperBound(splitters.begin(), splitters.end(), x, lessThan) - splitters.begin());
+        if (!equalBuckets) return j;
+        return j > 0 && !lessThan(splitters[j - 1], x) ? 2 * j - 1 : 2 * j;
+    };
+
+    // counts[block * numBuckets + bucket], then output offsets
+    std::vector<std::ptrdiff_t> counts(static_cast<size_t>(numBlocks) * numBuckets, 0);
+    std::vector<std::uint16_t> bucketOf(n);
+    auto blockBegin = [n, numBlocks]( int block ) { return n * block / numBlocks; };
+
+    parallelFor(numBlocks, scheduler, [&]( int block ) {
+        std::ptrdiff_t* count = &counts[static_cast<size_t>(block) * numBuckets];
+        for (std::ptrdiff_t i = blockBegin(block); i < blockBegin(block + 1); ++i) {
+            int b = bucket(begin[i]);
+            bucketOf[i] = static_cast<std::uint16_t>(b);
+            count[b] += 1;
+        }
+    });
+
+    std::vector<std::ptrdiff_t> bucketStart(numBuckets + 1);
+    std::ptrdiff_t sum = 0;
+    for (int b = 0; b < numBuckets; ++b) {
+        bucketStart[b] = sum;
+        for (int block = 0; block < numBlocks; ++block) {
+            std::ptrdiff_t& c = counts[static_cast<size_t>(block) * numBuckets + b];
+            std::ptrdiff_t next = sum + c;
+            c = sum;
+            sum = next;
+        }
+    }
+    bucketStart[numBuckets] = n;
+
+    std::vector<T> buffer(n);
+    parallelFor(numBlocks, scheduler, [&]( int block ) {
+        std::ptrdiff_t* offset = &counts[static_cast<size_t>(block) * numBuckets];
+        for (std::ptrdiff_t i = blockBegin(block); i < blockBegin(block + 1); ++i) {
+            buffer[offset[bucketOf[i]]++] = std::move(begin[i]);
+        }
+    });
+
+    parallelFor(numBuckets, scheduler, [&]( int b ) {
+        auto first = buffer.begin() + bucketStart[b];
+        auto last = buffer.begin() + bucketStart[b + 1];
+        if (!equalBuckets || b % 2 == 0) introSort(first, last, lessThan);
+        std::move(first, last, begin + bucketStart[b]);
+    });
+}
+
+#endif
@@ -0,0 +1,426 @@
+#ifndef PERSISTENT_AVL_TREE_H
+#define PERSISTENT_AVL_TREE_H
+
+#include <iostream>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+/*
+AVL tree with path copying. Nodes are immutable once published: insert and
+remove copy only the O(log n) nodes on the search path (plus the few nodes
+touched by rotations) and share every other subtree with the previous
+version. The current root is swapped in with an atomic store, so readers
+take a Snapshot with a single atomic load and never take the writer mutex.
+The tree is thread-safe but not lock-free: std::atomic<std::shared_ptr>
+(C++20) and the std::atomic_load/store functions used before it both
+guard the reference count with a small internal lock, held only for the
+load or store itself. Versions are reclaimed through reference counting
+when the last snapshot that can reach them is dropped. Writers are
+serialized by a mutex.
+*/
+template<typename Comparable>
+class PersistentAVLTree {
+    private:
+        struct AVLNode;
+        using NodePtr = std::shared_ptr<const AVLNode>;
+
+    public:
+        /*
+        Immutable version of the tree. Copying a snapshot is O(1) and it stays
+        valid and unchanged however the tree is modified afterwards.
+        */
+        class Snapshot {
+            public:
+                /*
+                @brief Find the smallest item in the snapshot.
+                @return Comparable&
+                */
+                const Comparable& findMin() const;
+
+                /*
+                @brief Find the largest item in the snapshot.
+                @return Comparable&
+                */
+                const Comparable& findMax() const;
+
+                /*
+                @brief Check if item x is in the snapshot.
+                @return bool
+                */
+                bool contains( const Comparable& x ) const;
+
+                /*
+                @brief Check if the snapshot is empty.
+                @return bool
+                */
+                bool isEmpty() const;
+
+                /*
+                @brief Print the snapshot in order.
+                @return void
+                */
+                void printTree( std::ostream& out = std::cout ) const;
+
+            private:
+                NodePtr _root;
+
+                explicit Snapshot( NodePtr root ) : _root{ std::move(root) } {}
+
+                friend class PersistentAVLTree<Comparable>;
+        };
+
+        // zero-parameter constructor
+        PersistentAVLTree();
+        // copy constructor; shares every node with rhs, O(1)
+        PersistentAVLTree( const PersistentAVLTree& rhs );
+        // copy assignment; O(1)
+        PersistentAVLTree& operator=( const PersistentAVLTree& rhs );
+
+        /*
+        @brief Take an immutable snapshot of the current version without
+               locking.
+        @return Snapshot
+        */
+        Snapshot snapshot() const;
+
+        /*
+        @brief Find the smallest item in the current version. Returned by
+               value: a concurrent update may drop the node holding it.
+        @return Comparable
+        */
+        Comparable findMin() const;
+
+        /*
+        @brief Find the largest item in the current version, by value.
+        @return Comparable
+        */
+        Comparable findMax() const;
+
+        /*
+        @brief Check if an item x is in the current version.
+        @return bool
+        */
+        bool contains( const Comparable& x ) const;
+
+        /*
+        @brief Check if tree is empty.
+        @return bool
+        */
+        bool isEmpty() const;
+
+        /*
+        @brief Make the tree logically empty. Existing snapshots are kept.
+        @return void
+        */
+        void makeEmpty();
+
+        /*
+        @brief Publish a version with item x inserted; duplicates are
+               ignored.
+        @return void
+        */
+        void insert( const Comparable& x );
+
+        /*
+        @brief Publish a version with item x removed.
+        @return void
+        */
+        void remove( const Comparable& x );
+
+        /*
+        @brief Print the current version in order.
+        @return void
+        */
+        void printTree( std::ostream& out = std::cout ) const;
+
+    private:
+        struct AVLNode {
+            Comparable item;
+            NodePtr left;
+            NodePtr right;
+            int height;
+
+            AVLNode( const Comparable& item, NodePtr left, NodePtr right, int h )
+                : item{ item }, left{ std::move(left) }, right{ std::move(right) }, height{ h } {}
+        };
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+        std::atomic<NodePtr> _root;
+#else
+        NodePtr _root;            // only accessed through std::atomic_load/store
+#endif
+        mutable std::mutex _writeLock;
+        static const int ALLOWED_IMBALANCE = 1;
+
+        NodePtr _load() const;
+        void _store( NodePtr root );
+
+        static NodePtr _insert( const Comparable& x, const NodePtr& t );
+        static NodePtr _remove( const Comparable& x, const NodePtr& t );
+        static NodePtr _removeMin( const NodePtr& t );
+        static NodePtr _balance( const Comparable& item, const NodePtr& left, const NodePtr& right );
+        static NodePtr _makeNode( const Comparable& item, const NodePtr& left, const NodePtr& right );
+        static const AVLNode* _findMin( const AVLNode* t );
+        static const AVLNode* _findMax( const AVLNode* t );
+        static bool _contains( const Comparable& x, const AVLNode* t );
+        static int _height( const NodePtr& t );
+        static void _print( std::ostream& out, const AVLNode* t );
+};
+
+// SNAPSHOT
+
+template<typename Comparable>
+const Comparable& PersistentAVLTree<Comparable>::Snapshot::findMin() const {
+    return _findMin(_root.get())->item;
+}
+
+template<typename Comparable>
+const Comparable& PersistentAVLTree<Comparable>::Snapshot::findMax() const {
+    return _findMax(_root.get())->item;
+}
+
+template<typename Comparable>
+bool PersistentAVLTree<Comparable>::Snapshot::contains( const Comparable& x ) const {
+    return _contains(x, _root.get());
+}
+
+template<typename Comparable>
+bool PersistentAVLTree<Comparable>::Snapshot::isEmpty() const {
+    return _root == nullptr;
+}
+
+template<typename Comparable>
+void PersistentAVLTree<Comparable>::Snapshot::printTree( std::ostream& out ) const {
+    if (isEmpty()) {
+        out << "Empty tree\n";
+    }
+    else {
+        _print(out, _root.get());
+        out << "\n";
+    }
+}
+
+// PUBLIC
+
+template<typename Comparable>
+PersistentAVLTree<Comparable>::PersistentAVLTree() : _root{ nullptr } {}
+
+template<typename Comparable>
+PersistentAVLTree<Comparable>::PersistentAVLTree( const PersistentAVLTree& rhs ) : _root{ rhs._load() } {}
+
+template<typename Comparable>
+PersistentAVLTree<Comparable>& PersistentAVLTree<Comparable>::operator=( const PersistentAVLTree& rhs ) {
+    if (this != &rhs) {
+        std::lock_guard<std::mutex> guard{ _writeLock };
+        _store(rhs._load());
+    }
+    return *this;
+}
+
+template<typename Comparable>
+typename PersistentAVLTree<Comparable>::Snapshot PersistentAVLTree<Comparable>::snapshot() const {
+    return Snapshot{ _load() };
+}
+
+template<typename Comparable>
+Comparable PersistentAVLTree<Comparable>::findMin() const {
+    NodePtr root = _load();
+    return _findMin(root.get())->item;
+}
+
+template<typename Comparable>
+Comparable PersistentAVLTree<Comparable>::findMax() const {
+    NodePtr root = _load();
+    return _findMax(root.get())->item;
+}
+
+template<typename Comparable>
+bool PersistentAVLTree<Comparable>::contains( const Comparable& x ) const {
+    return _contains(x, _load().get());
+}
+
+template<typename Comparable>
+bool PersistentAVLTree<Comparable>::isEmpty() const {
+    return _load() == nullptr;
+}
+
+template<typename Comparable>
+void PersistentAVLTree<Comparable>::makeEmpty() {
+    std::lock_guard<std::mutex> guard{ _writeLock };
+    _store(nullptr);
+}
+
+template<typename Comparable>
+void PersistentAVLTree<Comparable>::insert( const Comparable& x ) {
+    std::lock_guard<std::mutex> guard{ _writeLock };
+    _store(_insert(x, _load()));
+}
+
+template<typename Comparable>
+void PersistentAVLTree<Comparable>::remove( const Comparable& x ) {
+    std::lock_guard<std::mutex> guard{ _writeLock };
+    _store(_remove(x, _load()));
+}
+
+template<typename Comparable>
+void PersistentAVLTree<Comparable>::printTree( std::ostream& out ) const {
+    snapshot().printTree(out);
+}
+
+// PRIVATE
+
+template<typename Comparable>
+typename PersistentAVLTree<Comparable>::NodePtr PersistentAVLTree<Comparable>::_load() const {
+#if defined(__cpp_lib_atomic_shared_ptr)
+    return _root.load();
+#else
+    return std::atomic_load(&_root);
+#endif
+}
+
+template<typename Comparable>
+void PersistentAVLTree<Comparable>::_store( NodePtr root ) {
+#if defined(__cpp_lib_atomic_shared_ptr)
+    _root.store(std::move(root));
+#else
+    std::atomic_store(&_root, std::move(root));
+#endif
+}
+
+/*
+@brief Return the root of a version of t with x inserted. Returns t itself
+       when x is already present so nothing is copied.
+@return NodePtr
+*/
+template<typename Comparable>
+typename PersistentAVLTree<Comparable>::NodePtr
+PersistentAVLTree<Comparable>::_insert( const Comparable& x, const NodePtr& t ) {
+    if (t == nullptr) { return _makeNode(x, nullptr, nullptr); }
+
+    if (x < t->item) {
+        NodePtr left = _insert(x, t->left);
+        return left == t->left ? t : _balance(t->item, left, t->right);
+    }
+    else if (t->item < x) {
+        NodePtr right = _insert(x, t->right);
+        return right == t->right ? t : _balance(t->item, t->left, right);
+    }
+    return t; // Duplicate; share the existing node
+}
+
+/*
+@brief Return the root of a version of t with x removed. Returns t itself
+       when x is not present.
+@return NodePtr
+*/
+template<typename Comparable>
+typename PersistentAVLTree<Comparable>::NodePtr
+PersistentAVLTree<Comparable>::_remove( const Comparable& x, const NodePtr& t ) {
+    if (t == nullptr) { return t; }
+
+    if (x < t->item) {
+        NodePtr left = _remove(x, t->left);
+        return left == t->left ? t : _balance(t->item, left, t->right);
+    }
+    else if (t->item < x) {
+        NodePtr right = _remove(x, t->right);
+        return right == t->right ? t : _balance(t->item, t->left, right);
+    }
+    else if (t->left != nullptr && t->right != nullptr) {
+        return _balance(_findMin(t->right.get())->item, t->left, _removeMin(t->right));
+    }
+    return t->left != nullptr ? t->left : t->right;
+}
+
+template<typename Comparable>
+typename PersistentAVLTree<Comparable>::NodePtr
+PersistentAVLTree<Comparable>::_removeMin( const NodePtr& t ) {
+    if (t->left == nullptr) { return t->right; }
+    return _balance(t->item, _removeMin(t->left), t->right);
+}
+
+/*
+@brief Build a balanced node from item and two subtrees whose heights
+       differ by at most two. Rotations build new nodes instead of
+       relinking the old ones, which may be shared with other versions.
+@return NodePtr
+*/
+template<typename Comparable>
+typename PersistentAVLTree<Comparable>::NodePtr
+PersistentAVLTree<Comparable>::_balance( const Comparable& item, const NodePtr& left, const NodePtr& right ) {
+    if (_height(left) - _height(right) > ALLOWED_IMBALANCE) {
+        if (_height(left->left) >= _height(left->right)) {
+            // left-left single rotation
+            return _makeNode(left->item, left->left, _makeNode(item, left->right, right));
+        }
+        // left-right double rotation
+        const NodePtr& lr = left->right;
+        return _makeNode(lr->item, _makeNode(left->item, left->left, lr->left),
+                                   _makeNode(item, lr->right, right));
+    }
+    else if (_height(right) - _height(left) > ALLOWED_IMBALANCE) {
+        if (_height(right->right) >= _height(right->left)) {
+            // right-right single rotation
+            return _makeNode(right->item, _makeNode(item, left, right->left), right->right);
+        }
+        // right-left double rotation
+        const NodePtr& rl = right->left;
+        return _makeNode(rl->item, _makeNode(item, left, rl->left),
+                                   _makeNode(right->item, rl->right, right->right));
+    }
+
+    return _makeNode(item, left, right);
+}
+
+template<typename Comparable>
+typename PersistentAVLTree<Comparable>::NodePtr
+PersistentAVLTree<Comparable>::_makeNode( const Comparable& item, const NodePtr& left, const NodePtr& right ) {
+    int h = std::max(_height(left), _height(right)) + 1;
+    return std::make_shared<const AVLNode>(item, left, right, h);
+}
+
+template<typename Comparable>
+const typename PersistentAVLTree<Comparable>::AVLNode*
+PersistentAVLTree<Comparable>::_findMin( const AVLNode* t ) {
+    if (t != nullptr) {
+        while (t->left != nullptr) t = t->left.get();
+    }
+    return t;
+}
+
+template<typename Comparable>
+const typename PersistentAVLTree<Comparable>::AVLNode*
+PersistentAVLTree<Comparable>::_findMax( const AVLNode* t ) {
+    if (t != nullptr) {
+        while (t->right != nullptr) t = t->right.get();
+    }
+    return t;
+}
+
+template<typename Comparable>
+bool PersistentAVLTree<Comparable>::_contains( const Comparable& x, const AVLNode* t ) {
+    while (t != nullptr) {
+        if      (x < t->item) { t = t->left.get();  }
+        else if (t->item < x) { t = t->right.get(); }
+        else                  { return true; }
+    }
+    return false;
+}
+
+template<typename Comparable>
+int PersistentAVLTree<Comparable>::_height( const NodePtr& t ) {
+    return t == nullptr ? -1 : t->height;
+}
+
+template<typename Comparable>
+void PersistentAVLTree<Comparable>::_print( std::ostream& out, const AVLNode* t ) {
+    if (t != nullptr) {
+        _print(out, t->left.get());
+        out << t->item << " ";
+        _print(out, t->right.get());
+    }
+}
+
+#endif
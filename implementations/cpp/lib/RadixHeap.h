@@ -0,0 +1,168 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <type_traits>
+#include <cstdlib>
+
+/*
+Radix heap for monotone unsigned integer keys: no key may be inserted that
+is smaller than the last minimum returned by findMin or deleteMin, as in
+Dijkstra's algorithm or a timer queue. Key x lives in bucket k, where k is
+the position of the highest bit in which x differs from that last minimum
+(bucket 0 holds keys equal to it). When bucket 0 runs empty, the smallest
+key of the first non-empty bucket becomes the new last key and that bucket
+is redistributed into strictly lower buckets. Every key moves down at most
+once per bit, so deleteMin is O(log C) amortized, where C is the largest
+key, with no comparisons between keys on insert.
+*/
+template<typename Key = unsigned int>
+class RadixHeap {
+    static_assert(std::is_integral<Key>::value && std::is_unsigned<Key>::value,
+                  "RadixHeap needs an unsigned integer key type");
+
+    public:
+        RadixHeap();
+
+        // Find the minimum key in the heap.
+        const Key& findMin() const;
+
+        // Insert key x, allowing duplicates. x must not be smaller than the
+        // last minimum returned by findMin or deleteMin.
+        void insert( const Key& x );
+
+        // Remove the minimum key.
+        void deleteMin();
+
+        // Remove the minimum key and place it in minItem.
+        void deleteMin( Key& minItem );
+
+        // Check if heap is empty.
+        bool isEmpty() const;
+
+        // Return the number of keys in the heap.
+        int size() const;
+
+        // Empty the heap. The monotone lower bound is reset to zero.
+        void makeEmpty();
+
+    private:
+        static const int NUM_BUCKETS = std::numeric_limits<Key>::digits + 1;
+
+        int _currentSize;
+        // Refilling bucket 0 only reorganizes the heap, so it is allowed
+        // from findMin.
+        mutable Key _last;
+        mutable std::vector<Key> _buckets[NUM_BUCKETS];
+
+        static int _bucketIndex( Key x, Key last );
+
+        // Make sure bucket 0 holds the minimum. The heap must not be empty.
+        void _refill() const;
+
+        void _checkNotEmpty() const;
+};
+
+template<typename Key>
+RadixHeap<Key>::RadixHeap() : _currentSize{ 0 }, _last{ 0 } {}
+
+template<typename Key>
+const Key& RadixHeap<Key>::findMin() const {
+    _checkNotEmpty();
+    _refill();
+    return _buckets[0].back();
+}
+
+template<typename Key>
+void RadixHeap<Key>::insert( const Key& x ) {
+    if (x < _last) {
+        std::cout << "Error: key " << x << " is smaller than the last minimum\n";
+        std::abort();
+    }
+
+    _buckets[_bucketIndex(x, _last)].push_back(x);
+    _currentSize += 1;
+}
+
+template<typename Key>
+void RadixHeap<Key>::deleteMin() {
+    _checkNotEmpty();
+    _refill();
+    _buckets[0].pop_back();
+    _currentSize -= 1;
+}
+
+template<typename Key>
+void RadixHeap<Key>::deleteMin( Key& minItem ) {
+    _checkNotEmpty();
+    _refill();
+    minItem = _buckets[0].back();
+    _buckets[0].pop_back();
+    _currentSize -= 1;
+}
+
+template<typename Key>
+bool RadixHeap<Key>::isEmpty() const {
+    return _currentSize == 0;
+}
+
+template<typename Key>
+int RadixHeap<Key>::size() const {
+    return _currentSize;
+}
+
+template<typename Key>
+void RadixHeap<Key>::makeEmpty() {
+    for (auto& bucket : _buckets) {
+        bucket.clear();
+    }
+    _currentSize = 0;
+    _last = 0;
+}
+
+template<typename Key>
+int RadixHeap<Key>::_bucketIndex( Key x, Key last ) {
+    Key diff = x ^ last;
+#if defined(__GNUC__) || defined(__clang__)
+    return diff == 0 ? 0 : 64 - __builtin_clzll(static_cast<unsigned long long>(diff));
+#else
+    int index = 0;
+    for (; diff != 0; diff >>= 1) {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+template<typename Key>
+void RadixHeap<Key>::_refill() const {
+    if (!_buckets[0].empty()) return;
+
+    int i = 1;
+    while (_buckets[i].empty()) ++i;
+
+    Key newLast = _buckets[i][0];
+    for (Key x : _buckets[i]) {
+        if (x < newLast) newLast = x;
+    }
+
+    // every key in bucket i agrees with newLast above bit i - 1, so each
+    // lands in a bucket below i
+    _last = newLast;
+    for (Key x : _buckets[i]) {
+        _buckets[_bucketIndex(x, _last)].push_back(x);
+    }
+    _buckets[i].clear();
+}
+
+template<typename Key>
+void RadixHeap<Key>::_checkNotEmpty() const {
+    if (isEmpty()) {
+        std::cout << "Error: Underflow\n";
+        std::abort();
+    }
+}
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <vector>
+#include <string>
+#include <iterator>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+
+#include "Sorting.h"
+
+/*
+Radix sorts: distribution sorts that look at the keys one byte at a time
+instead of comparing them, so they are not bound by the Omega(N log N)
+lower bound for comparison sorts.
+*/
+
+namespace radix_sort_detail {
+    // The bits of x as an unsigned key that orders like x: the sign bit of
+    // a signed type is flipped so negative numbers come first.
+    template<typename Integer>
+    typename std::make_unsigned<Integer>::type toUnsigned( Integer x ) {
+        typedef typename std::make_unsigned<Integer>::type U;
+        U u = static_cast<U>(x);
+        if (std::is_signed<Integer>::value) {
+            u ^= U{ 1 } << (sizeof(U) * 8 - 1);
+        }
+        return u;
+    }
+}
+
+/*
+@brief LSD radix sort of integers: one stable counting-sort pass per byte,
+       least significant byte first, alternating between the range and
+       buffer. The histograms of all bytes are gathered in a single pass
+       over the input, and a byte whose value is the same in every key is
+       skipped. O(w N) for w-byte keys. buffer is resized as needed and can
+       be reused between calls.
+@return void
+*/
+template<typename Iterator>
+void radixSort( Iterator begin, Iterator end,
+                std::vector<typename std::iterator_traits<Iterator>::value_type>& buffer ) {
+    typedef typename std::iterator_traits<Iterator>::value_type Integer;
+    static_assert(std::is_integral<Integer>::value, "radixSort needs an integer key type");
+
+    const int BYTES = sizeof(Integer);
+    std::ptrdiff_t n = end - begin;
+    if (n < 64) {
+        insertionSort(begin, end);
+        return;
+    }
+
+    std::vector<std::ptrdiff_t> counts(BYTES * 256, 0);
+    for (Iterator p = begin; p != end; ++p) {
+        auto u = radix_sort_detail::toUnsigned(*p);
+        for (int d = 0; d < BYTES; ++d) {
+            counts[d * 256 + ((u >> (8 * d)) & 0xFF)] += 1;
+        }
+    }
+
+    if (static_cast<std::ptrdiff_t>(buffer.size()) < n) {
+        buffer.resize(n);
+    }
+
+    bool inBuffer = false;
+    for (int d = 0; d < BYTES; ++d) {
+        std::ptrdiff_t* count = &counts[d * 256];
+        auto first = radix_sort_detail::toUnsigned(*(inBuffer ? buffer.begin() : begin));
+        if (count[(first >> (8 * d)) & 0xFF] == n) continue;
+
+        std::ptrdiff_t sum = 0;
+        for (int b = 0; b < 256; ++b) {
+            std::ptrdiff_t c = count[b];
+            count[b] = sum;
+            sum += c;
+        }
+
+        if (inBuffer) {
+            for (auto p = buffer.begin(); p != buffer.begin() + n; ++p) {
+                begin[count[(radix_sort_detail::toUnsigned(*p) >> (8 * d)) & 0xFF]++] = *p;
+            }
+        }
+        else {
+            for (Iterator p = begin; p != end; ++p) {
+                buffer[count[(radix_sort_detail::toUnsigned(*p) >> (8 * d)) & 0xFF]++] = *p;
+            }
+        }
+        inBuffer = !inBuffer;
+    }
+
+    if (inBuffer) {
+        std::copy(buffer.begin(), buffer.begin() + n, begin);
+    }
+}
+
+// LSD radix sort with a buffer of its own.
+template<typename Iterator>
+void radixSort( Iterator begin, Iterator end ) {
+    std::vector<typename std::iterator_traits<Iterator>::value_type> buffer;
+    radixSort(begin, end, buffer);
+}
+
+namespace radix_sort_detail {
+    // Byte depth of s, with 0 for the end of the string so that a string
+    // comes before its extensions; other bytes map to 1..256.
+    inline int byteAt( const std::string& s, std::size_t depth ) {
+        return depth < s.size() ? static_cast<unsigned char>(s[depth]) + 1 : 0;
+    }
+
+    template<typename Iterator>
+    void americanFlagSort( Iterator begin, Iterator end, std::size_t depth ) {
+        const std::ptrdiff_t CUTOFF = 32;
+
+        while (end - begin > 1) {
+            if (end - begin <= CUTOFF) {
+                // all strings agree on their first depth bytes
+                insertionSort(begin, end, [depth]( const std::string& a, const std::string& b ) {
+                    return a.compare(std::min(depth, a.size()), std::string::npos,
+                                     b, std::min(depth, b.size()), std::string::npos) < 0;
+                });
+                return;
+            }
+
+            std::ptrdiff_t count[257] = {};
+            for (Iterator p = begin; p != end; ++p) {
+                count[byteAt(*p, depth)] += 1;
+            }
+
+            // if every string has the same byte here, skip the whole common
+            // prefix at once instead of one counting pass per byte
+            int first = byteAt(*begin, depth);
+            if (count[first] == end - begin) {
+                if (first == 0) return; // all strings are equal
+                std::size_t common = begin->size();
+                for (Iterator p = begin + 1; p != end && common > depth + 1; ++p) {
+                    std::size_t k = depth + 1;
+                    std::size_t limit = std::min(common, p->size());
+                    while (k < limit && (*p)[k] == (*begin)[k]) ++k;
+                    common = k;
+                }
+                depth = common;
+                continue;
+            }
+
+            // next[b] is where the next string of bucket b goes; limit[b]
+            // is the end of bucket b
+            std::ptrdiff_t next[257], limit[257];
+            std::ptrdiff_t sum = 0;
+            for (int b = 0; b < 257; ++b) {
+                next[b] = sum;
+                sum += count[b];
+                limit[b] = sum;
+            }
+
+            // permute in place: swap each misplaced string straight into
+            // the bucket it belongs to
+            for (int b = 0; b < 257; ++b) {
+                while (next[b] < limit[b]) {
+                    int c = byteAt(begin[next[b]], depth);
+                    while (c != b) {
+                        std::swap(begin[next[b]], begin[next[c]++]);
+                        c = byteAt(begin[next[b]], depth);
+                    }
+                    next[b] += 1;
+                }
+            }
+
+            // bucket 0 holds strings that ended and is sorted; recurse into
+            // the others, continuing with the largest in this loop
+            int largest = 1;
+            for (int b = 2; b < 257; ++b) {
+                if (count[b] > count[largest]) largest = b;
+            }
+            for (int b = 1; b < 257; ++b) {
+                if (b != largest && count[b] > 1) {
+                    americanFlagSort(begin + (limit[b] - count[b]), begin + limit[b], depth + 1);
+                }
+            }
+            end = begin + limit[largest];
+            begin = begin + (limit[largest] - count[largest]);
+            depth += 1;
+        }
+    }
+}
+
+/*
+@brief MSD radix sort of strings by American flag sort: count the strings
+       per byte at the current depth, permute them in place into their
+       buckets, and sort every bucket on the next byte. Only the bytes
+       needed to tell the strings apart are examined, and no buffer is
+       used. Runs of at most 32 strings are insertion-sorted. Not stable.
+@return void
+*/
+template<typename Iterator>
+void americanFlagSort( Iterator begin, Iterator end ) {
+    static_assert(std::is_same<typename std::iterator_traits<Iterator>::value_type, std::string>::value,
+                  "americanFlagSort needs std::string keys");
+    radix_sort_detail::americanFlagSort(begin, end, 0);
+}
+
+#endif
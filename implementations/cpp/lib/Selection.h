@@ -0,0 +1,213 @@
+#ifndef SELECTION_H
+#define SELECTION_H
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <functional>
+#include <iterator>
+#include <algorithm>
+
+#include "BinaryHeap.h"
+
+/*
+Bounded selection of the k largest items of a stream (lecture 13, 4th
+algorithm). A BinaryHeap of at most k items holds the current set S; its
+root is S_k, the smallest of the k largest items seen so far. Most items
+of a long stream are rejected by a single comparison against S_k; the rest
+replace it in O(log k). Total time is O(n log k) with O(k) memory.
+*/
+template<typename Comparable>
+class TopK {
+    public:
+        explicit TopK( int k );
+
+        // Offer item x from the stream.
+        void insert( const Comparable& x );
+
+        // Fold the items kept by rhs into this set.
+        void merge( const TopK& rhs );
+
+        // Return the k-th largest item seen so far (S_k).
+        const Comparable& kthLargest() const;
+
+        // Return the kept items, largest first.
+        std::vector<Comparable> items() const;
+
+        // Return the number of items kept (at most k).
+        int size() const;
+
+        // Return k.
+        int capacity() const;
+
+    private:
+        int _k;
+        int _size;
+        BinaryHeap<Comparable> _heap;
+};
+
+template<typename Comparable>
+TopK<Comparable>::TopK( int k ) : _k{ k }, _size{ 0 }, _heap( k ) {}
+
+template<typename Comparable>
+void TopK<Comparable>::insert( const Comparable& x ) {
+    if (_size < _k) {
+        _heap.insert(x);
+        _size += 1;
+    }
+    else if (_k > 0 && _heap.findMin() < x) { // early reject otherwise
+        _heap.replaceMin(x);
+    }
+}
+
+template<typename Comparable>
+void TopK<Comparable>::merge( const TopK& rhs ) {
+    for (const Comparable& x : rhs.items()) {
+        if (_size == _k && !(_heap.findMin() < x)) break; // rest is no larger
+        insert(x);
+    }
+}
+
+template<typename Comparable>
+const Comparable& TopK<Comparable>::kthLargest() const {
+    return _heap.findMin();
+}
+
+template<typename Comparable>
+std::vector<Comparable> TopK<Comparable>::items() const {
+    BinaryHeap<Comparable> copy = _heap;
+    std::vector<Comparable> result(_size);
+    for (int i = _size - 1; i >= 0; --i) {
+        copy.deleteMin(result[i]);
+    }
+    return result;
+}
+
+template<typename Comparable>
+int TopK<Comparable>::size() const {
+    return _size;
+}
+
+template<typename Comparable>
+int TopK<Comparable>::capacity() const {
+    return _k;
+}
+
+/*
+@brief Combine per-thread TopK sets into one with a parallel pairwise
+       reduction: log2(P) rounds, each merging disjoint pairs on their own
+       threads. The result is left in parts[0].
+@return TopK&
+*/
+template<typename Comparable>
+TopK<Comparable>& mergeTopK( std::vector<TopK<Comparable>>& parts ) {
+    for (size_t stride = 1; stride < parts.size(); stride *= 2) {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i + stride < parts.size(); i += 2 * stride) {
+            threads.emplace_back([&parts, i, stride]() {
+                parts[i].merge(parts[i + stride]);
+            });
+        }
+        for (auto& t : threads) t.join();
+    }
+    return parts[0];
+}
+
+/*
+Helpers for introSelect.
+*/
+namespace selection_detail {
+    template<typename RandomIt, typename Compare>
+    void insertionSort( RandomIt first, RandomIt last, Compare comp ) {
+        for (RandomIt i = first; i != last; ++i) {
+            auto tmp = std::move(*i);
+            RandomIt j = i;
+            for (; j != first && comp(tmp, *(j - 1)); --j) {
+                *j = std::move(*(j - 1));
+            }
+            *j = std::move(tmp);
+        }
+    }
+
+    template<typename RandomIt, typename Compare>
+    RandomIt medianOfThree( RandomIt a, RandomIt b, RandomIt c, Compare comp ) {
+        if (comp(*a, *b)) {
+            if (comp(*b, *c)) return b;
+            return comp(*a, *c) ? c : a;
+        }
+        if (comp(*a, *c)) return a;
+        return comp(*b, *c) ? c : b;
+    }
+
+    template<typename RandomIt, typename Compare>
+    void select( RandomIt first, RandomIt kth, RandomIt last, Compare comp, int depthLimit );
+
+    /*
+    @brief Median of the medians of groups of five, moved to the front of
+           the range. Guarantees a pivot between the 30th and 70th
+           percentiles.
+    @return RandomIt
+    */
+    template<typename RandomIt, typename Compare>
+    RandomIt medianOfMedians( RandomIt first, RandomIt last, Compare comp ) {
+        RandomIt medians = first;
+        for (RandomIt group = first; group < last; group += 5) {
+            RandomIt groupEnd = (last - group < 5) ? last : group + 5;
+            insertionSort(group, groupEnd, comp);
+            std::iter_swap(medians++, group + (groupEnd - group) / 2);
+        }
+
+        RandomIt mid = first + (medians - first) / 2;
+        select(first, mid, medians, comp, 0);
+        return mid;
+    }
+
+    /*
+    @brief Quickselect with median-of-three pivots; after depthLimit
+           unlucky rounds, pivots come from medianOfMedians. Each round
+           splits the range three ways (less, equal, greater than the
+           pivot), so runs of equal items cost nothing extra.
+    @return void
+    */
+    template<typename RandomIt, typename Compare>
+    void select( RandomIt first, RandomIt kth, RandomIt last, Compare comp, int depthLimit ) {
+        while (last - first > 16) {
+            RandomIt pivotIt = depthLimit-- > 0
+                ? medianOfThree(first, first + (last - first) / 2, last - 1, comp)
+                : medianOfMedians(first, last, comp);
+            auto pivot = *pivotIt;
+
+            // [first, lt) < pivot, [lt, i) == pivot, [gt, last) > pivot
+            RandomIt lt = first, i = first, gt = last;
+            while (i < gt) {
+                if (comp(*i, pivot))      { std::iter_swap(lt++, i++); }
+                else if (comp(pivot, *i)) { std::iter_swap(i, --gt);   }
+                else                      { ++i; }
+            }
+
+            if      (kth < lt)  { last = lt;  }
+            else if (kth >= gt) { first = gt; }
+            else                { return; }
+        }
+        insertionSort(first, last, comp);
+    }
+}
+
+/*
+@brief Rearrange [first, last) in place so that *kth is the item that would
+       be there if the range were sorted, every item before it is not
+       greater and every item after it is not less (like std::nth_element).
+       Introselect: expected O(n) quickselect, falling back to
+       median-of-medians pivots to keep the worst case O(n).
+@return void
+*/
+template<typename RandomIt, typename Compare = std::less<>>
+void introSelect( RandomIt first, RandomIt kth, RandomIt last, Compare comp = Compare{} ) {
+    if (first == last || kth == last) return;
+
+    int depthLimit = 0;
+    for (auto n = last - first; n > 1; n /= 2) depthLimit += 2;
+    selection_detail::select(first, kth, last, comp, depthLimit);
+}
+
+#endif
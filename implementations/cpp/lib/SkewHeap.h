@@ -0,0 +1,185 @@
+#ifndef SKEW_HEAP_H
+#define SKEW_HEAP_H
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include "NodePool.h"
+
+/*
+Skew heap (lecture 13). A self-adjusting leftist heap: merge swaps the
+children of every node on the merge path unconditionally and keeps no null
+path lengths. Right paths can grow long, but any M consecutive operations
+take O(M log n), so merge is O(log n) amortized. Merging is done top-down
+without recursion because a single merge path can be O(n) long.
+*/
+template<typename Comparable>
+class SkewHeap {
+    public:
+        SkewHeap();
+        SkewHeap( const SkewHeap& rhs ) = delete;            // heaps are merged, not copied
+        SkewHeap( SkewHeap&& rhs );                          // move constructor
+        SkewHeap& operator=( const SkewHeap& rhs ) = delete;
+        SkewHeap& operator=( SkewHeap&& rhs );               // move assignment
+        ~SkewHeap();
+
+        // Find the minimum item in the heap.
+        const Comparable& findMin() const;
+
+        // Insert item x, allowing duplicates.
+        void insert( const Comparable& x );
+        void insert( Comparable&& x );
+
+        // Remove the minimum item.
+        void deleteMin();
+
+        // Remove the minimum item and place it in minItem.
+        void deleteMin( Comparable& minItem );
+
+        // Merge rhs into this heap in O(log n) amortized; rhs becomes empty.
+        void merge( SkewHeap& rhs );
+
+        // Check if heap is empty.
+        bool isEmpty() const;
+
+        // Empty the heap.
+        void makeEmpty();
+
+    private:
+        struct SkewNode {
+            Comparable item;
+            SkewNode*  left;
+            SkewNode*  right;
+
+            SkewNode( const Comparable& item, SkewNode* left = nullptr, SkewNode* right = nullptr )
+                : item{ item }, left{ left }, right{ right } {}
+            SkewNode( Comparable&& item, SkewNode* left = nullptr, SkewNode* right = nullptr )
+                : item{ std::move(item) }, left{ left }, right{ right } {}
+        };
+
+        SkewNode* _root;
+
+        NodePool<SkewNode> _pool;   // takes over the pool of rhs on merge
+
+        // Merge two roots; return the new root.
+        SkewNode* _merge( SkewNode* h1, SkewNode* h2 );
+
+        void _checkNotEmpty() const;
+};
+
+template<typename Comparable>
+SkewHeap<Comparable>::SkewHeap() : _root{ nullptr } {}
+
+template<typename Comparable>
+SkewHeap<Comparable>::SkewHeap( SkewHeap&& rhs ) : _root{ rhs._root }, _pool{ std::move(rhs._pool) } {
+    rhs._root = nullptr;
+}
+
+template<typename Comparable>
+SkewHeap<Comparable>& SkewHeap<Comparable>::operator=( SkewHeap&& rhs ) {
+    std::swap(_root, rhs._root);
+    std::swap(_pool, rhs._pool);
+    return *this;
+}
+
+template<typename Comparable>
+SkewHeap<Comparable>::~SkewHeap() {
+    makeEmpty();
+}
+
+template<typename Comparable>
+const Comparable& SkewHeap<Comparable>::findMin() const {
+    _checkNotEmpty();
+    return _root->item;
+}
+
+template<typename Comparable>
+void SkewHeap<Comparable>::insert( const Comparable& x ) {
+    _root = _merge(_pool.allocate(x), _root);
+}
+
+template<typename Comparable>
+void SkewHeap<Comparable>::insert( Comparable&& x ) {
+    _root = _merge(_pool.allocate(std::move(x)), _root);
+}
+
+template<typename Comparable>
+void SkewHeap<Comparable>::deleteMin() {
+    _checkNotEmpty();
+    SkewNode* oldRoot = _root;
+    _root = _merge(_root->left, _root->right);
+    _pool.release(oldRoot);
+}
+
+template<typename Comparable>
+void SkewHeap<Comparable>::deleteMin( Comparable& minItem ) {
+    _checkNotEmpty();
+    minItem = std::move(_root->item);
+    deleteMin();
+}
+
+template<typename Comparable>
+void SkewHeap<Comparable>::merge( SkewHeap& rhs ) {
+    if (this == &rhs) return; // avoid aliasing problems
+
+    _root = _merge(_root, rhs._root);
+    rhs._root = nullptr;
+    _pool.splice(rhs._pool);
+}
+
+template<typename Comparable>
+bool SkewHeap<Comparable>::isEmpty() const {
+    return _root == nullptr;
+}
+
+template<typename Comparable>
+void SkewHeap<Comparable>::makeEmpty() {
+    std::vector<SkewNode*> stack;
+    if (_root != nullptr) stack.push_back(_root);
+
+    while (!stack.empty()) {
+        SkewNode* t = stack.back();
+        stack.pop_back();
+        if (t->left != nullptr)  stack.push_back(t->left);
+        if (t->right != nullptr) stack.push_back(t->right);
+        _pool.release(t);
+    }
+    _root = nullptr;
+}
+
+/*
+@brief Walk down the right paths of both heaps, always taking the smaller
+       root. Each node taken keeps its left subtree as its new right one,
+       and the rest of the merge is hung on its left.
+@return SkewNode*
+*/
+template<typename Comparable>
+typename SkewHeap<Comparable>::SkewNode* SkewHeap<Comparable>::_merge( SkewNode* h1, SkewNode* h2 ) {
+    SkewNode* root = nullptr;
+    SkewNode** link = &root;
+
+    while (h1 != nullptr && h2 != nullptr) {
+        if (h2->item < h1->item) std::swap(h1, h2);
+
+        *link = h1;
+        SkewNode* rest = h1->right;
+        h1->right = h1->left;
+        link = &h1->left;
+        h1 = rest;
+    }
+
+    *link = (h1 != nullptr) ? h1 : h2;
+    return root;
+}
+
+template<typename Comparable>
+void SkewHeap<Comparable>::_checkNotEmpty() const {
+    if (isEmpty()) {
+        std::cout << "Error: Underflow\n";
+        std::abort();
+    }
+}
+
+#endif
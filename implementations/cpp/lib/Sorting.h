@@ -0,0 +1,346 @@
+#ifndef SORTING_H
+#define SORTING_H
+
+#include <vector>
+#include <iterator>
+#include <functional>
+#include <utility>
+#include <algorithm>
+
+/*
+Comparison sorts of lectures 14 and 15 over random-access ranges, in the STL
+style: each takes a pair of iterators [begin, end) and an optional function
+object lessThan.
+*/
+
+/*
+@brief Insertion sort. O(N + I), where I is the number of inversions, so it
+       is the method of choice for short or nearly sorted ranges.
+@return void
+*/
+template<typename Iterator, typename Comparator = std::less<>>
+void insertionSort( Iterator begin, Iterator end, Comparator lessThan = Comparator{} ) {
+    if (begin == end) return;
+
+    for (Iterator p = begin + 1; p != end; ++p) {
+        auto tmp = std::move(*p);
+        Iterator j = p;
+        for (; j != begin && lessThan(tmp, *(j - 1)); --j) {
+            *j = std::move(*(j - 1));
+        }
+        *j = std::move(tmp);
+    }
+}
+
+/*
+Increment sequences for shellsort, largest first and all ending in 1.
+*/
+
+// Shell's increments N/2, N/4, ..., 1. Theta(N^2) worst case.
+inline std::vector<std::ptrdiff_t> shellGaps( std::ptrdiff_t n ) {
+    std::vector<std::ptrdiff_t> gaps;
+    for (std::ptrdiff_t gap = n / 2; gap > 0; gap /= 2) {
+        gaps.push_back(gap);
+    }
+    return gaps;
+}
+
+// Hibbard's increments 2^k - 1. Theta(N^(3/2)) worst case.
+inline std::vector<std::ptrdiff_t> hibbardGaps( std::ptrdiff_t n ) {
+    std::vector<std::ptrdiff_t> gaps;
+    for (std::ptrdiff_t gap = 1; gap < n; gap = 2 * gap + 1) {
+        gaps.push_back(gap);
+    }
+    std::reverse(gaps.begin(), gaps.end());
+    return gaps;
+}
+
+// Sedgewick's increments 9 * 4^i - 9 * 2^i + 1 and 4^i - 3 * 2^i + 1
+// merged. O(N^(4/3)) worst case.
+inline std::vector<std::ptrdiff_t> sedgewickGaps( std::ptrdiff_t n ) {
+    std::vector<std::ptrdiff_t> gaps;
+    for (std::ptrdiff_t i = 0; ; ++i) {
+        std::ptrdiff_t even = 9 * ((std::ptrdiff_t{ 1 } << (2 * i)) - (std::ptrdiff_t{ 1 } << i)) + 1;
+        std::ptrdiff_t odd = (std::ptrdiff_t{ 1 } << (2 * i + 4)) - 3 * (std::ptrdiff_t{ 1 } << (i + 2)) + 1;
+        if (even >= n) break;
+        gaps.push_back(even);
+        if (odd >= n) break;
+        gaps.push_back(odd);
+    }
+    std::reverse(gaps.begin(), gaps.end());
+    return gaps;
+}
+
+// Ciura's empirically best increments, extended by a factor of 2.25.
+inline std::vector<std::ptrdiff_t> ciuraGaps( std::ptrdiff_t n ) {
+    std::vector<std::ptrdiff_t> gaps{ 1, 4, 10, 23, 57, 132, 301, 701, 1750 };
+    while (gaps.back() < n) {
+        gaps.push_back(gaps.back() * 9 / 4);
+    }
+    while (gaps.size() > 1 && gaps.back() >= n) {
+        gaps.pop_back();
+    }
+    std::reverse(gaps.begin(), gaps.end());
+    return gaps;
+}
+
+/*
+@brief Shellsort: an insertion sort on the elements gap apart, for each gap
+       of the increment sequence in turn.
+@return void
+*/
+template<typename Iterator, typename Comparator = std::less<>>
+void shellsort( Iterator begin, Iterator end, const std::vector<std::ptrdiff_t>& gaps,
+                Comparator lessThan = Comparator{} ) {
+    std::ptrdiff_t n = end - begin;
+    for (std::ptrdiff_t gap : gaps) {
+        for (std::ptrdiff_t i = gap; i < n; ++i) {
+            auto tmp = std::move(begin[i]);
+            std::ptrdiff_t j = i;
+            for (; j >= gap && lessThan(tmp, begin[j - gap]); j -= gap) {
+                begin[j] = std::move(begin[j - gap]);
+            }
+            begin[j] = std::move(tmp);
+        }
+    }
+}
+
+// Shellsort with Ciura's increments.
+template<typename Iterator, typename Comparator = std::less<>>
+void shellsort( Iterator begin, Iterator end, Comparator lessThan = Comparator{} ) {
+    shellsort(begin, end, ciuraGaps(end - begin), lessThan);
+}
+
+namespace sorting_detail {
+    /*
+    @brief Percolate down in a max-heap stored in [begin, begin + n) from
+           position 0 (children of i at 2i + 1 and 2i + 2), with the hole
+           technique of BinaryHeap::_percolateDown.
+    @return void
+    */
+    template<typename Iterator, typename Comparator>
+    void percolateDown( Iterator begin, std::ptrdiff_t hole, std::ptrdiff_t n, Comparator lessThan ) {
+        auto tmp = std::move(begin[hole]);
+        std::ptrdiff_t child;
+
+        for (; 2 * hole + 1 < n; hole = child) {
+            child = 2 * hole + 1;
+            if (child != n - 1 && lessThan(begin[child], begin[child + 1])) {
+                child++;
+            }
+
+            if (lessThan(tmp, begin[child])) {
+                begin[hole] = std::move(begin[child]);
+            }
+            else {
+                break;
+            }
+        }
+
+        begin[hole] = std::move(tmp);
+    }
+
+    /*
+    @brief Fill the hole at the root of the max-heap [begin, begin + n) with
+           x. Items taken from the back of the heap belong near the bottom,
+           so the hole is first walked down to a leaf along the larger
+           children (one comparison per level) and x is then percolated up
+           from there. About half the comparisons of percolateDown.
+    @return void
+    */
+    template<typename Iterator, typename T, typename Comparator>
+    void bottomUpPercolate( Iterator begin, std::ptrdiff_t n, T&& x, Comparator lessThan ) {
+        std::ptrdiff_t hole = 0;
+        std::ptrdiff_t child = 1;
+        for (; child < n; child = 2 * hole + 1) {
+            if (child + 1 < n && lessThan(begin[child], begin[child + 1])) {
+                child++;
+            }
+            begin[hole] = std::move(begin[child]);
+            hole = child;
+        }
+
+        for (std::ptrdiff_t parent = (hole - 1) / 2; hole > 0 && lessThan(begin[parent], x);
+             parent = (hole - 1) / 2) {
+            begin[hole] = std::move(begin[parent]);
+            hole = parent;
+        }
+        begin[hole] = std::move(x);
+    }
+
+    /*
+    @brief Merge the sorted runs [src, src + mid) and [src + mid, src + n)
+           into dst. Ties go to the left run, so the merge is stable.
+    @return void
+    */
+    template<typename InIt, typename OutIt, typename Comparator>
+    void mergeRuns( InIt src, std::ptrdiff_t mid, std::ptrdiff_t n, OutIt dst, Comparator lessThan ) {
+        std::ptrdiff_t left = 0, right = mid;
+        while (left < mid && right < n) {
+            if (lessThan(src[right], src[left])) {
+                *dst++ = std::move(src[right++]);
+            }
+            else {
+                *dst++ = std::move(src[left++]);
+            }
+        }
+        dst = std::move(src + left, src + mid, dst);
+        std::move(src + right, src + n, dst);
+    }
+
+    /*
+    @brief One bottom-up pass: merge adjacent runs of length width from src
+           into dst.
+    @return void
+    */
+    template<typename InIt, typename OutIt, typename Comparator>
+    void mergePass( InIt src, OutIt dst, std::ptrdiff_t n, std::ptrdiff_t width, Comparator lessThan ) {
+        for (std::ptrdiff_t lo = 0; lo < n; lo += 2 * width) {
+            std::ptrdiff_t mid = std::min(width, n - lo);
+            std::ptrdiff_t len = std::min(2 * width, n - lo);
+            mergeRuns(src + lo, mid, len, dst + lo, lessThan);
+        }
+    }
+
+    template<typename Iterator, typename Comparator>
+    Iterator medianOfThree( Iterator a, Iterator b, Iterator c, Comparator lessThan ) {
+        if (lessThan(*a, *b)) {
+            if (lessThan(*b, *c)) return b;
+            return lessThan(*a, *c) ? c : a;
+        }
+        if (lessThan(*a, *c)) return a;
+        return lessThan(*b, *c) ? c : b;
+    }
+
+    template<typename Iterator, typename Comparator>
+    void introSort( Iterator begin, Iterator end, int depthLimit, Comparator lessThan );
+}
+
+/*
+@brief In-place heapsort: build a max-heap in linear time, then swap the
+       maximum to the back N - 1 times. O(N log N) worst case, no extra
+       memory, not stable.
+@return void
+*/
+template<typename Iterator, typename Comparator = std::less<>>
+void heapsort( Iterator begin, Iterator end, Comparator lessThan = Comparator{} ) {
+    std::ptrdiff_t n = end - begin;
+    for (std::ptrdiff_t i = n / 2 - 1; i >= 0; --i) {
+        sorting_detail::percolateDown(begin, i, n, lessThan);
+    }
+
+    for (std::ptrdiff_t j = n - 1; j > 0; --j) {
+        auto last = std::move(begin[j]);
+        begin[j] = std::move(begin[0]);
+        sorting_detail::bottomUpPercolate(begin, j, std::move(last), lessThan);
+    }
+}
+
+/*
+@brief Bottom-up mergesort: insertion-sort runs of 16 items, then merge runs
+       of doubling width, alternating between the range and buffer so each
+       pass moves every item once. O(N log N) worst case and stable.
+       buffer is resized as needed and can be reused between calls to
+       avoid an allocation per sort.
+@return void
+*/
+template<typename Iterator, typename Comparator = std::less<>>
+void mergeSort( Iterator begin, Iterator end,
+                std::vector<typename std::iterator_traits<Iterator>::value_type>& buffer,
+                Comparator lessThan = Comparator{} ) {
+    const std::ptrdiff_t RUN = 16;
+    std::ptrdiff_t n = end - begin;
+    if (n <= RUN) {
+        insertionSort(begin, end, lessThan);
+        return;
+    }
+
+    if (static_cast<std::ptrdiff_t>(buffer.size()) < n) {
+        buffer.resize(n);
+    }
+    auto tmp = buffer.begin();
+
+    for (std::ptrdiff_t lo = 0; lo < n; lo += RUN) {
+        insertionSort(begin + lo, begin + std::min(lo + RUN, n), lessThan);
+    }
+
+    bool inBuffer = false;
+    for (std::ptrdiff_t width = RUN; width < n; width *= 2) {
+        if (inBuffer) {
+            sorting_detail::mergePass(tmp, begin, n, width, lessThan);
+        }
+        else {
+            sorting_detail::mergePass(begin, tmp, n, width, lessThan);
+        }
+        inBuffer = !inBuffer;
+    }
+
+    if (inBuffer) {
+        std::move(tmp, tmp + n, begin);
+    }
+}
+
+// Bottom-up mergesort with a buffer of its own.
+template<typename Iterator, typename Comparator = std::less<>>
+void mergeSort( Iterator begin, Iterator end, Comparator lessThan = Comparator{} ) {
+    std::vector<typename std::iterator_traits<Iterator>::value_type> buffer;
+    mergeSort(begin, end, buffer, lessThan);
+}
+
+/*
+@brief Introsort: quicksort with a median-of-three pivot that leaves
+       ranges of 16 or fewer items for one final insertion sort, and turns
+       to heapsort for a range once the recursion is 2 log N deep. Average
+       speed of quicksort with an O(N log N) worst case. Not stable.
+@return void
+*/
+template<typename Iterator, typename Comparator = std::less<>>
+void introSort( Iterator begin, Iterator end, Comparator lessThan = Comparator{} ) {
+    int depthLimit = 0;
+    for (std::ptrdiff_t n = end - begin; n > 1; n /= 2) depthLimit += 2;
+
+    sorting_detail::introSort(begin, end, depthLimit, lessThan);
+    insertionSort(begin, end, lessThan);
+}
+
+namespace sorting_detail {
+    const std::ptrdiff_t INSERTION_SORT_CUTOFF = 16;
+
+    template<typename Iterator, typename Comparator>
+    void introSort( Iterator begin, Iterator end, int depthLimit, Comparator lessThan ) {
+        while (end - begin > INSERTION_SORT_CUTOFF) {
+            if (depthLimit-- == 0) {
+                heapsort(begin, end, lessThan);
+                return;
+            }
+
+            // the median of three goes to the front, so both scans below
+            // stop at the range ends without bounds checks
+            Iterator mid = begin + (end - begin) / 2;
+            std::iter_swap(begin, medianOfThree(begin + 1, mid, end - 1, lessThan));
+
+            Iterator i = begin + 1, j = end;
+            while (true) {
+                while (lessThan(*i, *begin)) ++i;
+                --j;
+                while (lessThan(*begin, *j)) --j;
+                if (!(i < j)) break;
+                std::iter_swap(i, j);
+                ++i;
+            }
+            std::iter_swap(begin, j);
+
+            // recurse into the smaller part, loop on the larger
+            if (j - begin < end - (j + 1)) {
+                introSort(begin, j, depthLimit, lessThan);
+                begin = j + 1;
+            }
+            else {
+                introSort(j + 1, end, depthLimit, lessThan);
+                end = j;
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,297 @@
+#ifndef SORTING_NETWORK_H
+#define SORTING_NETWORK_H
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+#include "Sorting.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/*
+Sorting networks for blocks of 64 ints or floats. A sorting network is a
+fixed sequence of compare-exchange steps, so it has no data-dependent
+branches, and eight independent compare-exchanges map onto one min and one
+max instruction on 256-bit vectors. A block is held in eight vectors of
+eight items:
+  1. the 19-comparator network for 8 items sorts the eight columns,
+  2. a transpose turns the sorted columns into eight sorted rows,
+  3. bitonic merges combine the rows into runs of 16, 32 and 64.
+With AVX2 each step is a handful of instructions per vector; otherwise the
+same network runs on plain arrays. NaNs are not supported.
+*/
+
+namespace sorting_network_detail {
+    // Eight items and the operations the network needs, for any type with
+    // operator<.
+    template<typename T>
+    struct ScalarOps {
+        struct Vec { T x[8]; };
+
+        static Vec load( const T* p ) {
+            Vec v;
+            std::copy(p, p + 8, v.x);
+            return v;
+        }
+
+        static void store( T* p, const Vec& v ) {
+            std::copy(v.x, v.x + 8, p);
+        }
+
+        static Vec min( const Vec& a, const Vec& b ) {
+            Vec v;
+            for (int i = 0; i < 8; ++i) v.x[i] = b.x[i] < a.x[i] ? b.x[i] : a.x[i];
+            return v;
+        }
+
+        static Vec max( const Vec& a, const Vec& b ) {
+            Vec v;
+            for (int i = 0; i < 8; ++i) v.x[i] = b.x[i] < a.x[i] ? a.x[i] : b.x[i];
+            return v;
+        }
+
+        static Vec reverse( const Vec& a ) {
+            Vec v;
+            for (int i = 0; i < 8; ++i) v.x[i] = a.x[7 - i];
+            return v;
+        }
+
+        // Sort a bitonic sequence of 8: compare-exchange at distance 4, 2, 1.
+        static Vec clean( Vec v ) {
+            for (int d = 4; d > 0; d /= 2) {
+                for (int i = 0; i < 8; ++i) {
+                    if ((i & d) == 0 && v.x[i + d] < v.x[i]) std::swap(v.x[i], v.x[i + d]);
+                }
+            }
+            return v;
+        }
+
+        static void transpose( Vec* r ) {
+            for (int i = 0; i < 8; ++i) {
+                for (int j = i + 1; j < 8; ++j) std::swap(r[i].x[j], r[j].x[i]);
+            }
+        }
+    };
+
+#if defined(__AVX2__)
+    struct Avx2Transpose {
+        static void transpose( __m256i* r ) {
+            __m256i t[8], u[8];
+            for (int i = 0; i < 4; ++i) {
+                t[2 * i]     = _mm256_unpacklo_epi32(r[2 * i], r[2 * i + 1]);
+                t[2 * i + 1] = _mm256_unpackhi_epi32(r[2 * i], r[2 * i + 1]);
+            }
+            for (int i = 0; i < 2; ++i) {
+                u[4 * i]     = _mm256_unpacklo_epi64(t[4 * i], t[4 * i + 2]);
+                u[4 * i + 1] = _mm256_unpackhi_epi64(t[4 * i], t[4 * i + 2]);
+                u[4 * i + 2] = _mm256_unpacklo_epi64(t[4 * i + 1], t[4 * i + 3]);
+                u[4 * i + 3] = _mm256_unpackhi_epi64(t[4 * i + 1], t[4 * i + 3]);
+            }
+            for (int i = 0; i < 4; ++i) {
+                r[i]     = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+                r[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+            }
+        }
+    };
+
+    struct Avx2IntOps {
+        typedef __m256i Vec;
+
+        static Vec load( const int* p ) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store( int* p, Vec v ) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static Vec min( Vec a, Vec b ) { return _mm256_min_epi32(a, b); }
+        static Vec max( Vec a, Vec b ) { return _mm256_max_epi32(a, b); }
+
+        static Vec reverse( Vec v ) {
+            return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+        }
+
+        static Vec clean( Vec v ) {
+            Vec p = _mm256_permute2x128_si256(v, v, 0x01);
+            v = _mm256_blend_epi32(min(v, p), max(v, p), 0xF0);
+            p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+            v = _mm256_blend_epi32(min(v, p), max(v, p), 0xCC);
+            p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+            return _mm256_blend_epi32(min(v, p), max(v, p), 0xAA);
+        }
+
+        static void transpose( Vec* r ) { Avx2Transpose::transpose(r); }
+    };
+
+    struct Avx2FloatOps {
+        typedef __m256 Vec;
+
+        static Vec load( const float* p ) { return _mm256_loadu_ps(p); }
+        static void store( float* p, Vec v ) { _mm256_storeu_ps(p, v); }
+        // Blends on b < a, as ScalarOps, rather than _mm256_min_ps/max_ps,
+        // which return b for both when a == b and so lose one of -0 and +0.
+        static Vec min( Vec a, Vec b ) { return _mm256_blendv_ps(a, b, _mm256_cmp_ps(b, a, _CMP_LT_OQ)); }
+        static Vec max( Vec a, Vec b ) { return _mm256_blendv_ps(b, a, _mm256_cmp_ps(b, a, _CMP_LT_OQ)); }
+
+        static Vec reverse( Vec v ) {
+            return _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+        }
+
+        // The upper lane of each pair takes max(p, v), so that on a tie it
+        // keeps its own value while the lower lane keeps its own.
+        static Vec clean( Vec v ) {
+            Vec p = _mm256_permute2f128_ps(v, v, 0x01);
+            v = _mm256_blend_ps(min(v, p), max(p, v), 0xF0);
+            p = _mm256_permute_ps(v, _MM_SHUFFLE(1, 0, 3, 2));
+            v = _mm256_blend_ps(min(v, p), max(p, v), 0xCC);
+            p = _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1));
+            return _mm256_blend_ps(min(v, p), max(p, v), 0xAA);
+        }
+
+        static void transpose( Vec* r ) {
+            __m256i* ri = reinterpret_cast<__m256i*>(r);
+            Avx2Transpose::transpose(ri);
+        }
+    };
+
+    template<typename T> struct Ops { typedef ScalarOps<T> type; };
+    template<> struct Ops<int> { typedef Avx2IntOps type; };
+    template<> struct Ops<float> { typedef Avx2FloatOps type; };
+#else
+    template<typename T> struct Ops { typedef ScalarOps<T> type; };
+#endif
+
+    template<typename O, typename V>
+    inline void compareExchange( V& a, V& b ) {
+        V lo = O::min(a, b);
+        b = O::max(a, b);
+        a = lo;
+    }
+
+    /*
+    @brief Sort the bitonic sequence held in v[0, k), k a power of 2:
+           compare-exchange vectors half the span apart, then recurse into
+           both halves down to single vectors.
+    @return void
+    */
+    template<typename O, typename V>
+    void bitonicClean( V* v, int k ) {
+        if (k == 1) {
+            v[0] = O::clean(v[0]);
+            return;
+        }
+        for (int i = 0; i < k / 2; ++i) {
+            compareExchange<O>(v[i], v[i + k / 2]);
+        }
+        bitonicClean<O>(v, k / 2);
+        bitonicClean<O>(v + k / 2, k / 2);
+    }
+
+    /*
+    @brief Merge the sorted runs v[0, k/2) and v[k/2, k). Reversing the
+           second run makes the whole sequence bitonic.
+    @return void
+    */
+    template<typename O, typename V>
+    void bitonicMerge( V* v, int k ) {
+        int h = k / 2;
+        for (int i = 0; i < h / 2; ++i) {
+            std::swap(v[h + i], v[k - 1 - i]);
+        }
+        for (int i = h; i < k; ++i) {
+            v[i] = O::reverse(v[i]);
+        }
+        for (int i = 0; i < h; ++i) {
+            compareExchange<O>(v[i], v[i + h]);
+        }
+        bitonicClean<O>(v, h);
+        bitonicClean<O>(v + h, h);
+    }
+
+    template<typename T>
+    void sort64( T* a ) {
+        typedef typename Ops<T>::type O;
+        typename O::Vec r[8];
+        for (int i = 0; i < 8; ++i) r[i] = O::load(a + 8 * i);
+
+        // Optimal 19-comparator network on the columns
+        static const int NETWORK[19][2] = {
+            {0, 2}, {1, 3}, {4, 6}, {5, 7},
+            {0, 4}, {1, 5}, {2, 6}, {3, 7},
+            {0, 1}, {2, 3}, {4, 5}, {6, 7},
+            {2, 4}, {3, 5},
+            {1, 4}, {3, 6},
+            {1, 2}, {3, 4}, {5, 6}
+        };
+        for (const auto& c : NETWORK) {
+            compareExchange<O>(r[c[0]], r[c[1]]);
+        }
+
+        O::transpose(r);
+
+        for (int run = 2; run <= 8; run *= 2) {
+            for (int i = 0; i < 8; i += run) {
+                bitonicMerge<O>(r + i, run);
+            }
+        }
+
+        for (int i = 0; i < 8; ++i) O::store(a + 8 * i, r[i]);
+    }
+}
+
+/*
+@brief Sort the 64 items at a with a sorting network.
+@return void
+*/
+inline void sortingNetwork64( int* a ) {
+    sorting_network_detail::sort64(a);
+}
+
+inline void sortingNetwork64( float* a ) {
+    sorting_network_detail::sort64(a);
+}
+
+/*
+@brief Bottom-up mergesort whose initial runs are blocks of 64 sorted by
+       sortingNetwork64 instead of insertion sort. buffer is resized as
+       needed and can be reused between calls.
+@return void
+*/
+template<typename T>
+void networkSort( T* first, T* last, std::vector<T>& buffer ) {
+    const std::ptrdiff_t BLOCK = 64;
+    std::ptrdiff_t n = last - first;
+
+    std::ptrdiff_t lo = 0;
+    for (; lo + BLOCK <= n; lo += BLOCK) {
+        sorting_network_detail::sort64(first + lo);
+    }
+    insertionSort(first + lo, last);
+    if (n <= BLOCK) return;
+
+    if (static_cast<std::ptrdiff_t>(buffer.size()) < n) {
+        buffer.resize(n);
+    }
+    T* tmp = buffer.data();
+
+    bool inBuffer = false;
+    for (std::ptrdiff_t width = BLOCK; width < n; width *= 2) {
+        if (inBuffer) {
+            sorting_detail::mergePass(tmp, first, n, width, std::less<>{});
+        }
+        else {
+            sorting_detail::mergePass(first, tmp, n, width, std::less<>{});
+        }
+        inBuffer = !inBuffer;
+    }
+
+    if (inBuffer) {
+        std::copy(tmp, tmp + n, first);
+    }
+}
+
+template<typename T>
+void networkSort( T* first, T* last ) {
+    std::vector<T> buffer;
+    networkSort(first, last, buffer);
+}
+
+#endif
@@ -0,0 +1,363 @@
+#ifndef SPANNING_TREE_H
+#define SPANNING_TREE_H
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <random>
+#include <cstdint>
+#include <algorithm>
+
+#include "Graph.h"
+#include "DisjointSets.h"
+#include "IndexedBinaryHeap.h"
+#include "ParallelSort.h"
+#include "TaskScheduler.h"
+
+/*
+Minimum spanning trees of undirected graphs (lecture 19). An undirected
+graph is a Graph holding every edge in both directions; the functions
+below return a minimum spanning forest, one tree per connected component,
+as a list of edges:
+  kruskal:       all edges sorted by weight with parallelSampleSort, then
+                 accepted in order unless DisjointSets says they close a
+                 cycle. O(E log E).
+  prim:          grows one tree at a time from its cheapest outgoing edge,
+                 with the vertices outside in an IndexedBinaryHeap keyed
+                 by their cheapest edge into the tree, lowered with
+                 decreaseKey. O(E log V).
+  boruvka:       in each round every component picks its cheapest
+                 outgoing edge, all in parallel, and all picked edges are
+                 added at once, at least halving the number of components.
+  filterKruskal: Kruskal that partitions the edges around a pivot weight
+                 in parallel, solves the light part first, and throws away
+                 the heavy edges inside one component before going on
+                 (Osipov, Sanders and Singler), so most heavy edges are
+                 never sorted.
+All four give forests of the same total weight; the edges may differ
+when weights tie.
+*/
+
+template<typename Weight>
+struct WeightedEdge {
+    Vertex from;
+    Vertex to;
+    Weight weight;
+};
+
+// The type of a sum of weights: at least long long for integer weights, so
+// that a forest of many int edges does not overflow.
+template<typename Weight>
+using WeightSum = decltype(Weight{} + 0LL);
+
+// Return the sum of the edge weights.
+template<typename Weight>
+WeightSum<Weight> totalWeight( const std::vector<WeightedEdge<Weight>>& edges ) {
+    WeightSum<Weight> sum{ 0 };
+    for (const auto& e : edges) sum += e.weight;
+    return sum;
+}
+
+namespace spanning_tree_detail {
+    // Fewest edges or vertices worth a task; the passes here are light.
+    const int GRAIN = 8192;
+
+    /*
+    @brief Stable parallel partition of items[0, size): the items for
+           which keep is true move to the front, in order, and the others
+           after them, through a buffer of at least size items.
+    @return std::size_t, the number of kept items
+    */
+    template<typename T, typename Predicate>
+    std::size_t partition( T* items, std::size_t size, T* buffer, Predicate keep, TaskScheduler& scheduler ) {
+        int blocks = numBlocks(static_cast<std::int64_t>(size), scheduler, GRAIN);
+        auto blockBegin = [&]( int b ) { return size * b / blocks; };
+
+        std::vector<std::size_t> kept(blocks + 1, 0);
+        parallelFor(blocks, scheduler, [&]( int b ) {
+            std::size_t count = 0;
+            for (std::size_t i = blockBegin(b); i < blockBegin(b + 1); ++i) count += keep(items[i]);
+            kept[b + 1] = count;
+        });
+        for (int b = 0; b < blocks; ++b) kept[b + 1] += kept[b];
+
+        std::size_t numKept = kept[blocks];
+        parallelFor(blocks, scheduler, [&]( int b ) {
+            std::size_t yes = kept[b], no = numKept + blockBegin(b) - kept[b];
+            for (std::size_t i = blockBegin(b); i < blockBegin(b + 1); ++i) {
+                if (keep(items[i])) buffer[yes++] = items[i];
+                else                buffer[no++] = items[i];
+            }
+        });
+        parallelFor(blocks, scheduler, [&]( int b ) {
+            std::copy(buffer + blockBegin(b), buffer + blockBegin(b + 1), items + blockBegin(b));
+        });
+        return numKept;
+    }
+
+    // Return every undirected edge of g once, as (u, v) with u < v.
+    template<typename Weight>
+    std::vector<WeightedEdge<Weight>> edgeList( const Graph<Weight>& g, TaskScheduler& scheduler ) {
+        int n = g.numVertices();
+        int blocks = numBlocks(g.numEdges(), scheduler, GRAIN);
+        auto blockBegin = [&]( int b ) { return static_cast<Vertex>(static_cast<std::int64_t>(n) * b / blocks); };
+
+        std::vector<std::size_t> start(blocks + 1, 0);
+        parallelFor(blocks, scheduler, [&]( int b ) {
+            std::size_t count = 0;
+            for (Vertex v = blockBegin(b); v < blockBegin(b + 1); ++v) {
+                for (Vertex w : g.adjacent(v)) count += v < w;
+            }
+            start[b + 1] = count;
+        });
+        for (int b = 0; b < blocks; ++b) start[b + 1] += start[b];
+
+        std::vector<WeightedEdge<Weight>> edges(start[blocks]);
+        parallelFor(blocks, scheduler, [&]( int b ) {
+            std::size_t i = start[b];
+            for (Vertex v = blockBegin(b); v < blockBegin(b + 1); ++v) {
+                for (std::int64_t e = g.edgesBegin(v); e < g.edgesEnd(v); ++e) {
+                    if (v < g.target(e)) edges[i++] = WeightedEdge<Weight>{ v, g.target(e), g.weight(e) };
+                }
+            }
+        });
+        return edges;
+    }
+
+    template<typename Weight>
+    bool lighter( const WeightedEdge<Weight>& a, const WeightedEdge<Weight>& b ) {
+        return a.weight < b.weight;
+    }
+
+    // Kruskal on edges[0, size), adding to forest.
+    template<typename Weight>
+    void kruskal( WeightedEdge<Weight>* edges, std::size_t size, ConcurrentDisjointSets& sets,
+                  std::vector<WeightedEdge<Weight>>& forest, TaskScheduler& scheduler ) {
+        parallelSampleSort(edges, edges + size, scheduler, lighter<Weight>);
+        for (std::size_t i = 0; i < size && static_cast<int>(forest.size()) < sets.size() - 1; ++i) {
+            if (sets.unite(edges[i].from, edges[i].to)) forest.push_back(edges[i]);
+        }
+    }
+
+    template<typename Weight>
+    void filterKruskal( WeightedEdge<Weight>* edges, std::size_t size, WeightedEdge<Weight>* buffer,
+                        ConcurrentDisjointSets& sets, std::vector<WeightedEdge<Weight>>& forest,
+                        std::mt19937& gen, TaskScheduler& scheduler ) {
+        const std::size_t BASE = 1 << 16;
+        if (static_cast<int>(forest.size()) == sets.size() - 1) return;
+        if (size <= BASE) {
+            kruskal(edges, size, sets, forest, scheduler);
+            return;
+        }
+
+        // pivot: the median weight of a random sample
+        std::vector<Weight> sample(63);
+        for (Weight& w : sample) w = edges[gen() % size].weight;
+        std::nth_element(sample.begin(), sample.begin() + 31, sample.end());
+        Weight pivot = sample[31];
+
+        std::size_t light = partition(edges, size, buffer,
+                                      [pivot]( const WeightedEdge<Weight>& e ) { return !(pivot < e.weight); },
+                                      scheduler);
+        if (light == size) {
+            // the pivot was the largest weight; split strictly below it
+            light = partition(edges, size, buffer,
+                              [pivot]( const WeightedEdge<Weight>& e ) { return e.weight < pivot; }, scheduler);
+            if (light == 0) { // all weights are equal
+                kruskal(edges, size, sets, forest, scheduler);
+                return;
+            }
+        }
+
+        filterKruskal(edges, light, buffer, sets, forest, gen, scheduler);
+
+        // the heavy edges inside one component of the light forest are out
+        std::size_t heavy = partition(edges + light, size - light, buffer,
+                                      [&sets]( const WeightedEdge<Weight>& e ) { return !sets.connected(e.from, e.to); },
+                                      scheduler);
+        filterKruskal(edges + light, heavy, buffer, sets, forest, gen, scheduler);
+    }
+}
+
+/*
+@brief Minimum spanning forest by Kruskal's algorithm, sorting the edges
+       in parallel.
+@return std::vector<WeightedEdge<Weight>>, the edges of the forest
+*/
+template<typename Weight>
+std::vector<WeightedEdge<Weight>> kruskal( const Graph<Weight>& g, TaskScheduler& scheduler ) {
+    std::vector<WeightedEdge<Weight>> edges = spanning_tree_detail::edgeList(g, scheduler);
+    parallelSampleSort(edges.begin(), edges.end(), scheduler, spanning_tree_detail::lighter<Weight>);
+
+    std::vector<WeightedEdge<Weight>> forest;
+    DisjointSets sets{ g.numVertices() };
+    for (const auto& e : edges) {
+        if (static_cast<int>(forest.size()) == g.numVertices() - 1) break;
+        if (sets.unite(e.from, e.to)) forest.push_back(e);
+    }
+    return forest;
+}
+
+/*
+@brief Minimum spanning forest by Prim's algorithm.
+@return std::vector<WeightedEdge<Weight>>, the edges of the forest
+*/
+template<typename Weight>
+std::vector<WeightedEdge<Weight>> prim( const Graph<Weight>& g ) {
+    typedef std::pair<Weight, Vertex> Entry; // (cheapest edge into the tree, vertex)
+    typedef typename IndexedBinaryHeap<Entry>::Handle Handle;
+    const Handle NOT_QUEUED = -1;
+
+    int n = g.numVertices();
+    std::vector<Handle> handle(n, NOT_QUEUED);
+    std::vector<bool> known(n, false);
+    std::vector<Vertex> parent(n, NOT_A_VERTEX);
+    std::vector<Weight> cost(n);
+    IndexedBinaryHeap<Entry> pq{};
+    std::vector<WeightedEdge<Weight>> forest;
+
+    for (Vertex root = 0; root < n; ++root) {
+        if (known[root]) continue;
+
+        handle[root] = pq.insert(Entry{ Weight{ 0 }, root });
+        Entry e;
+        while (!pq.isEmpty()) {
+            pq.deleteMin(e);
+            Vertex v = e.second;
+            handle[v] = NOT_QUEUED;
+            known[v] = true;
+            if (parent[v] != NOT_A_VERTEX) forest.push_back(WeightedEdge<Weight>{ parent[v], v, cost[v] });
+
+            for (std::int64_t i = g.edgesBegin(v); i < g.edgesEnd(v); ++i) {
+                Vertex w = g.target(i);
+                Weight c = g.weight(i);
+                if (known[w]) continue;
+
+                if (handle[w] == NOT_QUEUED) {
+                    parent[w] = v;
+                    cost[w] = c;
+                    handle[w] = pq.insert(Entry{ c, w });
+                }
+                else if (c < cost[w]) {
+                    parent[w] = v;
+                    cost[w] = c;
+                    pq.decreaseKey(handle[w], Entry{ c, w });
+                }
+            }
+        }
+    }
+    return forest;
+}
+
+/*
+@brief Minimum spanning forest by Boruvka's algorithm, in parallel. Each
+       root of a ConcurrentDisjointSets keeps its cheapest outgoing edge,
+       lowered with compare-and-swap; ties are broken by edge number, so
+       the picked edges never close a cycle. After every round the edges
+       are relabeled with the roots of their endpoints and those inside
+       one component are dropped. O(E log V) work.
+@return std::vector<WeightedEdge<Weight>>, the edges of the forest
+*/
+template<typename Weight>
+std::vector<WeightedEdge<Weight>> boruvka( const Graph<Weight>& g, TaskScheduler& scheduler ) {
+    using namespace spanning_tree_detail;
+    const std::int64_t NONE = -1;
+
+    // an edge between the components of roots u and v; id is its place in
+    // edges, which breaks ties
+    struct Candidate {
+        Vertex u, v;
+        Weight weight;
+        std::int64_t id;
+    };
+
+    int n = g.numVertices();
+    std::vector<WeightedEdge<Weight>> edges = edgeList(g, scheduler);
+    std::vector<Candidate> candidates(edges.size()), buffer(edges.size());
+    int edgeBlocks = numBlocks(static_cast<std::int64_t>(edges.size()), scheduler, GRAIN);
+    parallelFor(edgeBlocks, scheduler, [&]( int b ) {
+        for (std::size_t i = edges.size() * b / edgeBlocks; i < edges.size() * (b + 1) / edgeBlocks; ++i) {
+            candidates[i] = Candidate{ edges[i].from, edges[i].to, edges[i].weight, static_cast<std::int64_t>(i) };
+        }
+    });
+
+    ConcurrentDisjointSets sets{ n };
+    std::unique_ptr<std::atomic<std::int64_t>[]> best{ new std::atomic<std::int64_t>[n] };
+    for (Vertex v = 0; v < n; ++v) best[v].store(NONE, std::memory_order_relaxed);
+
+    auto before = [&]( std::int64_t i, std::int64_t j ) {
+        const Candidate& a = candidates[i];
+        const Candidate& b = candidates[j];
+        return a.weight < b.weight || (!(b.weight < a.weight) && a.id < b.id);
+    };
+    auto offer = [&]( Vertex root, std::int64_t i ) {
+        std::int64_t current = best[root].load(std::memory_order_relaxed);
+        while (current == NONE || before(i, current)) {
+            if (best[root].compare_exchange_weak(current, i, std::memory_order_relaxed)) return;
+        }
+    };
+
+    int vertexBlocks = numBlocks(n, scheduler, GRAIN);
+    std::vector<std::vector<WeightedEdge<Weight>>> picked(vertexBlocks);
+    std::vector<WeightedEdge<Weight>> forest;
+    std::size_t size = candidates.size();
+
+    while (size > 0) {
+        // every component offers each of its outgoing edges to its root;
+        // the endpoints are roots already
+        int blocks = numBlocks(static_cast<std::int64_t>(size), scheduler, GRAIN);
+        parallelFor(blocks, scheduler, [&]( int b ) {
+            for (std::size_t k = size * b / blocks; k < size * (b + 1) / blocks; ++k) {
+                offer(candidates[k].u, static_cast<std::int64_t>(k));
+                offer(candidates[k].v, static_cast<std::int64_t>(k));
+            }
+        });
+
+        // add the winners; an edge picked from both ends is added once
+        parallelFor(vertexBlocks, scheduler, [&]( int b ) {
+            picked[b].clear();
+            Vertex first = static_cast<Vertex>(static_cast<std::int64_t>(n) * b / vertexBlocks);
+            Vertex last = static_cast<Vertex>(static_cast<std::int64_t>(n) * (b + 1) / vertexBlocks);
+            for (Vertex v = first; v < last; ++v) {
+                std::int64_t k = best[v].load(std::memory_order_relaxed);
+                if (k == NONE) continue;
+                best[v].store(NONE, std::memory_order_relaxed);
+                if (sets.unite(candidates[k].u, candidates[k].v)) picked[b].push_back(edges[candidates[k].id]);
+            }
+        });
+        for (const auto& p : picked) forest.insert(forest.end(), p.begin(), p.end());
+
+        // move the endpoints to the new roots and drop the edges inside a
+        // component; Boruvka's components are of similar sizes, so most
+        // edges stay until the last rounds and must be cheap to revisit
+        blocks = numBlocks(static_cast<std::int64_t>(size), scheduler, GRAIN);
+        parallelFor(blocks, scheduler, [&]( int b ) {
+            for (std::size_t k = size * b / blocks; k < size * (b + 1) / blocks; ++k) {
+                candidates[k].u = sets.find(candidates[k].u);
+                candidates[k].v = sets.find(candidates[k].v);
+            }
+        });
+        size = partition(candidates.data(), size, buffer.data(),
+                         []( const Candidate& c ) { return c.u != c.v; }, scheduler);
+    }
+    return forest;
+}
+
+/*
+@brief Minimum spanning forest by filter-Kruskal, with the partitions,
+       filters and base-case sorts in parallel.
+@return std::vector<WeightedEdge<Weight>>, the edges of the forest
+*/
+template<typename Weight>
+std::vector<WeightedEdge<Weight>> filterKruskal( const Graph<Weight>& g, TaskScheduler& scheduler ) {
+    std::vector<WeightedEdge<Weight>> edges = spanning_tree_detail::edgeList(g, scheduler);
+    std::vector<WeightedEdge<Weight>> buffer(edges.size());
+    std::vector<WeightedEdge<Weight>> forest;
+    ConcurrentDisjointSets sets{ g.numVertices() };
+    std::mt19937 gen{ 46 };
+
+    spanning_tree_detail::filterKruskal(edges.data(), edges.size(), buffer.data(), sets, forest, gen, scheduler);
+    return forest;
+}
+
+#endif
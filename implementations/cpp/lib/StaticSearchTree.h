@@ -0,0 +1,278 @@
+#ifndef STATIC_SEARCH_TREE_H
+#define STATIC_SEARCH_TREE_H
+
+#include <iostream>
+#include <vector>
+#include <cstddef>
+
+/*
+Read-only ordered sets stored as implicit complete binary trees. Both trees
+are built once from sorted items and answer lowerBound queries with a
+branchless descent: the comparison result selects the next child instead
+of a jump, so the only branch is the loop condition.
+*/
+
+#if defined(__GNUC__) || defined(__clang__)
+#define STATIC_SEARCH_TREE_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define STATIC_SEARCH_TREE_PREFETCH(addr) ((void) 0)
+#endif
+
+/*
+Eytzinger (BFS) layout: the root is at index 1 and the children of node k
+are at 2k and 2k + 1. The 2^j descendants of k at depth j are contiguous,
+so prefetching index k * STRIDE fetches the cache line the search will
+reach log(STRIDE) levels later.
+*/
+template<typename Comparable>
+class EytzingerSearchTree {
+    public:
+        /*
+        @brief Build the tree from items sorted in ascending order.
+        */
+        explicit EytzingerSearchTree( const std::vector<Comparable>& sorted );
+
+        /*
+        @brief Find the smallest item that is not less than x.
+        @return const Comparable*, nullptr if every item is less than x
+        */
+        const Comparable* lowerBound( const Comparable& x ) const;
+
+        /*
+        @brief Check if item x is in the set.
+        @return bool
+        */
+        bool contains( const Comparable& x ) const;
+
+        /*
+        @brief Return the number of items in the set.
+        @return size_t
+        */
+        size_t size() const;
+
+    private:
+        // number of items that share a cache line
+        static const size_t STRIDE = sizeof(Comparable) >= 64 ? 1 : 64 / sizeof(Comparable);
+
+        std::vector<Comparable> _tree; // 1-indexed; _tree[0] is unused
+
+        size_t _build( const std::vector<Comparable>& sorted, size_t i, size_t k );
+};
+
+/*
+van Emde Boas layout: a perfect tree of height h is split into a top tree
+of height h - h/2 and 2^(h - h/2) bottom trees of height h/2, each stored
+contiguously and laid out recursively. Positions are computed from the BFS
+index during the descent with three per-depth tables (Brodal, Fagerberg and
+Jacob), so no child pointers are stored. The item array is padded to a
+perfect tree with copies of the largest item.
+*/
+template<typename Comparable>
+class VanEmdeBoasSearchTree {
+    public:
+        /*
+        @brief Build the tree from items sorted in ascending order.
+        */
+        explicit VanEmdeBoasSearchTree( const std::vector<Comparable>& sorted );
+
+        /*
+        @brief Find the smallest item that is not less than x.
+        @return const Comparable*, nullptr if every item is less than x
+        */
+        const Comparable* lowerBound( const Comparable& x ) const;
+
+        /*
+        @brief Check if item x is in the set.
+        @return bool
+        */
+        bool contains( const Comparable& x ) const;
+
+        /*
+        @brief Return the number of items in the set.
+        @return size_t
+        */
+        size_t size() const;
+
+    private:
+        size_t _size;
+        int _height;
+        std::vector<Comparable> _tree;
+
+        // For a node at depth d that roots a bottom tree: size of the top
+        // tree above it, size of the bottom tree, and depth of the top
+        // tree's root.
+        std::vector<size_t> _topSize;
+        std::vector<size_t> _bottomSize;
+        std::vector<int> _topDepth;
+
+        void _buildTables( int depth, int height );
+        void _fill( const std::vector<Comparable>& sorted, int depth, size_t bfsIndex, size_t* positions );
+        size_t _position( int depth, size_t bfsIndex, size_t* positions ) const;
+};
+
+/******************************************************************************
+EYTZINGER LAYOUT
+******************************************************************************/
+
+template<typename Comparable>
+EytzingerSearchTree<Comparable>::EytzingerSearchTree( const std::vector<Comparable>& sorted )
+    : _tree( sorted.size() + 1 ) {
+    _build(sorted, 0, 1);
+}
+
+/*
+@brief Fill the subtree rooted at k with an in-order walk of sorted[i..].
+@return size_t, the index of the next unused sorted item
+*/
+template<typename Comparable>
+size_t EytzingerSearchTree<Comparable>::_build( const std::vector<Comparable>& sorted, size_t i, size_t k ) {
+    if (k < _tree.size()) {
+        i = _build(sorted, i, 2 * k);
+        _tree[k] = sorted[i++];
+        i = _build(sorted, i, 2 * k + 1);
+    }
+    return i;
+}
+
+/*
+After the descent, k encodes the path taken; every right turn appends a 1
+bit. The answer is the last node where the search turned left, found by
+dropping the trailing right turns plus that final left turn.
+*/
+template<typename Comparable>
+const Comparable* EytzingerSearchTree<Comparable>::lowerBound( const Comparable& x ) const {
+    const size_t n = _tree.size() - 1;
+    const Comparable* base = _tree.data();
+    size_t k = 1;
+
+    while (k <= n) {
+        STATIC_SEARCH_TREE_PREFETCH(base + k * STRIDE);
+        k = 2 * k + (base[k] < x);
+    }
+
+    while (k & 1) k >>= 1;
+    k >>= 1;
+
+    return k == 0 ? nullptr : base + k;
+}
+
+template<typename Comparable>
+bool EytzingerSearchTree<Comparable>::contains( const Comparable& x ) const {
+    const Comparable* p = lowerBound(x);
+    return p != nullptr && !(x < *p);
+}
+
+template<typename Comparable>
+size_t EytzingerSearchTree<Comparable>::size() const {
+    return _tree.size() - 1;
+}
+
+/******************************************************************************
+VAN EMDE BOAS LAYOUT
+******************************************************************************/
+
+template<typename Comparable>
+VanEmdeBoasSearchTree<Comparable>::VanEmdeBoasSearchTree( const std::vector<Comparable>& sorted )
+    : _size{ sorted.size() }, _height{ 0 } {
+    if (_size == 0) return;
+
+    while (((size_t{ 1 } << _height) - 1) < _size) ++_height;
+
+    _topSize.assign(_height, 0);
+    _bottomSize.assign(_height, 0);
+    _topDepth.assign(_height, 0);
+    _buildTables(0, _height);
+
+    const size_t perfect = (size_t{ 1 } << _height) - 1;
+    _tree.resize(perfect);
+
+    std::vector<size_t> positions(_height);
+    _fill(sorted, 0, 1, positions.data());
+}
+
+/*
+@brief Record the split of the subtree with the given height whose root is
+       at the given depth, then recurse into its top and bottom trees.
+@return void
+*/
+template<typename Comparable>
+void VanEmdeBoasSearchTree<Comparable>::_buildTables( int depth, int height ) {
+    if (height <= 1) return;
+
+    int bottomHeight = height / 2;
+    int topHeight = height - bottomHeight;
+    int bottomRoot = depth + topHeight;
+
+    _topSize[bottomRoot] = (size_t{ 1 } << topHeight) - 1;
+    _bottomSize[bottomRoot] = (size_t{ 1 } << bottomHeight) - 1;
+    _topDepth[bottomRoot] = depth;
+
+    _buildTables(depth, topHeight);
+    _buildTables(bottomRoot, bottomHeight);
+}
+
+/*
+@brief Place the node with BFS index bfsIndex and its subtree, visiting
+       parents before children so ancestor positions are always known.
+@return void
+*/
+template<typename Comparable>
+void VanEmdeBoasSearchTree<Comparable>::_fill( const std::vector<Comparable>& sorted, int depth,
+                                               size_t bfsIndex, size_t* positions ) {
+    if (depth == _height) return;
+
+    size_t rank = ((2 * (bfsIndex - (size_t{ 1 } << depth)) + 1) << (_height - 1 - depth)) - 1;
+    _tree[_position(depth, bfsIndex, positions)] = sorted[rank < _size ? rank : _size - 1];
+
+    _fill(sorted, depth + 1, 2 * bfsIndex, positions);
+    _fill(sorted, depth + 1, 2 * bfsIndex + 1, positions);
+}
+
+/*
+@brief Compute the array position of the node with BFS index bfsIndex at
+       the given depth, given the positions of its ancestors.
+@return size_t
+*/
+template<typename Comparable>
+size_t VanEmdeBoasSearchTree<Comparable>::_position( int depth, size_t bfsIndex, size_t* positions ) const {
+    if (depth == 0) {
+        positions[0] = 0;
+    }
+    else {
+        positions[depth] = positions[_topDepth[depth]] + _topSize[depth]
+                         + (bfsIndex & _topSize[depth]) * _bottomSize[depth];
+    }
+    return positions[depth];
+}
+
+template<typename Comparable>
+const Comparable* VanEmdeBoasSearchTree<Comparable>::lowerBound( const Comparable& x ) const {
+    if (_size == 0) return nullptr;
+
+    size_t positions[64];
+    const Comparable* base = _tree.data();
+    const Comparable* result = nullptr;
+    size_t i = 1;
+
+    for (int d = 0; d < _height; ++d) {
+        const Comparable* node = base + _position(d, i, positions);
+        bool goRight = *node < x;
+        result = goRight ? result : node;
+        i = 2 * i + goRight;
+    }
+
+    return result;
+}
+
+template<typename Comparable>
+bool VanEmdeBoasSearchTree<Comparable>::contains( const Comparable& x ) const {
+    const Comparable* p = lowerBound(x);
+    return p != nullptr && !(x < *p);
+}
+
+template<typename Comparable>
+size_t VanEmdeBoasSearchTree<Comparable>::size() const {
+    return _size;
+}
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <vector>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <random>
+#include <functional>
+#include <utility>
+#include <cstdint>
+
+/*
+Work-stealing task scheduler for fork-join parallelism. Each worker thread
+owns a deque of tasks: it pushes and pops the newest tasks at the back, so
+it works depth-first on its own, cache-warm subproblems, while idle workers
+steal the oldest (and usually largest) tasks from the front of a random
+victim. A thread that waits for a TaskGroup runs tasks in the meantime, so
+tasks may spawn and wait for tasks of their own without tying up a thread.
+
+Threads that are not workers, such as the one that created the scheduler,
+share deque 0. A scheduler of P threads starts P - 1 workers; the caller of
+wait is the P-th.
+*/
+class TaskScheduler {
+    public:
+        // A set of spawned tasks that can be waited for together.
+        class TaskGroup {
+            public:
+                TaskGroup() : _pending{ 0 } {}
+                TaskGroup( const TaskGroup& rhs ) = delete;
+                TaskGroup& operator=( const TaskGroup& rhs ) = delete;
+
+            private:
+                friend class TaskScheduler;
+                std::atomic<int> _pending;
+        };
+
+        explicit TaskScheduler( int numThreads = static_cast<int>(std::thread::hardware_concurrency()) );
+        ~TaskScheduler();
+
+        TaskScheduler( const TaskScheduler& rhs ) = delete;
+        TaskScheduler& operator=( const TaskScheduler& rhs ) = delete;
+
+        // Queue task to run on some thread as part of group.
+        void spawn( TaskGroup& group, std::function<void()> task );
+
+        // Run queued tasks until every task of group has finished.
+        void wait( TaskGroup& group );
+
+        // Return the number of threads, counting the waiting thread.
+        int numThreads() const;
+
+    private:
+        struct Task {
+            std::function<void()> run;
+            TaskGroup* group;
+        };
+
+        struct alignas(64) Worker {
+            std::mutex lock;
+            std::deque<Task> tasks;
+        };
+
+        int _numThreads;
+        std::unique_ptr<Worker[]> _workers;
+        std::vector<std::thread> _threads;
+
+        std::atomic<int> _queued;   // tasks in all deques
+        std::atomic<int> _sleeping; // workers blocked on _wake
+        std::atomic<bool> _stop;
+        std::mutex _sleepLock;
+        std::condition_variable _wake;
+
+        // The scheduler and deque index of the calling worker thread.
+        static std::pair<const TaskScheduler*, int>& _currentWorker();
+
+        // Return the deque index of the calling thread.
+        int _self() const;
+
+        // Pop a task from deque self or steal one, and run it.
+        // Return false if no task was found.
+        bool _runOne( int self );
+
+        void _workerLoop( int self );
+};
+
+inline TaskScheduler::TaskScheduler( int numThreads )
+    : _numThreads{ numThreads < 1 ? 1 : numThreads },
+      _workers{ new Worker[_numThreads] },
+      _queued{ 0 },
+      _sleeping{ 0 },
+      _stop{ false } {
+    for (int i = 1; i < _numThreads; ++i) {
+        _threads.emplace_back([this, i]() { _workerLoop(i); });
+    }
+}
+
+inline TaskScheduler::~TaskScheduler() {
+    _stop.store(true);
+    {
+        std::lock_guard<std::mutex> guard{ _sleepLock };
+        _wake.notify_all();
+    }
+    for (auto& t : _threads) t.join();
+}
+
+inline void TaskScheduler::spawn( TaskGroup& group, std::function<void()> task ) {
+    group._pending.fetch_add(1);
+    _queued.fetch_add(1);
+
+    Worker& w = _workers[_self()];
+    {
+        std::lock_guard<std::mutex> guard{ w.lock };
+        w.tasks.push_back(Task{ std::move(task), &group });
+    }
+
+    // a worker about to sleep has announced itself in _sleeping before it
+    // checks _queued, so either it sees this task or it is woken up here
+    if (_sleeping.load() > 0) {
+        std::lock_guard<std::mutex> guard{ _sleepLock };
+        _wake.notify_one();
+    }
+}
+
+inline void TaskScheduler::wait( TaskGroup& group ) {
+    int self = _self();
+    while (group._pending.load(std::memory_order_acquire) > 0) {
+        if (!_runOne(self)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+inline int TaskScheduler::numThreads() const {
+    return _numThreads;
+}
+
+inline std::pair<const TaskScheduler*, int>& TaskScheduler::_currentWorker() {
+    thread_local std::pair<const TaskScheduler*, int> current{ nullptr, 0 };
+    return current;
+}
+
+inline int TaskScheduler::_self() const {
+    const auto& current = _currentWorker();
+    return current.first == this ? current.second : 0;
+}
+
+inline bool TaskScheduler::_runOne( int self ) {
+    if (_queued.load(std::memory_order_relaxed) == 0) return false;
+
+    Task task;
+    bool found = false;
+    {
+        Worker& w = _workers[self];
+        std::lock_guard<std::mutex> guard{ w.lock };
+        if (!w.tasks.empty()) {
+            task = std::move(w.tasks.back());
+            w.tasks.pop_back();
+            found = true;
+        }
+    }
+
+    if (!found) {
+        thread_local std::mt19937 gen{ static_cast<unsigned>(std::hash<std::thread::id>{}(std::this_thread::get_id())) };
+        int start = static_cast<int>(gen() % _numThreads);
+        for (int k = 0; k < _numThreads && !found; ++k) {
+            int victim = (start + k) % _numThreads;
+            if (victim == self) continue;
+
+            Worker& w = _workers[victim];
+            std::lock_guard<std::mutex> guard{ w.lock };
+            if (!w.tasks.empty()) {
+                task = std::move(w.tasks.front());
+                w.tasks.pop_front();
+                found = true;
+            }
+        }
+    }
+
+    if (!found) return false;
+
+    _queued.fetch_sub(1);
+    task.run();
+    task.group->_pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+inline void TaskScheduler::_workerLoop( int self ) {
+    _currentWorker() = { this, self };
+
+    while (!_stop.load()) {
+        if (_runOne(self)) continue;
+
+        std::unique_lock<std::mutex> guard{ _sleepLock };
+        _sleeping.fetch_add(1);
+        _wake.wait(guard, [this]() { return _stop.load() || _queued.load() > 0; });
+        _sleeping.fetch_sub(1);
+    }
+}
+
+/*
+@brief Number of blocks to split work items into: blocks of at least grain
+       items, but no more than 8 per thread, enough for stealing to even
+       out the load. At least 1.
+@return int
+*/
+inline int numBlocks( std::int64_t work, const TaskScheduler& scheduler, std::int64_t grain ) {
+    std::int64_t blocks = std::min<std::int64_t>(work / grain, 8 * scheduler.numThreads());
+    return blocks < 1 ? 1 : static_cast<int>(blocks);
+}
+
+/*
+@brief Run body(i) for i in [0, n) as n tasks of scheduler, body(0) on the
+       calling thread, and wait for all of them.
+@return void
+*/
+template<typename Body>
+void parallelFor( int n, TaskScheduler& scheduler, Body body ) {
+    TaskScheduler::TaskGroup group;
+    for (int i = 1; i < n; ++i) {
+        scheduler.spawn(group, [&body, i]() { body(i); });
+    }
+    if (n > 0) body(0);
+    scheduler.wait(group);
+}
+
+#endif
@@ -0,0 +1,429 @@
+#ifndef THREADED_BINARY_SEARCH_TREE_H
+#define THREADED_BINARY_SEARCH_TREE_H
+
+#include <iostream>
+#include <algorithm>
+#include <iterator>
+
+/*
+Single-threaded (right-threaded) binary search tree. Every null right link
+is replaced by a thread to the node's in-order successor, so an in-order
+traversal needs neither a stack nor parent pointers. The rightmost node's
+thread is nullptr.
+*/
+template<typename Comparable>
+class ThreadedBinarySearchTree {
+    private:
+        struct ThreadedNode;
+
+    public:
+        /*
+        Forward iterator over the items in sorted order. Each step is O(1)
+        amortized.
+        */
+        class const_iterator {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type        = Comparable;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = const Comparable*;
+                using reference         = const Comparable&;
+
+                const_iterator() : _current{ nullptr } {}
+
+                const Comparable& operator*() const  { return _current->item; }
+                const Comparable* operator->() const { return &_current->item; }
+
+                const_iterator& operator++() {
+                    _current = ThreadedBinarySearchTree::_successor(_current);
+                    return *this;
+                }
+
+                const_iterator operator++( int ) {
+                    const_iterator old = *this;
+                    ++(*this);
+                    return old;
+                }
+
+                bool operator==( const const_iterator& rhs ) const { return _current == rhs._current; }
+                bool operator!=( const const_iterator& rhs ) const { return !(*this == rhs); }
+
+            private:
+                const ThreadedNode* _current;
+
+                explicit const_iterator( const ThreadedNode* p ) : _current{ p } {}
+
+                friend class ThreadedBinarySearchTree<Comparable>;
+        };
+
+        ThreadedBinarySearchTree();
+        ThreadedBinarySearchTree( const ThreadedBinarySearchTree& rhs );            // copy constructor
+        ThreadedBinarySearchTree( ThreadedBinarySearchTree&& rhs );                 // move constructor
+        ThreadedBinarySearchTree& operator=( const ThreadedBinarySearchTree& rhs ); // copy assign.
+        ThreadedBinarySearchTree& operator=( ThreadedBinarySearchTree&& rhs );      // move assign.
+        ~ThreadedBinarySearchTree();                                                // destructor
+
+        /*
+        @brief Return an iterator to the smallest item.
+        @return const_iterator
+        */
+        const_iterator begin() const;
+
+        /*
+        @brief Return the past-the-end iterator.
+        @return const_iterator
+        */
+        const_iterator end() const;
+
+        /*
+        @brief Find the smallest item in the tree.
+        @return Comparable
+        */
+        const Comparable& findMin() const;
+
+        /*
+        @brief Find the largest item in the tree.
+        @return Comparable
+        */
+        const Comparable& findMax() const;
+
+        /*
+        @brief Insert x into the tree; duplicates are ignored.
+        @return void
+        */
+        void insert( const Comparable& x );
+        void insert( Comparable&& x );
+
+        /*
+        @brief Remove x from the tree, keeping every thread correct.
+        @return void
+        */
+        void remove( const Comparable& x );
+
+        /*
+        @brief Return true if x is found in the tree.
+        @return bool
+        */
+        bool contains( const Comparable& x ) const;
+
+        /*
+        @brief Check if tree is empty.
+        @return bool
+        */
+        bool isEmpty() const;
+
+        /*
+        @brief Make the tree logically empty.
+        @return void
+        */
+        void makeEmpty();
+
+        /*
+        @brief Print the items in order without recursion.
+        @return void
+        */
+        void printTree( std::ostream& out = std::cout ) const;
+
+    private:
+        struct ThreadedNode {
+            Comparable    item;
+            ThreadedNode* left;
+            ThreadedNode* right;       // right child, or successor if rightThread
+            bool          rightThread;
+
+            ThreadedNode( const Comparable& item, ThreadedNode* left, ThreadedNode* right, bool rightThread )
+                : item{ item }, left{ left }, right{ right }, rightThread{ rightThread } {}
+            ThreadedNode( Comparable&& item, ThreadedNode* left, ThreadedNode* right, bool rightThread )
+                : item{ std::move(item) }, left{ left }, right{ right }, rightThread{ rightThread } {}
+        };
+
+        ThreadedNode* _root;
+
+        static ThreadedNode* _leftmost( ThreadedNode* t );
+        static const ThreadedNode* _successor( const ThreadedNode* t );
+
+        template<typename T>
+        void _insert( T&& x );
+        void _unlink( ThreadedNode* t, ThreadedNode* parent );
+        ThreadedNode* _clone( ThreadedNode* t, ThreadedNode* successor ) const;
+};
+
+/******************************************************************************
+PRIVATE METHODS
+******************************************************************************/
+template<typename Comparable>
+typename ThreadedBinarySearchTree<Comparable>::ThreadedNode*
+ThreadedBinarySearchTree<Comparable>::_leftmost( ThreadedNode* t ) {
+    if (t != nullptr) {
+        while (t->left != nullptr)
+            t = t->left;
+    }
+    return t;
+}
+
+/*
+@brief Follow a thread directly, or go right once and then all the way left.
+@return ThreadedNode*
+*/
+template<typename Comparable>
+const typename ThreadedBinarySearchTree<Comparable>::ThreadedNode*
+ThreadedBinarySearchTree<Comparable>::_successor( const ThreadedNode* t ) {
+    if (t->rightThread) return t->right;
+    return _leftmost(t->right);
+}
+
+template<typename Comparable>
+template<typename T>
+void ThreadedBinarySearchTree<Comparable>::_insert( T&& x ) {
+    if (_root == nullptr) {
+        _root = new ThreadedNode{ std::forward<T>(x), nullptr, nullptr, true };
+        return;
+    }
+
+    ThreadedNode* t = _root;
+    while (true) {
+        // visit left subtree; the new node's successor is t
+        if (x < t->item) {
+            if (t->left == nullptr) {
+                t->left = new ThreadedNode{ std::forward<T>(x), nullptr, t, true };
+                return;
+            }
+            t = t->left;
+        }
+        // visit right subtree; the new node inherits t's thread
+        else if (t->item < x) {
+            if (t->rightThread) {
+                t->right = new ThreadedNode{ std::forward<T>(x), nullptr, t->right, true };
+                t->rightThread = false;
+                return;
+            }
+            t = t->right;
+        }
+        else { return; } // Duplicate; do nothing
+    }
+}
+
+/*
+@brief Splice out node t, which has at most one real child, and delete it.
+       The only thread that can point at t belongs to its in-order
+       predecessor, i.e., the largest node of its left subtree.
+@return void
+*/
+template<typename Comparable>
+void ThreadedBinarySearchTree<Comparable>::_unlink( ThreadedNode* t, ThreadedNode* parent ) {
+    ThreadedNode* child;
+    if (t->left != nullptr) {
+        child = t->left;
+        ThreadedNode* pred = child;
+        while (!pred->rightThread)
+            pred = pred->right;
+        pred->right = t->right;
+    }
+    else if (!t->rightThread) {
+        child = t->right;
+    }
+    else {
+        child = nullptr;
+    }
+
+    if (parent == nullptr) {
+        _root = child;
+    }
+    else if (parent->left == t) {
+        parent->left = child;
+    }
+    else if (child != nullptr) {
+        parent->right = child;
+    }
+    // t was a right leaf; the parent now threads to t's successor
+    else {
+        parent->right = t->right;
+        parent->rightThread = true;
+    }
+
+    delete t;
+}
+
+template<typename Comparable>
+typename ThreadedBinarySearchTree<Comparable>::ThreadedNode*
+ThreadedBinarySearchTree<Comparable>::_clone( ThreadedNode* t, ThreadedNode* successor ) const {
+    if (t == nullptr) {
+        return nullptr;
+    }
+
+    ThreadedNode* node = new ThreadedNode{ t->item, nullptr, successor, true };
+    node->left = _clone(t->left, node);
+    if (!t->rightThread) {
+        node->right = _clone(t->right, successor);
+        node->rightThread = false;
+    }
+    return node;
+}
+
+/******************************************************************************
+CONSTRUCTORS AND BIG FIVE
+******************************************************************************/
+
+template<typename Comparable>
+ThreadedBinarySearchTree<Comparable>::ThreadedBinarySearchTree() : _root{ nullptr } {}
+
+template<typename Comparable>
+ThreadedBinarySearchTree<Comparable>::ThreadedBinarySearchTree( const ThreadedBinarySearchTree& rhs )
+    : _root{ nullptr } {
+    _root = _clone(rhs._root, nullptr);
+}
+
+template<typename Comparable>
+ThreadedBinarySearchTree<Comparable>::ThreadedBinarySearchTree( ThreadedBinarySearchTree&& rhs )
+    : _root{ rhs._root } {
+    rhs._root = nullptr;
+}
+
+// deep copy
+template<typename Comparable>
+ThreadedBinarySearchTree<Comparable>&
+ThreadedBinarySearchTree<Comparable>::operator=( const ThreadedBinarySearchTree& rhs ) {
+    if (this != &rhs) {
+        makeEmpty();
+        _root = _clone(rhs._root, nullptr);
+    }
+    return *this;
+}
+
+template<typename Comparable>
+ThreadedBinarySearchTree<Comparable>&
+ThreadedBinarySearchTree<Comparable>::operator=( ThreadedBinarySearchTree&& rhs ) {
+    std::swap(_root, rhs._root);
+    return *this;
+}
+
+template<typename Comparable>
+ThreadedBinarySearchTree<Comparable>::~ThreadedBinarySearchTree() {
+    makeEmpty();
+}
+
+/******************************************************************************
+PUBLIC METHODS
+******************************************************************************/
+
+template<typename Comparable>
+typename ThreadedBinarySearchTree<Comparable>::const_iterator
+ThreadedBinarySearchTree<Comparable>::begin() const {
+    return const_iterator{ _leftmost(_root) };
+}
+
+template<typename Comparable>
+typename ThreadedBinarySearchTree<Comparable>::const_iterator
+ThreadedBinarySearchTree<Comparable>::end() const {
+    return const_iterator{ nullptr };
+}
+
+template<typename Comparable>
+const Comparable& ThreadedBinarySearchTree<Comparable>::findMin() const {
+    return _leftmost(_root)->item;
+}
+
+template<typename Comparable>
+const Comparable& ThreadedBinarySearchTree<Comparable>::findMax() const {
+    ThreadedNode* t = _root;
+    while (!t->rightThread)
+        t = t->right;
+    return t->item;
+}
+
+template<typename Comparable>
+void ThreadedBinarySearchTree<Comparable>::insert( const Comparable& x ) {
+    _insert(x);
+}
+
+template<typename Comparable>
+void ThreadedBinarySearchTree<Comparable>::insert( Comparable&& x ) {
+    _insert(std::move(x));
+}
+
+template<typename Comparable>
+void ThreadedBinarySearchTree<Comparable>::remove( const Comparable& x ) {
+    ThreadedNode* parent = nullptr;
+    ThreadedNode* t = _root;
+
+    while (t != nullptr) {
+        if (x < t->item) {
+            parent = t;
+            t = t->left;
+        }
+        else if (t->item < x) {
+            if (t->rightThread) return; // item not found; do nothing
+            parent = t;
+            t = t->right;
+        }
+        else {
+            break;
+        }
+    }
+
+    if (t == nullptr) return; // item not found; do nothing
+
+    // node with two children: replace its item with the successor's and
+    // splice out the successor, which has no left child
+    if (t->left != nullptr && !t->rightThread) {
+        ThreadedNode* succParent = t;
+        ThreadedNode* succ = t->right;
+        while (succ->left != nullptr) {
+            succParent = succ;
+            succ = succ->left;
+        }
+        t->item = std::move(succ->item);
+        t = succ;
+        parent = succParent;
+    }
+
+    _unlink(t, parent);
+}
+
+template<typename Comparable>
+bool ThreadedBinarySearchTree<Comparable>::contains( const Comparable& x ) const {
+    ThreadedNode* t = _root;
+    while (t != nullptr) {
+        if (x < t->item) {
+            t = t->left;
+        }
+        else if (t->item < x) {
+            if (t->rightThread) return false;
+            t = t->right;
+        }
+        else {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Comparable>
+bool ThreadedBinarySearchTree<Comparable>::isEmpty() const {
+    return _root == nullptr;
+}
+
+/*
+An in-order walk only ever moves to nodes that come later in the order, so
+each node can be deleted as soon as its successor is known.
+*/
+template<typename Comparable>
+void ThreadedBinarySearchTree<Comparable>::makeEmpty() {
+    ThreadedNode* t = _leftmost(_root);
+    while (t != nullptr) {
+        ThreadedNode* next = const_cast<ThreadedNode*>(_successor(t));
+        delete t;
+        t = next;
+    }
+    _root = nullptr;
+}
+
+template<typename Comparable>
+void ThreadedBinarySearchTree<Comparable>::printTree( std::ostream& out ) const {
+    for (const Comparable& item : *this) {
+        out << item << " ";
+    }
+    out << "\n";
+}
+
+#endif